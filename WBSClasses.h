@@ -1,23 +1,23 @@
 #pragma once
 
 /*
- * WBSClasses.h - Work Breakdown Structureiƕ\jǗVXe
+ * WBSClasses.h - Work Breakdown Structure（作業分解構造）管理システム
  * 
- * ̃wb_[t@ĆAvWFNgǗɕKvWBS@\񋟂܂B
- * WBSItemiƍځjWBSProjectivWFNgjNX`A
- * ^XN̊KwǗAiǐՁAHǗȂǂ̋@\Ă܂B
+ * このヘッダーファイルは、プロジェクト管理に必要なWBS機能を提供します。
+ * WBSItem（作業項目）とWBSProject（プロジェクト）クラスを定義し、
+ * タスクの階層管理、進捗追跡、工数管理などの機能を実装しています。
  * 
- * ȋ@\:
- * - Kw\ł̃^XNǗ
- * - ^XN̐i󋵒ǐ
- * - HiςEсjǗ
- * - vWFNgŜ̓v
- * - XML`ł̃f[^iΉ
+ * 主な機能:
+ * - 階層構造でのタスク管理
+ * - タスクの進捗状況追跡
+ * - 工数（見積もり・実績）管理
+ * - プロジェクト全体の統計情報提供
+ * - XML形式でのデータ永続化対応
  * 
- * 쐬: [JҖ]
- * 쐬: [t]
- * ŏIXV: [t]
- * o[W: 1.0
+ * 作成者: [開発者名]
+ * 作成日: [日付]
+ * 最終更新: [日付]
+ * バージョン: 1.0
  */
 
 #include <vector>
@@ -27,56 +27,56 @@
 #include <commctrl.h>
 
 // =============================================================================
-// 񋓌^`
+// 列挙型定義
 // =============================================================================
 
 /**
- * @brief WBS^XN̐isԂ\񋓌^
+ * @brief WBSタスクの進行状態を表す列挙型
  * 
- * vWFNg̃^XN݂ǂ̒iKɂ邩܂B
- * ̏Ԃ͐iǗⓝv̌vZɎgp܂B
+ * プロジェクト内のタスクが現在どの段階にあるかを示します。
+ * この状態は進捗管理や統計情報の計算に使用されます。
  */
 enum class TaskStatus {
-    NOT_STARTED,    ///< Jn - ^XN܂JnĂȂ
-    IN_PROGRESS,    ///< is - ^XNݎsĂ
-    COMPLETED,      ///<  - ^XNɊ
-    ON_HOLD,        ///< ۗ - ꎞIɍƂ~Ă
-    CANCELLED       ///< LZ - ^XN~ꂽ
+    NOT_STARTED,    ///< 未開始 - タスクがまだ開始されていない状態
+    IN_PROGRESS,    ///< 進行中 - タスクが現在実行されている状態
+    COMPLETED,      ///< 完了 - タスクが正常に完了した状態
+    ON_HOLD,        ///< 保留 - 一時的に作業が停止されている状態
+    CANCELLED       ///< キャンセル - タスクが中止された状態
 };
 
 /**
- * @brief WBS^XN̏dvxEً}x\񋓌^
+ * @brief WBSタスクの重要度・緊急度を表す列挙型
  * 
- * ^XN̗D揇ʂ肷邽߂Ɏgp܂B
- * \[XzƏ̌Ɋp܂B
+ * タスクの優先順位を決定するために使用されます。
+ * リソース配分や作業順序の決定に活用されます。
  */
 enum class TaskPriority {
-    LOW,            ///< Dx - Ԃɗ]TꍇɎs
-    MEDIUM,         ///< Dx - WIȗDxx
-    HIGH,           ///< Dx - dvő߂̊Kv
-    URGENT          ///< ً} - ŗDőɑΉKv
+    LOW,            ///< 低優先度 - 時間に余裕がある場合に実行
+    MEDIUM,         ///< 中優先度 - 標準的な優先度レベル
+    HIGH,           ///< 高優先度 - 重要で早めの完了が必要
+    URGENT          ///< 緊急 - 最優先で即座に対応が必要
 };
 
 // =============================================================================
-// NX`
+// クラス定義
 // =============================================================================
 
 /**
- * @brief WBSiWork Breakdown Structureǰʍƍڂ\NX
+ * @brief WBS（Work Breakdown Structure）の個別作業項目を表すクラス
  * 
- * vWFNg\X̃^XNTu^XN\܂B
- * Kw\Aeq֌WɂăvWFNg̍ƕ\ł܂B
+ * プロジェクトを構成する個々のタスクやサブタスクを表現します。
+ * 階層構造を持ち、親子関係によってプロジェクトの作業分解を表現できます。
  * 
- * ȋ@\:
- * - ^XN̊{ǗiOAAS҂Ȃǁj
- * - i󋵂ƍH̒ǐ
- * - eq֌WɂKw\̊Ǘ
- * - v̌vZiiAHȂǁj
+ * 主な機能:
+ * - タスクの基本情報管理（名前、説明、担当者など）
+ * - 進捗状況と工数の追跡
+ * - 親子関係による階層構造の管理
+ * - 統計情報の計算（進捗率、総工数など）
  * 
- * gp:
+ * 使用例:
  * @code
- * auto task = std::make_shared<WBSItem>("VXe݌v");
- * task->SetDescription("VXe̊{݌vs");
+ * auto task = std::make_shared<WBSItem>("システム設計");
+ * task->SetDescription("システムの基本設計を行う");
  * task->SetEstimatedHours(40.0);
  * task->SetStatus(TaskStatus::IN_PROGRESS);
  * @endcode
@@ -84,479 +84,479 @@ enum class TaskPriority {
 class WBSItem {
 public:
     // =========================================================================
-    // RXgN^EfXgN^
+    // コンストラクタ・デストラクタ
     // =========================================================================
     
     /**
-     * @brief ftHgRXgN^
+     * @brief デフォルトコンストラクタ
      * 
-     * VWBSACe쐬܂B
-     * ftHglŏAォevpeBݒł܂B
+     * 新しいWBSアイテムを作成します。
+     * デフォルト値で初期化され、後から各プロパティを設定できます。
      */
     WBSItem();
     
     /**
-     * @brief OwRXgN^
+     * @brief 名前指定コンストラクタ
      * 
-     * @param name ^XN
+     * @param name タスク名
      * 
-     * w肳ꂽOWBSACe쐬܂B
-     * ̑̃vpeB̓ftHglŏ܂B
+     * 指定された名前でWBSアイテムを作成します。
+     * その他のプロパティはデフォルト値で初期化されます。
      */
     WBSItem(const std::wstring& name);
     
     /**
-     * @brief fXgN^
+     * @brief デストラクタ
      * 
-     * WBSACẽ\[XK؂ɉ܂B
+     * WBSアイテムのリソースを適切に解放します。
      */
     ~WBSItem();
 
     // =========================================================================
-    // ANZT[\bhQ
+    // アクセサーメソッド群
     // =========================================================================
     
     /**
-     * @brief ^XN擾
-     * @return ^XN̎Q
+     * @brief タスク名を取得
+     * @return タスク名の参照
      */
     const std::wstring& GetTaskName() const { return taskName; }
     
     /**
-     * @brief ^XNݒ
-     * @param name V^XN
+     * @brief タスク名を設定
+     * @param name 新しいタスク名
      */
     void SetTaskName(const std::wstring& name) { taskName = name; }
     
     /**
-     * @brief ^XN̏ڍא擾
-     * @return ̎Q
+     * @brief タスクの詳細説明を取得
+     * @return 説明文の参照
      */
     const std::wstring& GetDescription() const { return description; }
     
     /**
-     * @brief ^XN̏ڍאݒ
-     * @param desc 
+     * @brief タスクの詳細説明を設定
+     * @param desc 説明文
      */
     void SetDescription(const std::wstring& desc) { description = desc; }
     
     /**
-     * @brief SҖ擾
-     * @return SҖ̎Q
+     * @brief 担当者名を取得
+     * @return 担当者名の参照
      */
     const std::wstring& GetAssignedTo() const { return assignedTo; }
     
     /**
-     * @brief S҂ݒ
-     * @param assigned SҖ
+     * @brief 担当者を設定
+     * @param assigned 担当者名
      */
     void SetAssignedTo(const std::wstring& assigned) { assignedTo = assigned; }
     
     /**
-     * @brief ݂̃^XNԂ擾
-     * @return TaskStatusl
+     * @brief 現在のタスク状態を取得
+     * @return TaskStatus値
      */
     TaskStatus GetStatus() const { return status; }
     
     /**
-     * @brief ^XNԂݒ
-     * @param stat V
+     * @brief タスク状態を設定
+     * @param stat 新しい状態
      */
     void SetStatus(TaskStatus stat) { status = stat; }
     
     /**
-     * @brief ^XN̗Dx擾
-     * @return TaskPriorityl
+     * @brief タスクの優先度を取得
+     * @return TaskPriority値
      */
     TaskPriority GetPriority() const { return priority; }
     
     /**
-     * @brief ^XN̗Dxݒ
-     * @param prio VDx
+     * @brief タスクの優先度を設定
+     * @param prio 新しい優先度
      */
     void SetPriority(TaskPriority prio) { priority = prio; }
     
     /**
-     * @brief ςH擾iԒPʁj
-     * @return ςH
+     * @brief 見積もり工数を取得（時間単位）
+     * @return 見積もり工数
      */
     double GetEstimatedHours() const { return estimatedHours; }
     
     /**
-     * @brief ςHݒ
-     * @param hours ςHiԁj
+     * @brief 見積もり工数を設定
+     * @param hours 見積もり工数（時間）
      */
     void SetEstimatedHours(double hours) { estimatedHours = hours; }
     
     /**
-     * @brief эH擾iԒPʁj
-     * @return эH
+     * @brief 実績工数を取得（時間単位）
+     * @return 実績工数
      */
     double GetActualHours() const { return actualHours; }
     
     /**
-     * @brief эHݒ
-     * @param hours эHiԁj
+     * @brief 実績工数を設定
+     * @param hours 実績工数（時間）
      */
     void SetActualHours(double hours) { actualHours = hours; }
     
     /**
-     * @brief ^XNJn\擾
-     * @return JnSYSTEMTIME\̂̎Q
+     * @brief タスク開始予定日を取得
+     * @return 開始日のSYSTEMTIME構造体の参照
      */
     const SYSTEMTIME& GetStartDate() const { return startDate; }
     
     /**
-     * @brief ^XNJn\ݒ
-     * @param date Jn
+     * @brief タスク開始予定日を設定
+     * @param date 開始日
      */
     void SetStartDate(const SYSTEMTIME& date) { startDate = date; }
     
     /**
-     * @brief ^XNI\擾
-     * @return ISYSTEMTIME\̂̎Q
+     * @brief タスク終了予定日を取得
+     * @return 終了日のSYSTEMTIME構造体の参照
      */
     const SYSTEMTIME& GetEndDate() const { return endDate; }
     
     /**
-     * @brief ^XNI\ݒ
-     * @param date I
+     * @brief タスク終了予定日を設定
+     * @param date 終了日
      */
     void SetEndDate(const SYSTEMTIME& date) { endDate = date; }
     
     /**
-     * @brief ^XNID擾
-     * @return ^XNID̎Q
+     * @brief タスクIDを取得
+     * @return タスクID文字列の参照
      */
     const std::wstring& GetId() const { return id; }
     
     /**
-     * @brief ^XNIDݒ
-     * @param newId V^XNID
+     * @brief タスクIDを設定
+     * @param newId 新しいタスクID
      */
     void SetId(const std::wstring& newId) { id = newId; }
     
     /**
-     * @brief Kwx擾
-     * @return Kwxi0[gj
+     * @brief 階層レベルを取得
+     * @return 階層レベル（0がルート）
      */
     int GetLevel() const { return level; }
     
     /**
-     * @brief Kwxݒ
-     * @param lev VKwx
+     * @brief 階層レベルを設定
+     * @param lev 新しい階層レベル
      */
     void SetLevel(int lev) { level = lev; }
 
     // =========================================================================
-    // KwǗ\bh
+    // 階層管理メソッド
     // =========================================================================
     
     /**
-     * @brief q^XNǉ
+     * @brief 子タスクを追加
      * 
-     * @param child ǉq^XN
+     * @param child 追加する子タスク
      * 
-     * w肳ꂽ^XNq^XNƂĒǉ܂B
-     * q^XN̐eQƂƊKwx͎Iɐݒ肳܂B
+     * 指定されたタスクを子タスクとして追加します。
+     * 子タスクの親参照と階層レベルは自動的に設定されます。
      */
     void AddChild(std::shared_ptr<WBSItem> child);
     
     /**
-     * @brief q^XN폜
+     * @brief 子タスクを削除
      * 
-     * @param child 폜q^XN
+     * @param child 削除する子タスク
      * 
-     * w肳ꂽq^XNXg폜܂B
+     * 指定された子タスクをリストから削除します。
      */
     void RemoveChild(std::shared_ptr<WBSItem> child);
     
     /**
-     * @brief SĂ̎q^XN擾
-     * @return q^XÑxN^[̎Q
+     * @brief 全ての子タスクを取得
+     * @return 子タスクのベクターの参照
      */
     const std::vector<std::shared_ptr<WBSItem>>& GetChildren() const { return children; }
     
     /**
-     * @brief e^XN擾
-     * @return e^XNshared_ptri[g̏ꍇnullptrj
+     * @brief 親タスクを取得
+     * @return 親タスクのshared_ptr（ルートの場合はnullptr）
      */
     std::shared_ptr<WBSItem> GetParent() const { return parent.lock(); }
     
     /**
-     * @brief e^XNݒ
-     * @param par Ve^XN
+     * @brief 親タスクを設定
+     * @param par 新しい親タスク
      */
     void SetParent(std::shared_ptr<WBSItem> par) { parent = par; }
 
     // =========================================================================
-    // [eBeB\bh
+    // ユーティリティメソッド
     // =========================================================================
     
     /**
-     * @brief ivZ
-     * @return ii0.0?100.0j
+     * @brief 進捗率を計算
+     * @return 進捗率（0.0?100.0）
      * 
-     * эHςHŊĐivZ܂B
-     * ςH0̏ꍇ0.0Ԃ܂B
+     * 実績工数を見積もり工数で割って進捗率を計算します。
+     * 見積もり工数が0の場合は0.0を返します。
      */
     double GetProgressPercentage() const;
     
     /**
-     * @brief ̃^XNƂ̎q^XN̑ςHvZ
-     * @return ςH
+     * @brief このタスクとその子タスクの総見積もり工数を計算
+     * @return 総見積もり工数
      */
     double GetTotalEstimatedHours() const;
     
     /**
-     * @brief ̃^XNƂ̎q^XN̑эHvZ
-     * @return эH
+     * @brief このタスクとその子タスクの総実績工数を計算
+     * @return 総実績工数
      */
     double GetTotalActualHours() const;
     
     /**
-     * @brief Xe[^X𕶎`Ŏ擾
-     * @return Xe[^X̓{\L
+     * @brief ステータスを文字列形式で取得
+     * @return ステータスの日本語表記
      */
     std::wstring GetStatusString() const;
     
     /**
-     * @brief Dx𕶎`Ŏ擾
-     * @return Dx̓{\L
+     * @brief 優先度を文字列形式で取得
+     * @return 優先度の日本語表記
      */
     std::wstring GetPriorityString() const;
     
     /**
-     * @brief IID𐶐
+     * @brief 自動的にIDを生成
      * 
-     * e^XNIDƎq^XN̏ɂāA
-     * ӂID܂B
+     * 親タスクのIDと子タスクの順序を基にして、
+     * 一意のIDを自動生成します。
      */
     void GenerateId();
 
 private:
     // =========================================================================
-    // vCx[goϐ
+    // プライベートメンバ変数
     // =========================================================================
     
-    std::wstring id;                                        ///< ^XN̈ӎʎq
-    std::wstring taskName;                                  ///< ^XN
-    std::wstring description;                               ///< ^XN̏ڍא
-    std::wstring assignedTo;                                ///< SҖ
-    TaskStatus status;                                      ///< ݂̐is
-    TaskPriority priority;                                  ///< Dxx
-    double estimatedHours;                                  ///< ςHiԁj
-    double actualHours;                                     ///< эHiԁj
-    SYSTEMTIME startDate;                                   ///< Jn\
-    SYSTEMTIME endDate;                                     ///< I\
-    int level;                                              ///< Kwxi0=[gj
-    
-    std::vector<std::shared_ptr<WBSItem>> children;         ///< q^XÑXg
-    std::weak_ptr<WBSItem> parent;                          ///< e^XNւ̎Q
+    std::wstring id;                                        ///< タスクの一意識別子
+    std::wstring taskName;                                  ///< タスク名
+    std::wstring description;                               ///< タスクの詳細説明
+    std::wstring assignedTo;                                ///< 担当者名
+    TaskStatus status;                                      ///< 現在の進行状態
+    TaskPriority priority;                                  ///< 優先度レベル
+    double estimatedHours;                                  ///< 見積もり工数（時間）
+    double actualHours;                                     ///< 実績工数（時間）
+    SYSTEMTIME startDate;                                   ///< 開始予定日
+    SYSTEMTIME endDate;                                     ///< 終了予定日
+    int level;                                              ///< 階層レベル（0=ルート）
+    
+    std::vector<std::shared_ptr<WBSItem>> children;         ///< 子タスクのリスト
+    std::weak_ptr<WBSItem> parent;                          ///< 親タスクへの弱参照
 };
 
 /**
- * @brief WBSvWFNgŜǗNX
+ * @brief WBSプロジェクト全体を管理するクラス
  * 
- * vWFNgŜ̏ǗA[g^XNʂ
- * SẴ^XNɃANZXł܂BvWFNgxł
- * v̌vZAt@Cւ̕ۑEǂݍ݋@\񋟂܂B
+ * プロジェクト全体の情報を管理し、ルートタスクを通じて
+ * 全てのタスクにアクセスできます。プロジェクトレベルでの
+ * 統計情報の計算や、ファイルへの保存・読み込み機能を提供します。
  * 
- * ȋ@\:
- * - vWFNg{̊Ǘ
- * - [g^XNʂS^XNւ̃ANZX
- * - vWFNgŜ̓v
- * - XMLt@Cł̕ۑEǂݍ
+ * 主な機能:
+ * - プロジェクト基本情報の管理
+ * - ルートタスクを通じた全タスクへのアクセス
+ * - プロジェクト全体の統計情報提供
+ * - XMLファイルでの保存・読み込み
  * 
- * gp:
+ * 使用例:
  * @code
- * auto project = std::make_unique<WBSProject>("VVXeJ");
- * project->SetDescription("ڋqǗVXe̊JvWFNg");
+ * auto project = std::make_unique<WBSProject>("新システム開発");
+ * project->SetDescription("顧客管理システムの開発プロジェクト");
  * project->SaveToFile(L"project.xml");
  * @endcode
  */
 class WBSProject {
 public:
     // =========================================================================
-    // RXgN^EfXgN^
+    // コンストラクタ・デストラクタ
     // =========================================================================
     
     /**
-     * @brief ftHgRXgN^
+     * @brief デフォルトコンストラクタ
      * 
-     * VWBSvWFNg쐬܂B
-     * ftHg̃vWFNgŃ[g^XN쐬܂B
+     * 新しいWBSプロジェクトを作成します。
+     * デフォルトのプロジェクト名でルートタスクが自動作成されます。
      */
     WBSProject();
     
     /**
-     * @brief OwRXgN^
+     * @brief 名前指定コンストラクタ
      * 
-     * @param name vWFNg
+     * @param name プロジェクト名
      * 
-     * w肳ꂽOWBSvWFNg쐬܂B
-     * vWFNgƓOŃ[g^XN쐬܂B
+     * 指定された名前でWBSプロジェクトを作成します。
+     * プロジェクト名と同じ名前でルートタスクが作成されます。
      */
     WBSProject(const std::wstring& name);
     
     /**
-     * @brief fXgN^
+     * @brief デストラクタ
      * 
-     * vWFNg̃\[XK؂ɉ܂B
+     * プロジェクトのリソースを適切に解放します。
      */
     ~WBSProject();
 
     // =========================================================================
-    // ANZT[\bhQ
+    // アクセサーメソッド群
     // =========================================================================
     
     /**
-     * @brief vWFNg擾
-     * @return vWFNg̎Q
+     * @brief プロジェクト名を取得
+     * @return プロジェクト名の参照
      */
     const std::wstring& GetProjectName() const { return projectName; }
     
     /**
-     * @brief vWFNgݒ
-     * @param name VvWFNg
+     * @brief プロジェクト名を設定
+     * @param name 新しいプロジェクト名
      */
     void SetProjectName(const std::wstring& name) { projectName = name; }
     
     /**
-     * @brief vWFNg̐擾
-     * @return ̎Q
+     * @brief プロジェクトの説明を取得
+     * @return 説明文の参照
      */
     const std::wstring& GetDescription() const { return description; }
     
     /**
-     * @brief vWFNg̐ݒ
-     * @param desc 
+     * @brief プロジェクトの説明を設定
+     * @param desc 説明文
      */
     void SetDescription(const std::wstring& desc) { description = desc; }
     
     /**
-     * @brief [g^XN擾
-     * @return [g^XNshared_ptr
+     * @brief ルートタスクを取得
+     * @return ルートタスクのshared_ptr
      */
     std::shared_ptr<WBSItem> GetRootTask() const { return rootTask; }
 
     // =========================================================================
-    // vWFNgǗ\bh
+    // プロジェクト管理メソッド
     // =========================================================================
     
     /**
-     * @brief [gxɃ^XNǉ
+     * @brief ルートレベルにタスクを追加
      * 
-     * @param task ǉ^XN
+     * @param task 追加するタスク
      * 
-     * vWFNg̃[gxɐV^XNǉ܂B
-     * ʏ̓vWFNg̎vȃtF[YJeSɎgp܂B
+     * プロジェクトのルートレベルに新しいタスクを追加します。
+     * 通常はプロジェクトの主要なフェーズやカテゴリに使用します。
      */
     void AddRootTask(std::shared_ptr<WBSItem> task);
     
     /**
-     * @brief vWFNgt@Cɕۑ
+     * @brief プロジェクトをファイルに保存
      * 
-     * @param filename ۑt@C
-     * @return ۑɐꍇtrue
+     * @param filename 保存先ファイル名
+     * @return 保存に成功した場合true
      * 
-     * vWFNg̑Sf[^XML`Ńt@Cɕۑ܂B
+     * プロジェクトの全データをXML形式でファイルに保存します。
      */
     bool SaveToFile(const std::wstring& filename);
     
     /**
-     * @brief t@CvWFNgǂݍ
+     * @brief ファイルからプロジェクトを読み込み
      * 
-     * @param filename ǂݍ݌t@C
-     * @return ǂݍ݂ɐꍇtrue
+     * @param filename 読み込み元ファイル名
+     * @return 読み込みに成功した場合true
      * 
-     * XML`ŕۑꂽvWFNgt@Cǂݍ݂܂B
+     * XML形式で保存されたプロジェクトファイルを読み込みます。
      */
     bool LoadFromFile(const std::wstring& filename);
     
     // =========================================================================
-    // v񃁃\bh
+    // 統計情報メソッド
     // =========================================================================
     
     /**
-     * @brief vWFNgŜ̑ςHvZ
-     * @return ςHiԁj
+     * @brief プロジェクト全体の総見積もり工数を計算
+     * @return 総見積もり工数（時間）
      * 
-     * vWFNg̑S^XŇςHv܂B
+     * プロジェクト内の全タスクの見積もり工数を合計します。
      */
     double GetTotalEstimatedHours() const;
     
     /**
-     * @brief vWFNgŜ̑эHvZ
-     * @return эHiԁj
+     * @brief プロジェクト全体の総実績工数を計算
+     * @return 総実績工数（時間）
      * 
-     * vWFNg̑S^XN̎эHv܂B
+     * プロジェクト内の全タスクの実績工数を合計します。
      */
     double GetTotalActualHours() const;
     
     /**
-     * @brief vWFNgŜ̐ivZ
-     * @return S̐ii0.0?100.0j
+     * @brief プロジェクト全体の進捗率を計算
+     * @return 全体進捗率（0.0?100.0）
      * 
-     * S^XN̎эHƌςH
-     * vWFNgŜ̐ivZ܂B
+     * 全タスクの実績工数と見積もり工数から
+     * プロジェクト全体の進捗率を計算します。
      */
     double GetOverallProgress() const;
 
 private:
     // =========================================================================
-    // vCx[goϐ
+    // プライベートメンバ変数
     // =========================================================================
     
-    std::wstring projectName;                               ///< vWFNg
-    std::wstring description;                               ///< vWFNg̐
-    std::shared_ptr<WBSItem> rootTask;                      ///< [g^XN
-    std::wstring filename;                                  ///< ۑt@C
+    std::wstring projectName;                               ///< プロジェクト名
+    std::wstring description;                               ///< プロジェクトの説明
+    std::shared_ptr<WBSItem> rootTask;                      ///< ルートタスク
+    std::wstring filename;                                  ///< 保存ファイル名
 };
 
 // =============================================================================
-// [eBeB֐Q
+// ユーティリティ関数群
 // =============================================================================
 
 /**
- * @brief TaskStatus{ꕶɕϊ
- * @param status ϊXe[^X
- * @return {̃Xe[^X
+ * @brief TaskStatusを日本語文字列に変換
+ * @param status 変換するステータス
+ * @return 日本語のステータス文字列
  */
 std::wstring TaskStatusToString(TaskStatus status);
 
 /**
- * @brief TaskStatusɕϊ
- * @param str ϊ镶
- * @return ΉTaskStatusl
+ * @brief 文字列をTaskStatusに変換
+ * @param str 変換する文字列
+ * @return 対応するTaskStatus値
  */
 TaskStatus StringToTaskStatus(const std::wstring& str);
 
 /**
- * @brief TaskPriority{ꕶɕϊ
- * @param priority ϊDx
- * @return {̗Dx
+ * @brief TaskPriorityを日本語文字列に変換
+ * @param priority 変換する優先度
+ * @return 日本語の優先度文字列
  */
 std::wstring TaskPriorityToString(TaskPriority priority);
 
 /**
- * @brief TaskPriorityɕϊ
- * @param str ϊ镶
- * @return ΉTaskPriorityl
+ * @brief 文字列をTaskPriorityに変換
+ * @param str 変換する文字列
+ * @return 対応するTaskPriority値
  */
 TaskPriority StringToTaskPriority(const std::wstring& str);
 
 /**
- * @brief SYSTEMTIME𕶎`ɕϊ
- * @param st ϊSYSTEMTIME
- * @param str ʂi[镶
+ * @brief SYSTEMTIMEを文字列形式に変換
+ * @param st 変換するSYSTEMTIME
+ * @param str 結果を格納する文字列
  */
 void SystemTimeToString(const SYSTEMTIME& st, std::wstring& str);
 
 /**
- * @brief SYSTEMTIMEɕϊ
- * @param str ϊ镶
- * @param st ʂi[SYSTEMTIME
- * @return ϊɐꍇtrue
+ * @brief 文字列をSYSTEMTIMEに変換
+ * @param str 変換する文字列
+ * @param st 結果を格納するSYSTEMTIME
+ * @return 変換に成功した場合true
  */
 bool StringToSystemTime(const std::wstring& str, SYSTEMTIME& st);
\ No newline at end of file
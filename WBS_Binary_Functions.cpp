@@ -0,0 +1,475 @@
+/*
+ * ============================================================================
+ * WBS_Binary_Functions.cpp - バイナリ形式（.wbsb）処理モジュール
+ * ============================================================================
+ *
+ * このモジュールは、WBSプロジェクトデータをコンパクトなバイナリ形式で
+ * 保存・読み込みする機能と、XML形式との相互変換機能を提供します。
+ * ファイルレイアウトは WBSBinaryFormat.h で定義されています。
+ *
+ * 【主な機能】
+ * - WBSプロジェクト → .wbsb シリアライゼーション
+ * - .wbsb → WBSプロジェクト デシリアライゼーション（境界検査付き一括読み込み）
+ * - .xml ⇔ .wbsb の相互変換
+ *
+ * 【XML形式との違い】
+ * - 文字列は重複排除された文字列表に一度だけ格納（UTF-8）
+ * - タスクは行きがけ順の固定長レコード（親索引・部分木範囲付き）
+ * - 数値は IEEE 754 倍精度のまま格納（文字列変換なし）
+ * - 日時は年月日時分秒を64ビット値にパック
+ *
+ * 【設計原則】
+ * - 読み込み: メモリマップ後、レコード配列を先頭から1回走査するだけ
+ * - 安全性: 全ての索引・オフセットをファイルサイズと照合し、不正なら読み込まない
+ * - 互換性: XMLと全く同じ情報を保持（相互変換で情報が失われない）
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#include <windows.h>   // Windows基本API
+#include <memory>      // スマートポインタ（メモリ安全性）
+#include <vector>      // 動的配列（レコード・文字列表）
+#include <string>      // 文字列クラス（テキスト処理）
+#include <unordered_map> // ハッシュマップ（文字列の重複排除）
+
+#include "WBS_cpp_win32/WBSClasses.h"       // WBSクラス定義
+#include "WBS_cpp_win32/WBSBinaryFormat.h"  // バイナリファイルレイアウト
+#include "WBS_cpp_win32/WBSOutputSink.h"    // バイト列出力先
+#include "WBS_cpp_win32/WBSMappedFile.h"    // 読み取り専用メモリマップファイル
+#include "WBS_cpp_win32/WBSUtf8.h"          // UTF-8変換
+
+// ============================================================================
+// 外部依存関係 - XML処理モジュールとの連携
+// ============================================================================
+
+bool ReadProjectXmlFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project, int lazyDepth);
+bool SaveProjectToFile(const WBSProject& project, const std::wstring& filePath);
+
+// ============================================================================
+// バイナリシリアライゼーション関数群
+// ============================================================================
+
+/**
+ * @brief 重複排除付きの文字列表ビルダー
+ *
+ * 同じ文字列は一度だけUTF-8で格納し、2回目以降は既存の索引を返します。
+ * 検索キーは追加元の文字列へのポインタで保持するため（コピーしない）、
+ * 追加した文字列はビルダーの使用中に変更・破棄しないでください。
+ */
+class BinaryStringTableBuilder {
+    struct KeyHash {
+        size_t operator()(const std::string* text) const { return std::hash<std::string>()(*text); }
+    };
+    struct KeyEqual {
+        bool operator()(const std::string* a, const std::string* b) const { return *a == *b; }
+    };
+
+public:
+    /**
+     * @brief コンストラクタ
+     * @param expectedCount 追加予定の文字列数（ハッシュ表の再構築を避けるための目安）
+     */
+    explicit BinaryStringTableBuilder(size_t expectedCount) : overflow_(false) {
+        indices_.reserve(expectedCount);
+        offsets_.reserve(expectedCount + 1);
+        offsets_.push_back(0);
+    }
+
+    /**
+     * @brief 文字列を追加して索引を取得
+     * @param text 追加する文字列
+     * @return 文字列表の索引
+     */
+    uint32_t Add(const std::string& text) {
+        auto found = indices_.find(&text);
+        if (found != indices_.end()) {
+            return found->second;
+        }
+
+        uint32_t index = static_cast<uint32_t>(offsets_.size() - 1);
+        data_.append(text); // 内部文字列はUTF-8のためそのまま格納
+        if (data_.size() > 0xFFFFFFFFu) {
+            overflow_ = true; // 文字列データは4GBまで
+        }
+        offsets_.push_back(static_cast<uint32_t>(data_.size()));
+        indices_.emplace(&text, index);
+        return index;
+    }
+
+    /**
+     * @brief タスクIDを文字列に変換して追加（重複排除なし）
+     * @return 文字列表の索引
+     *
+     * IDはタスクごとに異なるため索引には登録せず、文字列データへ直接書き出します。
+     */
+    uint32_t AddId(const WBSTaskId& id) {
+        uint32_t index = Count();
+        id.AppendTo(data_);
+        if (data_.size() > 0xFFFFFFFFu) {
+            overflow_ = true;
+        }
+        offsets_.push_back(static_cast<uint32_t>(data_.size()));
+        return index;
+    }
+
+    const std::vector<uint32_t>& Offsets() const { return offsets_; }
+    const std::string& Data() const { return data_; }
+    uint32_t Count() const { return static_cast<uint32_t>(offsets_.size() - 1); }
+    bool Overflow() const { return overflow_; }
+
+private:
+    std::unordered_map<const std::string*, uint32_t, KeyHash, KeyEqual> indices_;   ///< 文字列 → 索引
+    std::vector<uint32_t> offsets_;                         ///< 文字列データ内の開始位置（+終端）
+    std::string data_;                                      ///< UTF-8文字列データ
+    bool overflow_;                                         ///< 4GB超過フラグ
+};
+
+/**
+ * @brief 部分木に含まれるタスク数を数える（自身を含む）
+ * @param item 対象のWBSアイテム
+ * @return タスク数
+ */
+size_t CountTaskRecords(const WBSItem& item) {
+    size_t count = 1;
+    for (const auto& child : item.children) {
+        if (child) {
+            count += CountTaskRecords(*child);
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief WBSアイテムの部分木をレコード配列へ追加（行きがけ順、再帰的）
+ *
+ * @param item 追加するWBSアイテム
+ * @param parentIndex 親レコードの索引（ルートは kWBSBinaryNoParent）
+ * @param records 追加先のレコード配列
+ * @param strings 文字列表ビルダー
+ */
+void AppendTaskRecords(const WBSItem& item, uint32_t parentIndex,
+                       std::vector<WBSBinaryTaskRecord>& records, BinaryStringTableBuilder& strings) {
+    uint32_t index = static_cast<uint32_t>(records.size());
+
+    WBSBinaryTaskRecord record = {};
+    record.parentIndex = parentIndex;
+    record.childCount = static_cast<uint32_t>(item.children.size());
+    record.idString = strings.AddId(item.id);
+    record.nameString = strings.Add(item.taskName);
+    record.descriptionString = strings.Add(item.description.str());
+    record.assignedToString = strings.Add(item.assignedTo.str());
+    record.status = static_cast<uint8_t>(item.status);
+    record.priority = static_cast<uint8_t>(item.priority);
+    record.level = static_cast<uint16_t>(item.level);
+    record.estimatedHours = item.estimatedHours;
+    record.actualHours = item.actualHours;
+    record.startDate = PackDateTime(item.startDate);
+    record.endDate = PackDateTime(item.endDate);
+    records.push_back(record);
+
+    for (const auto& child : item.children) {
+        if (child) {
+            AppendTaskRecords(*child, index, records, strings);
+        }
+    }
+
+    // 子孫を追加し終えた位置が部分木の終端
+    records[index].subtreeEnd = static_cast<uint32_t>(records.size());
+}
+
+/**
+ * @brief 形式定数とプロジェクト名・説明の文字列索引を設定したヘッダーを作成
+ *
+ * @param projectName プロジェクト名
+ * @param description プロジェクト説明
+ * @param strings 文字列表ビルダー（名前・説明を追加する）
+ * @return セクション配置が未設定のヘッダー
+ */
+WBSBinaryHeader MakeBinaryHeader(const std::string& projectName, const std::string& description,
+                                 BinaryStringTableBuilder& strings) {
+    WBSBinaryHeader header = {};
+    memcpy(header.magic, kWBSBinaryMagic, sizeof(header.magic));
+    header.version = kWBSBinaryVersion;
+    header.headerSize = sizeof(WBSBinaryHeader);
+    header.recordSize = sizeof(WBSBinaryTaskRecord);
+    header.projectNameString = strings.Add(projectName);
+    header.descriptionString = strings.Add(description);
+    return header;
+}
+
+bool WriteBinarySections(WBSBinaryHeader& header, const std::vector<WBSBinaryTaskRecord>& records,
+                         const BinaryStringTableBuilder& strings, WBSOutputSink& sink);
+
+/**
+ * @brief プロジェクトをバイナリ形式で出力先へ書き込み
+ *
+ * @param project 書き込み対象のプロジェクト
+ * @param sink 出力先（ファイル、メモリ等）
+ * @return 書き込みに成功した場合true
+ *
+ * @details 処理フロー:
+ * 1. タスク数を数えて各配列を予約
+ * 2. タスクを行きがけ順にレコード化し、文字列表を構築
+ * 3. 各セクションのオフセットを計算してヘッダーを作成
+ * 4. ヘッダー、レコード配列、オフセット表、文字列データの順に書き込み
+ */
+bool WriteProjectBinary(const WBSProject& project, WBSOutputSink& sink) {
+    if (!project.rootTask) {
+        return false;
+    }
+
+    // タスクあたり4つの文字列フィールド + プロジェクト名・説明
+    size_t taskCount = CountTaskRecords(*project.rootTask);
+    BinaryStringTableBuilder strings(taskCount * 4 + 2);
+    std::vector<WBSBinaryTaskRecord> records;
+    records.reserve(taskCount);
+
+    WBSBinaryHeader header = MakeBinaryHeader(project.projectName, project.description, strings);
+
+    AppendTaskRecords(*project.rootTask, kWBSBinaryNoParent, records, strings);
+    return WriteBinarySections(header, records, strings, sink);
+}
+
+/**
+ * @brief ヘッダーのセクション配置を計算し、全セクションを出力先へ書き込み
+ *
+ * @param header 文字列索引を設定済みのヘッダー（配置とタスク数はここで設定）
+ * @param records 行きがけ順のタスクレコード配列
+ * @param strings 文字列表ビルダー
+ * @param sink 出力先
+ * @return 書き込みに成功した場合true
+ */
+bool WriteBinarySections(WBSBinaryHeader& header, const std::vector<WBSBinaryTaskRecord>& records,
+                         const BinaryStringTableBuilder& strings, WBSOutputSink& sink) {
+    if (strings.Overflow() || records.size() >= kWBSBinaryNoParent) {
+        return false;
+    }
+
+    // セクション配置の計算
+    header.taskCount = static_cast<uint32_t>(records.size());
+    header.stringCount = strings.Count();
+    header.taskOffset = sizeof(WBSBinaryHeader);
+    header.stringTableOffset = header.taskOffset + records.size() * sizeof(WBSBinaryTaskRecord);
+    header.stringDataOffset = header.stringTableOffset + strings.Offsets().size() * sizeof(uint32_t);
+    header.stringDataSize = strings.Data().size();
+
+    return sink.Write(reinterpret_cast<const char*>(&header), sizeof(header)) &&
+           sink.Write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(WBSBinaryTaskRecord)) &&
+           sink.Write(reinterpret_cast<const char*>(strings.Offsets().data()), strings.Offsets().size() * sizeof(uint32_t)) &&
+           sink.Write(strings.Data().data(), strings.Data().size());
+}
+
+/**
+ * @brief プロジェクトをバイナリファイル（.wbsb）へ保存
+ *
+ * @param project 保存対象のプロジェクト
+ * @param filePath 保存先のファイルパス
+ * @return 保存に成功した場合true
+ */
+bool SaveProjectBinaryFile(const WBSProject& project, const std::wstring& filePath) {
+    WBSFileSink file(filePath);
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    bool written = WriteProjectBinary(project, file);
+    return file.Close() && written;
+}
+
+// ============================================================================
+// バイナリデシリアライゼーション関数群
+// ============================================================================
+
+/**
+ * @brief タスクレコード1件の索引・列挙値を検証
+ *
+ * @param record 検証するレコード
+ * @param index レコードの索引
+ * @param header 検証済みヘッダー
+ * @return 親索引・部分木範囲・文字列索引・列挙値がすべて範囲内の場合true
+ */
+bool IsValidBinaryRecord(const WBSBinaryTaskRecord& record, uint32_t index, const WBSBinaryHeader& header) {
+    bool validParent = (index == 0) ? (record.parentIndex == kWBSBinaryNoParent) : (record.parentIndex < index);
+    return validParent &&
+           record.subtreeEnd > index && record.subtreeEnd <= header.taskCount &&
+           record.childCount <= header.taskCount - index - 1 &&
+           record.idString < header.stringCount && record.nameString < header.stringCount &&
+           record.descriptionString < header.stringCount && record.assignedToString < header.stringCount &&
+           record.status <= static_cast<uint8_t>(TaskStatus::CANCELLED) &&
+           record.priority <= static_cast<uint8_t>(TaskPriority::URGENT);
+}
+
+/**
+ * @brief 文字列表の要素をインターンした結果のキャッシュ
+ *
+ * 担当者名は少数の文字列索引が多数のレコードから参照されるため、
+ * 索引ごとに一度だけ WBSStringPool へ登録します（プールの排他を毎回取らない）。
+ */
+class BinaryInternCache {
+public:
+    BinaryInternCache(const std::vector<std::string>& strings, WBSStringPool& pool) : strings_(strings), pool_(pool) {}
+
+    /**
+     * @brief 文字列索引に対応するインターン済み文字列を取得
+     * @param index 検証済みの文字列索引
+     */
+    WBSInternedString Get(uint32_t index) {
+        auto found = interned_.find(index);
+        if (found != interned_.end()) {
+            return found->second;
+        }
+        WBSInternedString text(pool_);
+        text = strings_[index];
+        interned_.emplace(index, text);
+        return text;
+    }
+
+private:
+    const std::vector<std::string>& strings_;                       ///< 変換済みの文字列表
+    WBSStringPool& pool_;                                           ///< 登録先のプール
+    std::unordered_map<uint32_t, WBSInternedString> interned_;      ///< 文字列索引からインターン済み文字列へ
+};
+
+/**
+ * @brief バイナリ形式のバイト列からプロジェクトを構築
+ *
+ * @param data ファイル内容の先頭
+ * @param size ファイルサイズ
+ * @return 構築されたプロジェクト、形式エラーの場合はnullptr
+ *
+ * @details 処理フロー:
+ * 1. ValidateBinaryHeader() によるヘッダーとセクション範囲の検証
+ * 2. 文字列表の全要素を一度だけ内部文字列（検証済みUTF-8）へコピー
+ * 3. レコード配列を先頭から走査し、親索引で親子関係を接続
+ *
+ * @note 検証項目:
+ * - 親索引は自身より前のレコードを指すこと（ルートのみ親なし）
+ * - 部分木の終端は自身より後ろでタスク数以下であること
+ * - 文字列索引・オフセットが文字列表の範囲内であること
+ * - 状態・優先度が列挙型の範囲内であること
+ */
+std::unique_ptr<WBSProject> ParseProjectFromBinary(const char* data, size_t size) {
+    WBSBinaryHeader header;
+    if (!ValidateBinaryHeader(data, size, header)) {
+        return nullptr;
+    }
+
+    // 文字列表のコピー（重複排除済みのため各文字列は一度だけ検証される）
+    std::vector<std::string> strings(header.stringCount);
+    for (uint32_t i = 0; i < header.stringCount; ++i) {
+        const char* first;
+        size_t length;
+        if (!GetBinaryString(data, header, i, first, length)) {
+            return nullptr;
+        }
+        AppendSanitizedUtf8(strings[i], first, first + length);
+    }
+
+    // タスクレコードの走査（ValidateBinaryHeader() でアライン済みを確認）
+    const WBSBinaryTaskRecord* records = reinterpret_cast<const WBSBinaryTaskRecord*>(data + header.taskOffset);
+    std::vector<std::shared_ptr<WBSItem>> items(header.taskCount);
+    auto arena = std::make_shared<WBSArena>();
+    BinaryInternCache assignees(strings, arena->Strings());
+
+    for (uint32_t i = 0; i < header.taskCount; ++i) {
+        const WBSBinaryTaskRecord& record = records[i];
+
+        if (!IsValidBinaryRecord(record, i, header)) {
+            return nullptr;
+        }
+
+        auto item = WBSItem::Create(arena);
+        item->id.Assign(strings[record.idString]);
+        item->taskName = strings[record.nameString];
+        item->description = strings[record.descriptionString];
+        item->assignedTo = assignees.Get(record.assignedToString);
+        item->status = static_cast<TaskStatus>(record.status);
+        item->priority = static_cast<TaskPriority>(record.priority);
+        item->level = record.level;
+        item->estimatedHours = record.estimatedHours;
+        item->actualHours = record.actualHours;
+        item->startDate = UnpackDateTime(record.startDate);
+        item->endDate = UnpackDateTime(record.endDate);
+        item->children.reserve(record.childCount);
+
+        if (i > 0) {
+            // 親子関係の接続（親は必ず先に構築済み）
+            const auto& parent = items[record.parentIndex];
+            item->parent = parent;
+            parent->children.push_back(item);
+        }
+        items[i] = std::move(item);
+    }
+
+    // プロジェクト名のバリデーション（XML読み込みと同じ規則）
+    std::string projectName = strings[header.projectNameString];
+    if (projectName.empty()) {
+        projectName = u8"読み込まれたプロジェクト";
+    }
+
+    auto project = std::make_unique<WBSProject>(projectName, arena);
+    project->description = strings[header.descriptionString];
+    items[0]->taskName = projectName;
+    project->rootTask = items[0];
+    return project;
+}
+
+/**
+ * @brief バイナリファイル（.wbsb）からプロジェクトを読み込み
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @return ファイルを開けた場合true
+ *
+ * ファイルをメモリマップし、ParseProjectFromBinary() で一括して構築します。
+ */
+bool ReadProjectBinaryFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project) {
+    WBSMappedFile file(filePath);
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    project = ParseProjectFromBinary(file.Data(), file.Size());
+    return true;
+}
+
+// ============================================================================
+// 形式変換関数群
+// ============================================================================
+
+/**
+ * @brief XMLファイルをバイナリファイルへ変換
+ *
+ * @param xmlPath 変換元のXMLファイルパス
+ * @param binaryPath 変換先の .wbsb ファイルパス
+ * @return 変換に成功した場合true
+ *
+ * 現在のプロジェクト（g_currentProject）には影響しません。
+ */
+bool ConvertXmlToBinary(const std::wstring& xmlPath, const std::wstring& binaryPath) {
+    std::unique_ptr<WBSProject> project;
+    if (!ReadProjectXmlFile(xmlPath, project, 0) || !project) {  // 変換には全タスクが必要
+        return false;
+    }
+    return SaveProjectBinaryFile(*project, binaryPath);
+}
+
+/**
+ * @brief バイナリファイルをXMLファイルへ変換
+ *
+ * @param binaryPath 変換元の .wbsb ファイルパス
+ * @param xmlPath 変換先のXMLファイルパス
+ * @return 変換に成功した場合true
+ *
+ * 現在のプロジェクト（g_currentProject）には影響しません。
+ */
+bool ConvertBinaryToXml(const std::wstring& binaryPath, const std::wstring& xmlPath) {
+    std::unique_ptr<WBSProject> project;
+    if (!ReadProjectBinaryFile(binaryPath, project) || !project) {
+        return false;
+    }
+    return SaveProjectToFile(*project, xmlPath);
+}
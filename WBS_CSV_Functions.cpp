@@ -0,0 +1,570 @@
+/*
+ * ============================================================================
+ * WBS_CSV_Functions.cpp - タスク表（CSV/TSV）入出力モジュール
+ * ============================================================================
+ *
+ * このモジュールは、プロジェクトの全タスクを1タスク1行の表として
+ * CSV（.csv、カンマ区切り）・TSV（.tsv、タブ区切り）で書き出し、
+ * その表から階層構造を復元して読み込む機能を提供します。
+ * 表計算ソフトや他システムとのタスクの一括受け渡しに使用します。
+ *
+ * 【列】（1行目は列名の見出し行）
+ *   ID, ParentID, Level, Name, Description, AssignedTo, Status, Priority,
+ *   EstimatedHours, ActualHours, StartDate, EndDate
+ * - ParentID はルートタスクの行のみ空
+ * - Status・Priority は列挙型の数値、日時は ISO 8601（XML形式と同じ）
+ * - 読み込み時の列の順序は任意で、未知の列は無視し、ID 以外の列は省略可能
+ * - プロジェクト名はルートタスクの Name（プロジェクトの説明は表に含まれない）
+ *
+ * 【設計原則】
+ * - 書き出し: 行きがけ順に1行ずつバッファへ書き、1MBごとに出力先へ書き出す
+ * - 読み込み: メモリマップしたファイルを先頭から1回走査し、親は直前の行の
+ *   祖先から探す（行きがけ順の表では親は常に祖先の中にある）
+ * - 使用メモリは構築したタスクと祖先1系列分のみ（行数に比例する作業領域を持たない）
+ * - 親が後の行にある表でも読み込めるよう、祖先に見つからない場合だけ ID の索引を作る
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#include <windows.h>   // Windows基本API
+#include <memory>      // スマートポインタ（メモリ安全性）
+#include <vector>      // 動的配列（祖先・未解決の行）
+#include <string>      // 文字列クラス（テキスト処理）
+#include <cstring>     // strlen（列名の長さ）
+#include <algorithm>   // std::reverse（祖先の系列）、std::sort（保留した行の付け替え）
+
+#include "WBS_cpp_win32/WBSClasses.h"        // WBSクラス定義
+#include "WBS_cpp_win32/WBSDelimitedText.h"  // 区切り文字形式の読み書き
+#include "WBS_cpp_win32/WBSOutputSink.h"     // バイト列出力先
+#include "WBS_cpp_win32/WBSMappedFile.h"     // 読み取り専用メモリマップファイル
+#include "WBS_cpp_win32/WBSFieldCodec.h"     // 数値・列挙型・日時フィールドの文字列変換
+#include "WBS_cpp_win32/WBSUtf8.h"           // UTF-8変換
+
+// ============================================================================
+// 列の定義
+// ============================================================================
+
+/**
+ * @brief タスク表の列の種別
+ */
+enum class TaskTableColumn {
+    None,               // 未知の列（読み込み時は無視）
+    Id,
+    ParentId,
+    Level,
+    Name,
+    Description,
+    AssignedTo,
+    Status,
+    Priority,
+    EstimatedHours,
+    ActualHours,
+    StartDate,
+    EndDate
+};
+
+/**
+ * @brief 列名と種別の対応（書き出す列の順序）
+ */
+const struct {
+    const char* name;
+    TaskTableColumn column;
+} kTaskTableColumns[] = {
+    {"ID", TaskTableColumn::Id},
+    {"ParentID", TaskTableColumn::ParentId},
+    {"Level", TaskTableColumn::Level},
+    {"Name", TaskTableColumn::Name},
+    {"Description", TaskTableColumn::Description},
+    {"AssignedTo", TaskTableColumn::AssignedTo},
+    {"Status", TaskTableColumn::Status},
+    {"Priority", TaskTableColumn::Priority},
+    {"EstimatedHours", TaskTableColumn::EstimatedHours},
+    {"ActualHours", TaskTableColumn::ActualHours},
+    {"StartDate", TaskTableColumn::StartDate},
+    {"EndDate", TaskTableColumn::EndDate},
+};
+
+/**
+ * @brief 見出し行の列名から列の種別を判定
+ *
+ * @param first 列名の先頭
+ * @param last 列名の終端
+ * @return 対応する種別（大文字小文字・前後の空白は区別しない）、該当しない場合は None
+ */
+TaskTableColumn ClassifyTaskTableColumn(const char* first, const char* last) {
+    WBSFieldCodecDetail::TrimSpace(first, last);
+    for (const auto& entry : kTaskTableColumns) {
+        size_t length = strlen(entry.name);
+        if (static_cast<size_t>(last - first) != length) {
+            continue;
+        }
+        bool equal = true;
+        for (size_t i = 0; i < length && equal; ++i) {
+            char a = first[i];
+            char b = entry.name[i];
+            if (a >= 'A' && a <= 'Z') a = static_cast<char>(a - 'A' + 'a');
+            if (b >= 'A' && b <= 'Z') b = static_cast<char>(b - 'A' + 'a');
+            equal = (a == b);
+        }
+        if (equal) {
+            return entry.column;
+        }
+    }
+    return TaskTableColumn::None;
+}
+
+/**
+ * @brief タスク表のファイルパスから区切り文字を判定
+ *
+ * @param filePath 判定対象のファイルパス
+ * @return 拡張子が ".csv" なら ','、".tsv" なら '\t'（大文字小文字を区別しない）、
+ *         それ以外は '\0'
+ */
+char GetTaskTableDelimiter(const std::wstring& filePath) {
+    const size_t length = 4;
+    if (filePath.size() < length) {
+        return '\0';
+    }
+    const wchar_t* extension = filePath.c_str() + filePath.size() - length;
+    return _wcsicmp(extension, L".csv") == 0 ? ','
+        : _wcsicmp(extension, L".tsv") == 0 ? '\t'
+        : '\0';
+}
+
+// ============================================================================
+// 書き出し関数群
+// ============================================================================
+
+/**
+ * @brief WBSアイテムの部分木をタスク表の行として書き込み（行きがけ順、再帰的）
+ *
+ * @param writer 書き込み先のライター
+ * @param item 書き込むWBSアイテム
+ * @param parentId 親タスクのID（ルートは空文字列）
+ */
+void WriteTaskTableRows(WBSDelimitedWriter& writer, const WBSItem& item, const std::string& parentId) {
+    char buffer[kWBSFieldBufferSize];
+    size_t length;
+
+    std::string id = item.id.ToString(); // 子タスクの ParentID 列にも使う
+    writer.TextField(id);
+    writer.TextField(parentId);
+    length = FormatIntField(buffer, item.level);
+    writer.RawField(buffer, length);
+    writer.TextField(item.taskName);
+    writer.TextField(item.description.str());
+    writer.TextField(item.assignedTo.str());
+    length = FormatIntField(buffer, static_cast<int>(item.status));
+    writer.RawField(buffer, length);
+    length = FormatIntField(buffer, static_cast<int>(item.priority));
+    writer.RawField(buffer, length);
+    length = FormatDoubleField(buffer, item.estimatedHours);
+    writer.RawField(buffer, length);
+    length = FormatDoubleField(buffer, item.actualHours);
+    writer.RawField(buffer, length);
+    length = FormatDateField(buffer, item.startDate);
+    writer.RawField(buffer, length);
+    length = FormatDateField(buffer, item.endDate);
+    writer.RawField(buffer, length);
+    writer.EndRecord();
+
+    for (const auto& child : item.children) {
+        if (child) {
+            WriteTaskTableRows(writer, *child, id);
+        }
+    }
+}
+
+/**
+ * @brief プロジェクトの全タスクをタスク表として出力先へ書き込み
+ *
+ * @param project 書き込み対象のプロジェクト（遅延読み込みの子は構築済みであること）
+ * @param sink 出力先（ファイル、メモリ等）
+ * @param delimiter 区切り文字（',' または '\t'）
+ * @return 書き込みに成功した場合true
+ *
+ * UTF-8のBOM、見出し行、タスクの行（行きがけ順）の順に書き込みます。
+ * ライターのバッファは1MBごとに出力先へ書き出されるため、
+ * 使用メモリはプロジェクトの規模に依存しません。
+ */
+bool WriteProjectTaskTable(const WBSProject& project, WBSOutputSink& sink, char delimiter) {
+    if (!project.rootTask) {
+        return false;
+    }
+
+    WBSDelimitedWriter writer(sink, delimiter);
+    writer.Raw(kWBSUtf8Bom);   // 表計算ソフトがUTF-8と判定できるように付ける
+    for (const auto& entry : kTaskTableColumns) {
+        writer.RawField(entry.name, strlen(entry.name));
+    }
+    writer.EndRecord();
+
+    WriteTaskTableRows(writer, *project.rootTask, std::string());
+    return writer.Flush();
+}
+
+// ============================================================================
+// 読み込み関数群
+// ============================================================================
+
+/**
+ * @brief タスク表のフィールドを内部文字列（UTF-8）として格納
+ *
+ * @param out 格納先（既存の値は置き換える）
+ * @param first フィールドの先頭
+ * @param last フィールドの終端
+ * @param ansi true の場合はシステムのコードページ（日本語環境では Shift_JIS）から変換
+ *
+ * UTF-8のフィールドはそのままコピーします（BOM付きのファイルは未検証のため、
+ * 不正なバイト列は U+FFFD に置き換え）。
+ */
+void AssignTaskTableText(std::string& out, const char* first, const char* last, bool ansi) {
+    out.clear();
+    if (!ansi) {
+        AppendSanitizedUtf8(out, first, last);
+        return;
+    }
+    int length = static_cast<int>(last - first);
+    if (length <= 0) {
+        return;
+    }
+    int count = MultiByteToWideChar(CP_ACP, 0, first, length, nullptr, 0);
+    if (count <= 0) {
+        return;
+    }
+    std::wstring wide(static_cast<size_t>(count), L'\0');
+    MultiByteToWideChar(CP_ACP, 0, first, length, &wide[0], count);
+    AppendUtf8(out, wide.data(), wide.data() + wide.size());
+}
+
+/**
+ * @brief タスク表のIDフィールドを解析して格納
+ *
+ * ASCIIだけのフィールド（番号どおりのIDを含む）は文字列に変換せずに解析します。
+ */
+void AssignTaskTableId(WBSTaskId& out, const char* first, const char* last, bool ansi) {
+    const char* p = first;
+    while (p != last && static_cast<unsigned char>(*p) < 0x80) {
+        ++p;
+    }
+    if (p == last) {
+        out.Assign(first, static_cast<size_t>(last - first));
+        return;
+    }
+    std::string text;
+    AssignTaskTableText(text, first, last, ansi);
+    out.Assign(text);
+}
+
+/**
+ * @brief タスク表の1フィールドをWBSアイテムへ反映
+ *
+ * @param item 反映先のWBSアイテム
+ * @param parentId [out] ParentID 列の値の格納先
+ * @param column 列の種別
+ * @param first フィールドの先頭
+ * @param last フィールドの終端
+ * @param ansi テキストをシステムのコードページとして変換する場合true
+ * @return 値の形式が正しい場合true（数値・列挙型が不正な場合false）
+ *
+ * 空のフィールドは既定値を保持します。日時の形式が正しくない場合は
+ * XML形式の読み込みと同じく現在時刻とします。Level 列は読み捨て、
+ * 階層レベルは親から求めます。
+ */
+bool ApplyTaskTableField(WBSItem& item, WBSTaskId& parentId, TaskTableColumn column,
+                         const char* first, const char* last, bool ansi) {
+    switch (column) {
+        case TaskTableColumn::Id:          AssignTaskTableId(item.id, first, last, ansi); return true;
+        case TaskTableColumn::ParentId:    AssignTaskTableId(parentId, first, last, ansi); return true;
+        case TaskTableColumn::Name:        AssignTaskTableText(item.taskName, first, last, ansi); return true;
+        case TaskTableColumn::Description: {
+            if (!ansi) {
+                item.description.Assign(first, last); // 検証済みのUTF-8はストアへ直接コピー
+                return true;
+            }
+            std::string description;
+            AssignTaskTableText(description, first, last, ansi);
+            item.description = description;
+            return true;
+        }
+        case TaskTableColumn::AssignedTo: {
+            std::string assignedTo;
+            AssignTaskTableText(assignedTo, first, last, ansi);
+            item.assignedTo = assignedTo; // 担当者名はインターンして保持
+            return true;
+        }
+        default:
+            break;
+    }
+
+    if (first == last) {
+        return true;
+    }
+    switch (column) {
+        case TaskTableColumn::Status:         return ParseStatusField(first, last, item.status);
+        case TaskTableColumn::Priority:       return ParsePriorityField(first, last, item.priority);
+        case TaskTableColumn::EstimatedHours: return ParseDoubleField(first, last, item.estimatedHours);
+        case TaskTableColumn::ActualHours:    return ParseDoubleField(first, last, item.actualHours);
+        case TaskTableColumn::StartDate:
+            if (!ParseDateField(first, last, item.startDate)) item.startDate = WBSDateTime::Now();
+            return true;
+        case TaskTableColumn::EndDate:
+            if (!ParseDateField(first, last, item.endDate)) item.endDate = WBSDateTime::Now();
+            return true;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief タスク表の行から階層構造を組み立てるビルダー
+ *
+ * 行を読んだ順に Add() し、最後に Finish() で保留した行の親を解決します。
+ * タスクはプロジェクトのルート（最初の行）の下に WBSProject::InsertTask() で接続します。
+ *
+ * @details 親の探索:
+ * 1. 直前に追加したタスクとその祖先（ancestors_）を末尾から探す
+ *    （行きがけ順の表ではここで必ず見つかり、探索は祖先の数で済む）
+ * 2. 見つからない場合だけ WBSProject::FindTask() で探す
+ *    （IDの索引は最初の検索で作成され、以後は InsertTask() のたびに更新される）
+ * 3. それでも見つからない行は保留してルートの子として仮に接続し、Finish() で改めて親を探す
+ *    （親が後の行にある場合。最後まで見つからない場合や親子が循環する場合はルートの子とする）
+ * ParentID が空の行はルートの子とします。同じ ID が複数ある場合は、
+ * 祖先の中では直前のもの、それ以外では FindTask() が返すものが親になります。
+ */
+class TaskTableBuilder {
+public:
+    explicit TaskTableBuilder(WBSProject& project) : project_(project), hasRoot_(false) {}
+
+    /**
+     * @brief 1行分のタスクを追加
+     * @param item 追加するタスク（最初の行はルートタスク）
+     * @param parentId 親タスクのID
+     */
+    void Add(std::shared_ptr<WBSItem> item, const WBSTaskId& parentId) {
+        WBSItem* added = item.get();
+        if (!hasRoot_) {
+            hasRoot_ = true;
+            item->level = 0;
+            project_.rootTask = std::move(item);
+            project_.InvalidateTaskIndex();
+            ancestors_.assign(1, added);
+        } else if (parentId.IsEmpty()) {
+            Attach(*project_.rootTask, std::move(item));
+            ancestors_.assign(1, project_.rootTask.get());
+            ancestors_.push_back(added);
+        } else if (WBSItem* parent = FindParent(parentId)) {
+            Attach(*parent, std::move(item));
+            ancestors_.push_back(added);
+        } else {
+            // 親は後の行にある: 保留した行を部分木の根として子孫を受け付ける
+            Attach(*project_.rootTask, std::move(item));
+            pending_.emplace_back(added, parentId);
+            ancestors_.assign(1, added);
+        }
+    }
+
+    /**
+     * @brief 保留した行の親を解決
+     * @return ルートタスクがある場合true（行が1行もなかった場合はfalse）
+     */
+    bool Finish() {
+        if (pending_.empty()) {
+            return hasRoot_;
+        }
+        WBSItem& root = *project_.rootTask;
+        std::vector<std::shared_ptr<WBSItem>> orphans;
+        for (auto& entry : pending_) {
+            std::shared_ptr<WBSItem> parent = project_.FindTask(entry.second);
+            if (!parent || IsInSubtree(*parent, *entry.first)) {
+                parent = project_.rootTask;  // 親子の循環はルートの子として断ち切る
+            }
+            // IDは変わらないため、索引を更新せずに付け替える
+            std::shared_ptr<WBSItem> item = entry.first->shared_from_this();
+            item->parent = parent;
+            item->level = parent->level + 1;
+            SetSubtreeLevels(*item);
+            if (parent.get() == &root) {
+                orphans.push_back(std::move(item));
+            } else {
+                parent->children.push_back(std::move(item));
+            }
+        }
+
+        // 仮に接続していた行をルートの子から外し、親のない行を末尾に並べ直す
+        std::vector<const WBSItem*> moved;
+        moved.reserve(pending_.size());
+        for (const auto& entry : pending_) {
+            moved.push_back(entry.first);
+        }
+        std::sort(moved.begin(), moved.end());
+        std::vector<std::shared_ptr<WBSItem>>& children = root.children;
+        children.erase(std::remove_if(children.begin(), children.end(),
+            [&moved](const std::shared_ptr<WBSItem>& child) {
+                return std::binary_search(moved.begin(), moved.end(), child.get());
+            }), children.end());
+        for (auto& orphan : orphans) {
+            children.push_back(std::move(orphan));
+        }
+        root.InvalidateHash();
+        pending_.clear();
+        return true;
+    }
+
+private:
+    /**
+     * @brief 親タスクを探し、祖先の系列を親までに切り詰める
+     * @return 親タスク（見つからない場合はnullptr、祖先の系列は変更しない）
+     */
+    WBSItem* FindParent(const WBSTaskId& parentId) {
+        for (size_t i = ancestors_.size(); i-- > 0; ) {
+            if (ancestors_[i]->id == parentId) {
+                ancestors_.resize(i + 1);
+                return ancestors_.back();
+            }
+        }
+
+        std::shared_ptr<WBSItem> found = project_.FindTask(parentId);
+        if (!found) {
+            return nullptr;
+        }
+
+        // 祖先の系列を見つかった親からたどり直す
+        ancestors_.clear();
+        for (WBSItem* node = found.get(); node; ) {
+            ancestors_.push_back(node);
+            auto parent = node->parent.lock();
+            node = parent.get();
+        }
+        std::reverse(ancestors_.begin(), ancestors_.end());
+        return found.get();
+    }
+
+    /**
+     * @brief 子タスクとして接続し、階層レベルを設定
+     */
+    void Attach(WBSItem& parent, std::shared_ptr<WBSItem> item) {
+        item->level = parent.level + 1;
+        project_.InsertTask(parent, parent.children.size(), item);
+    }
+
+    static void SetSubtreeLevels(WBSItem& item) {
+        for (const auto& child : item.children) {
+            child->level = item.level + 1;
+            SetSubtreeLevels(*child);
+        }
+    }
+
+    static bool IsInSubtree(const WBSItem& node, const WBSItem& subtreeRoot) {
+        for (std::shared_ptr<const WBSItem> current = node.shared_from_this(); current; current = current->parent.lock()) {
+            if (current.get() == &subtreeRoot) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    WBSProject& project_;                           ///< 構築先のプロジェクト（IDの索引を含む）
+    bool hasRoot_;                                  ///< ルートタスク（最初の行）を設定済みか
+    std::vector<WBSItem*> ancestors_;               ///< 直前に追加したタスクとその祖先（ルート側から）
+    std::vector<std::pair<WBSItem*, WBSTaskId>> pending_;  ///< 親が未解決の行（ルートの子として仮に接続）と親のID
+};
+
+/**
+ * @brief タスク表のバイト列からプロジェクトを構築（単一パス）
+ *
+ * @param data ファイル内容の先頭
+ * @param size ファイルサイズ
+ * @param delimiter 区切り文字（',' または '\t'）
+ * @return 構築されたプロジェクト、形式エラーの場合はnullptr
+ *
+ * @details 処理フロー:
+ * 1. 見出し行から各列の種別を判定（ID 列がなければ形式エラー）
+ * 2. 行を先頭から1行ずつ読み、TaskTableBuilder で親に接続
+ * 3. ルートタスクの名前をプロジェクト名とする
+ *
+ * BOMがなくUTF-8として不正なファイルは、表計算ソフトがシステムのコードページで
+ * 保存したものとみなして変換します。引用符が閉じられていない場合、
+ * 数値・列挙型が不正な場合、タスクの行がない場合は形式エラーです。
+ */
+std::unique_ptr<WBSProject> ParseProjectFromTaskTable(const char* data, size_t size, char delimiter) {
+    bool ansi = !(size >= 3 && memcmp(data, kWBSUtf8Bom, 3) == 0) && !IsValidUtf8(data, size);
+
+    WBSDelimitedReader reader(data, size, delimiter);
+    if (!reader.NextRecord()) {
+        return nullptr;
+    }
+
+    // 見出し行
+    std::vector<TaskTableColumn> columns(reader.FieldCount());
+    bool hasId = false;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const char* first;
+        const char* last;
+        reader.Field(i, first, last);
+        columns[i] = ClassifyTaskTableColumn(first, last);
+        hasId = hasId || columns[i] == TaskTableColumn::Id;
+    }
+    if (!hasId) {
+        return nullptr;
+    }
+
+    // タスクの行
+    auto arena = std::make_shared<WBSArena>();
+    auto project = std::make_unique<WBSProject>(std::string(), arena);
+    TaskTableBuilder builder(*project);
+    WBSTaskId parentId;
+    while (reader.NextRecord()) {
+        auto item = WBSItem::Create(arena);
+        parentId.Clear();
+        size_t count = reader.FieldCount() < columns.size() ? reader.FieldCount() : columns.size();
+        for (size_t i = 0; i < count; ++i) {
+            const char* first;
+            const char* last;
+            reader.Field(i, first, last);
+            if (!ApplyTaskTableField(*item, parentId, columns[i], first, last, ansi)) {
+                return nullptr;
+            }
+        }
+        builder.Add(std::move(item), parentId);
+    }
+    if (reader.Failed()) {
+        return nullptr;
+    }
+
+    if (!builder.Finish()) {
+        return nullptr;
+    }
+
+    // プロジェクト名のバリデーション（XML読み込みと同じ規則）
+    std::string projectName = project->rootTask->taskName;
+    if (projectName.empty()) {
+        projectName = u8"読み込まれたプロジェクト";
+    }
+    project->rootTask->taskName = projectName;
+    project->projectName = projectName;
+    return project;
+}
+
+/**
+ * @brief タスク表ファイル（.csv/.tsv）からプロジェクトを読み込み
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @param delimiter 区切り文字（GetTaskTableDelimiter() の戻り値）
+ * @return ファイルを開けた場合true
+ *
+ * ファイルをメモリマップし、ParseProjectFromTaskTable() で先頭から1回走査して構築します。
+ */
+bool ReadProjectTaskTableFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project, char delimiter) {
+    WBSMappedFile file(filePath);
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    project = ParseProjectFromTaskTable(file.Data(), file.Size(), delimiter);
+    return true;
+}
@@ -0,0 +1,498 @@
+/*
+ * ============================================================================
+ * WBS_JSON_Functions.cpp - JSON形式（.json）入出力モジュール
+ * ============================================================================
+ *
+ * このモジュールは、WBSプロジェクトをJSON形式で保存・読み込みする機能を
+ * 提供します。外部ツールとの連携用で、XML形式と同じフィールドと入れ子構造を持ちます。
+ *
+ * 【文書構造】
+ * @code
+ * {
+ *   "ProjectName": "...",
+ *   "Description": "...",
+ *   "RootTask": {
+ *     "ID": "1", "Name": "...", "Description": "...", "AssignedTo": "...",
+ *     "Status": 0, "Priority": 1, "EstimatedHours": 8.000000, "ActualHours": 0.000000,
+ *     "StartDate": "2024-01-15T09:00:00", "EndDate": "...", "Level": 0,
+ *     "Children": [ { ...子タスク... } ]
+ *   }
+ * }
+ * @endcode
+ * - メンバー名はXML形式の要素名と同じ
+ * - Status・Priority は列挙型の数値、日時は ISO 8601 の文字列（XML形式と同じ）
+ * - JSONの数値で表せない時間（INF・NaN）は文字列として書き込む
+ * - 子タスクのないタスクは "Children" を省略（XML形式の <Children> と同じ）
+ *
+ * 【設計原則】
+ * - 書き出し: WBSJsonWriter で1MBごとに出力先へ書き出す（文書全体を保持しない）
+ * - 読み込み: メモリマップしたファイルを WBSJsonReader で一度だけ前方へ走査し、
+ *   DOMを作らずにトークンから直接タスクを構築（木の深さに依存しないスタック処理）
+ * - 互換性: 未知のメンバーは読み飛ばし、省略されたメンバーは既定値とする
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#include <windows.h>   // Windows基本API
+#include <memory>      // スマートポインタ（メモリ安全性）
+#include <vector>      // 動的配列（祖先タスクのスタック）
+#include <string>      // 文字列クラス（テキスト処理）
+#include <cmath>       // std::isfinite（JSONの数値で表せない値の判定）
+
+#include "WBS_cpp_win32/WBSClasses.h"     // WBSクラス定義
+#include "WBS_cpp_win32/WBSJsonWriter.h"  // ストリーミングJSONライター
+#include "WBS_cpp_win32/WBSJsonReader.h"  // 前方向専用JSONプルパーサー
+#include "WBS_cpp_win32/WBSOutputSink.h"  // バイト列出力先
+#include "WBS_cpp_win32/WBSMappedFile.h"  // 読み取り専用メモリマップファイル
+#include "WBS_cpp_win32/WBSFieldCodec.h"  // 数値・列挙型・日時フィールドの文字列変換
+#include "WBS_cpp_win32/WBSUtf8.h"        // UTF-8検証
+
+// ============================================================================
+// JSONシリアライゼーション関数群
+// ============================================================================
+
+/**
+ * @brief 時間フィールドをメンバーとして書き込み
+ *
+ * @param writer 書き込み先のライター
+ * @param indent インデント（空白文字数）
+ * @param name メンバー名
+ * @param value 値
+ *
+ * 有限の値は数値、INF・NaN はJSONの数値で表せないため文字列とします。
+ */
+void WriteDoubleMemberJson(WBSJsonWriter& writer, int indent, const char* name, double value) {
+    char buffer[kWBSFieldBufferSize];
+    size_t length = FormatDoubleField(buffer, value);
+    writer.RawMember(indent, name, buffer, length, !std::isfinite(value));
+}
+
+/**
+ * @brief WBSアイテムをJSONオブジェクトとして書き込み（再帰的）
+ *
+ * @param writer 書き込み先のライター
+ * @param item 書き込み対象のWBSアイテム
+ * @param indent オブジェクトのインデント（空白文字数）
+ * @param name メンバー名（配列の要素の場合は nullptr）
+ *
+ * メンバーの順序は WriteTaskXml() の要素の順序と同じです。
+ */
+void WriteTaskJson(WBSJsonWriter& writer, const WBSItem& item, int indent, const char* name) {
+    char buffer[kWBSFieldBufferSize];
+    size_t length;
+
+    writer.OpenObject(indent, name);
+
+    // 基本情報フィールド
+    writer.TextMember(indent + 2, "ID", item.id.ToString());
+    writer.TextMember(indent + 2, "Name", item.taskName);
+    writer.TextMember(indent + 2, "Description", item.description.str());
+    writer.TextMember(indent + 2, "AssignedTo", item.assignedTo.str());
+
+    // 列挙型フィールド（数値）
+    length = FormatIntField(buffer, static_cast<int>(item.status));
+    writer.RawMember(indent + 2, "Status", buffer, length, false);
+    length = FormatIntField(buffer, static_cast<int>(item.priority));
+    writer.RawMember(indent + 2, "Priority", buffer, length, false);
+
+    // 工数フィールド
+    WriteDoubleMemberJson(writer, indent + 2, "EstimatedHours", item.estimatedHours);
+    WriteDoubleMemberJson(writer, indent + 2, "ActualHours", item.actualHours);
+
+    // 日時フィールド（ISO 8601形式の文字列）
+    length = FormatDateField(buffer, item.startDate);
+    writer.RawMember(indent + 2, "StartDate", buffer, length, true);
+    length = FormatDateField(buffer, item.endDate);
+    writer.RawMember(indent + 2, "EndDate", buffer, length, true);
+
+    // 階層情報
+    length = FormatIntField(buffer, item.level);
+    writer.RawMember(indent + 2, "Level", buffer, length, false);
+
+    // 子タスクの配列（再帰的）
+    if (!item.children.empty()) {
+        writer.OpenArray(indent + 2, "Children");
+        for (const auto& child : item.children) {
+            if (child) {
+                WriteTaskJson(writer, *child, indent + 4, nullptr);
+            }
+        }
+        writer.CloseArray(indent + 2);
+    }
+
+    writer.CloseObject(indent);
+}
+
+/**
+ * @brief プロジェクト全体をJSON文書として出力先へ書き込み
+ *
+ * @param project 書き込み対象のプロジェクト（遅延読み込みの子は構築済みであること）
+ * @param sink 出力先（ファイル、メモリ等）
+ * @return 書き込みに成功した場合true
+ *
+ * ライターのバッファは1MBごとに出力先へ書き出されるため、
+ * 使用メモリはプロジェクトの規模に依存しません。
+ */
+bool WriteProjectJson(const WBSProject& project, WBSOutputSink& sink) {
+    WBSJsonWriter writer(sink);
+
+    writer.OpenObject(0, nullptr);
+    writer.TextMember(2, "ProjectName", project.projectName);
+    writer.TextMember(2, "Description", project.description);
+    if (project.rootTask) {
+        WriteTaskJson(writer, *project.rootTask, 2, "RootTask");
+    }
+    writer.CloseObject(0);
+    writer.Raw("\n");
+    return writer.Flush();
+}
+
+// ============================================================================
+// JSONデシリアライゼーション関数群
+// ============================================================================
+
+/**
+ * @brief タスクオブジェクト内のメンバー種別
+ */
+enum class TaskJsonField {
+    None,               // 未知のメンバー（読み飛ばす）
+    Id,
+    Name,
+    Description,
+    AssignedTo,
+    Status,
+    Priority,
+    EstimatedHours,
+    ActualHours,
+    StartDate,
+    EndDate,
+    Level,
+    Children
+};
+
+/**
+ * @brief 現在のメンバー名からタスクのメンバー種別を判定
+ *
+ * @param reader Key を返した直後のリーダー
+ * @return 対応するメンバー種別、該当しない場合は TaskJsonField::None
+ */
+TaskJsonField ClassifyTaskJsonField(const WBSJsonReader& reader) {
+    static const struct {
+        const char* name;
+        TaskJsonField field;
+    } fields[] = {
+        {"ID", TaskJsonField::Id},
+        {"Name", TaskJsonField::Name},
+        {"Description", TaskJsonField::Description},
+        {"AssignedTo", TaskJsonField::AssignedTo},
+        {"Status", TaskJsonField::Status},
+        {"Priority", TaskJsonField::Priority},
+        {"EstimatedHours", TaskJsonField::EstimatedHours},
+        {"ActualHours", TaskJsonField::ActualHours},
+        {"StartDate", TaskJsonField::StartDate},
+        {"EndDate", TaskJsonField::EndDate},
+        {"Level", TaskJsonField::Level},
+        {"Children", TaskJsonField::Children},
+    };
+
+    for (const auto& entry : fields) {
+        if (reader.KeyIs(entry.name)) {
+            return entry.field;
+        }
+    }
+    return TaskJsonField::None;
+}
+
+/**
+ * @brief 数値・日付メンバーの値をWBSアイテムへ反映
+ *
+ * @param item 反映先のWBSアイテム
+ * @param field メンバー種別
+ * @param first 値の先頭（UTF-8、引用符・エスケープは除去済み）
+ * @param last 値の終端
+ * @return 値の形式が正しい場合true（数値・列挙型が不正な場合false）
+ *
+ * 空文字列の場合は既定値を保持します。日時の形式が正しくない場合は
+ * XML形式の読み込みと同じく現在時刻とします。
+ */
+bool ApplyTaskJsonScalar(WBSItem& item, TaskJsonField field, const char* first, const char* last) {
+    if (first == last) {
+        return true;
+    }
+    switch (field) {
+        case TaskJsonField::Status:         return ParseStatusField(first, last, item.status);
+        case TaskJsonField::Priority:       return ParsePriorityField(first, last, item.priority);
+        case TaskJsonField::EstimatedHours: return ParseDoubleField(first, last, item.estimatedHours);
+        case TaskJsonField::ActualHours:    return ParseDoubleField(first, last, item.actualHours);
+        case TaskJsonField::Level:          return ParseIntField(first, last, item.level);
+        case TaskJsonField::StartDate:
+            if (!ParseDateField(first, last, item.startDate)) item.startDate = WBSDateTime::Now();
+            return true;
+        case TaskJsonField::EndDate:
+            if (!ParseDateField(first, last, item.endDate)) item.endDate = WBSDateTime::Now();
+            return true;
+        default:
+            return true;
+    }
+}
+
+/**
+ * @brief タスクのメンバー1つの値を読み取ってWBSアイテムへ反映
+ *
+ * @param reader Key を返した直後のリーダー（値を読み終えた位置まで進む）
+ * @param item 反映先のWBSアイテム
+ * @param field メンバー種別（Children 以外）
+ * @param scratch エスケープを含む数値・日付の復元用の再利用バッファ
+ * @return 値の型と形式が正しい場合true
+ *
+ * null は省略と同じく既定値を保持します。文字列メンバーに文字列以外、
+ * 数値メンバーに数値・文字列以外の値がある場合は形式エラーです。
+ */
+bool ReadTaskJsonMember(WBSJsonReader& reader, WBSItem& item, TaskJsonField field, std::string& scratch) {
+    WBSJsonToken token = reader.Next();
+    if (field == TaskJsonField::None) {
+        return reader.SkipValue(token);
+    }
+    if (token == WBSJsonToken::Literal) {
+        const char* first;
+        const char* last;
+        reader.Value(first, last);
+        return last - first == 4 && memcmp(first, "null", 4) == 0;
+    }
+
+    if (field == TaskJsonField::Description) {
+        if (token != WBSJsonToken::String) {
+            return false;
+        }
+        // 説明は表示されるまで復元しない（エスケープを含まなければそのまま登録）
+        const char* first;
+        const char* last;
+        reader.Value(first, last);
+        if (reader.HasEscapes()) {
+            item.description.AssignEncoded(first, last, WBSJsonReader::AppendUnescaped);
+        } else {
+            item.description.Assign(first, last);
+        }
+        return true;
+    }
+
+    std::string* target = nullptr;
+    switch (field) {
+        case TaskJsonField::Id:          target = &scratch; break; // 読み取り後に番号の並びへ解析
+        case TaskJsonField::Name:        target = &item.taskName; break;
+        case TaskJsonField::AssignedTo:  target = &scratch; break; // 読み取り後にインターン
+        default: break;
+    }
+    if (target) {
+        if (token != WBSJsonToken::String) {
+            return false;
+        }
+        target->clear();
+        reader.AppendString(*target);
+        if (field == TaskJsonField::AssignedTo) {
+            item.assignedTo = scratch;
+        } else if (field == TaskJsonField::Id) {
+            item.id.Assign(scratch);
+        }
+        return true;
+    }
+
+    if (token != WBSJsonToken::Number && token != WBSJsonToken::String) {
+        return false;
+    }
+    if (token == WBSJsonToken::String && reader.HasEscapes()) {
+        scratch.clear();
+        reader.AppendString(scratch);
+        return ApplyTaskJsonScalar(item, field, scratch.data(), scratch.data() + scratch.size());
+    }
+    const char* first;
+    const char* last;
+    reader.Value(first, last);
+    return ApplyTaskJsonScalar(item, field, first, last);
+}
+
+/**
+ * @brief タスクオブジェクトとその子孫を読み取る（単一パス）
+ *
+ * @param reader タスクの BeginObject を返した直後のリーダー
+ * @param arena タスクの確保元のアリーナ
+ * @return 構築したタスク、構文・形式エラーの場合はnullptr
+ *
+ * 再帰せずに祖先タスクのスタックで入れ子を処理します。"Children" 配列内の
+ * オブジェクトを子タスクとして構築し、オブジェクト以外の要素は読み飛ばします。
+ *
+ * @note 計算量: 入力長に対して線形（木の深さに依存しない）
+ */
+std::shared_ptr<WBSItem> ParseTaskJson(WBSJsonReader& reader, const std::shared_ptr<WBSArena>& arena) {
+    std::vector<std::shared_ptr<WBSItem>> stack;    // 祖先タスクのスタック
+    std::string scratch;                            // 数値・日付の再利用バッファ
+
+    auto root = WBSItem::Create(arena);
+    root->taskName.clear();
+    stack.push_back(root);
+
+    while (true) {
+        WBSJsonToken token = reader.Next();
+        switch (token) {
+            case WBSJsonToken::Key: {
+                TaskJsonField field = ClassifyTaskJsonField(reader);
+                if (field != TaskJsonField::Children) {
+                    if (!ReadTaskJsonMember(reader, *stack.back(), field, scratch)) {
+                        return nullptr;
+                    }
+                    break;
+                }
+                // 配列の要素は以降のループで BeginObject として受け取る
+                token = reader.Next();
+                if (token != WBSJsonToken::BeginArray && !reader.SkipValue(token)) {
+                    return nullptr;
+                }
+                break;
+            }
+
+            case WBSJsonToken::BeginObject: {
+                // "Children" 配列内の子タスクの開始: 親子関係を設定してスタックへ積む
+                auto child = WBSItem::Create(arena);
+                child->taskName.clear();
+                child->parent = stack.back();
+                stack.back()->children.push_back(child);
+                stack.push_back(child);
+                break;
+            }
+
+            case WBSJsonToken::EndObject:
+                stack.pop_back();
+                if (stack.empty()) {
+                    return root;    // 最上位のタスクの '}' に到達
+                }
+                break;
+
+            case WBSJsonToken::EndArray:
+                break;              // "Children" 配列の終端
+
+            case WBSJsonToken::BeginArray:
+            case WBSJsonToken::String:
+            case WBSJsonToken::Number:
+            case WBSJsonToken::Literal:
+                if (!reader.SkipValue(token)) {
+                    return nullptr; // "Children" 配列内のオブジェクト以外の要素
+                }
+                break;
+
+            default:
+                return nullptr;     // 構文エラー・文書の途中での終端
+        }
+    }
+}
+
+/**
+ * @brief JSON文書全体からプロジェクトを構築（単一パス）
+ *
+ * @param first JSON文書の先頭（UTF-8）
+ * @param last JSON文書の終端
+ * @return 構築されたプロジェクト、構文エラーの場合はnullptr
+ *
+ * 最上位オブジェクトの "ProjectName"、"Description"、"RootTask" を
+ * 一度の前方走査で読み取ります。ルートタスクの名前はプロジェクト名に
+ * 統一されます（XML形式と同じ規則）。
+ */
+std::unique_ptr<WBSProject> ParseProjectFromJson(const char* first, const char* last) {
+    WBSJsonReader reader(first, last);
+    if (reader.Next() != WBSJsonToken::BeginObject) {
+        return nullptr;
+    }
+
+    std::string projectName;
+    std::string description;
+    std::shared_ptr<WBSItem> rootTask;
+    auto arena = std::make_shared<WBSArena>();
+
+    while (true) {
+        WBSJsonToken token = reader.Next();
+        if (token == WBSJsonToken::EndObject) {
+            break;
+        }
+        if (token != WBSJsonToken::Key) {
+            return nullptr;
+        }
+
+        std::string* target = reader.KeyIs("ProjectName") ? &projectName
+            : reader.KeyIs("Description") ? &description
+            : nullptr;
+        bool isRootTask = reader.KeyIs("RootTask");
+        token = reader.Next();
+        if (target && token == WBSJsonToken::String) {
+            target->clear();
+            reader.AppendString(*target);
+        } else if (isRootTask && token == WBSJsonToken::BeginObject) {
+            rootTask = ParseTaskJson(reader, arena);
+            if (!rootTask) {
+                return nullptr;
+            }
+        } else if (!reader.SkipValue(token)) {
+            return nullptr;
+        }
+    }
+    if (reader.Next() != WBSJsonToken::End) {
+        return nullptr;
+    }
+
+    // プロジェクト名のバリデーション
+    if (projectName.empty()) {
+        projectName = u8"読み込まれたプロジェクト";
+    }
+
+    auto project = std::make_unique<WBSProject>(projectName, arena);
+    project->description = description;
+
+    if (rootTask) {
+        // ルートタスクの名前をプロジェクト名と統一
+        rootTask->taskName = projectName;
+        project->rootTask = rootTask;
+    }
+
+    return project;
+}
+
+// ============================================================================
+// ファイルI/O操作関数群
+// ============================================================================
+
+/**
+ * @brief JSON形式（.json）のファイルパスか判定
+ *
+ * @param filePath 判定対象のファイルパス
+ * @return 拡張子が ".json"（大文字小文字を区別しない）の場合true
+ */
+bool IsJsonProjectPath(const std::wstring& filePath) {
+    const wchar_t extension[] = L".json";
+    const size_t length = sizeof(extension) / sizeof(extension[0]) - 1;
+    return filePath.size() >= length &&
+           _wcsicmp(filePath.c_str() + filePath.size() - length, extension) == 0;
+}
+
+/**
+ * @brief JSONファイル（.json）からプロジェクトを読み込み
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @return ファイルを開けた場合true
+ *
+ * ファイルをメモリマップし、UTF-8として検証してから ParseProjectFromJson() で
+ * 一度だけ走査して構築します。UTF-8として不正なファイルは形式エラーです。
+ */
+bool ReadProjectJsonFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project) {
+    WBSMappedFile file(filePath);
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    project.reset();
+    if (IsValidUtf8(file.Data(), file.Size())) {
+        project = ParseProjectFromJson(file.Data(), file.Data() + file.Size());
+    }
+    return true;
+}
@@ -0,0 +1,841 @@
+/*
+ * ============================================================================
+ * WBS_Journal_Functions.cpp - 編集ジャーナル処理モジュール
+ * ============================================================================
+ *
+ * このモジュールは、プロジェクトの保存時に全体を書き直す代わりに、
+ * 前回の保存以降の編集内容だけをプロジェクトファイル横のジャーナル（.wbsj）へ
+ * 追記する機能を提供します。ファイル形式は WBSJournalFormat.h で定義されています。
+ *
+ * 【主な機能】
+ * - 編集の記録: フィールド変更・タスク挿入・タスク削除をメモリ上のレコードに変換
+ * - 差分保存: 同じファイルへの保存では未保存のレコードを追記するだけ
+ * - 圧縮（コンパクション）: ジャーナルが大きくなったらスナップショット全体を書き直し、
+ *   ジャーナルを空にする
+ * - 再生: 読み込み時にスナップショットへジャーナルを順に適用
+ * - バックグラウンド保存: 取り込んだ複製をワーカースレッドで書き込み、
+ *   書き込み中の保存要求は1回にまとめる
+ *
+ * 【設計原則】
+ * - 記録漏れを作らない: 記録できない変更が発生した場合は次回の保存を全体保存にする
+ * - 破損に強い: 途中で中断されたレコード以降は再生せず、次回の保存で全体を書き直す
+ * - 対応付け: スナップショットのサイズ・ハッシュが一致しないジャーナルは無視する
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#include <windows.h>   // Windows基本API
+#include <memory>      // スマートポインタ（メモリ安全性）
+#include <vector>      // 動的配列（タスクパス）
+#include <string>      // 文字列クラス（テキスト処理）
+#include <algorithm>   // std::find_if・std::reverse・std::max
+#include <thread>      // バックグラウンド保存のワーカースレッド
+#include <stdexcept>   // std::runtime_error（全体保存の取り込みエラー）
+
+#include "WBS_cpp_win32/WBSClasses.h"       // WBSクラス定義
+#include "WBS_cpp_win32/WBSJournalFormat.h" // ジャーナル形式
+#include "WBS_cpp_win32/WBSBinaryFormat.h"  // 日時のパック変換
+#include "WBS_cpp_win32/WBSOutputSink.h"    // バイト列出力先
+#include "WBS_cpp_win32/WBSMappedFile.h"    // 読み取り専用メモリマップファイル
+#include "WBS_cpp_win32/WBSCompression.h"   // 圧縮レベルの既定値
+#include "WBS_cpp_win32/WBSSaveJob.h"       // 保存ジョブ・完了通知メッセージ
+
+// ============================================================================
+// 外部依存関係 - XML・バイナリ処理モジュールとの連携
+// ============================================================================
+
+bool WriteProjectXml(const WBSProject& project, WBSOutputSink& sink);
+bool WriteProjectBinary(const WBSProject& project, WBSOutputSink& sink);
+bool IsBinaryProjectPath(const std::wstring& filePath);
+bool WriteProjectCompressedXml(const WBSProject& project, WBSOutputSink& sink, int level);
+bool IsCompressedProjectPath(const std::wstring& filePath);
+
+// JSON形式（.json）入出力モジュール（WBS_JSON_Functions.cpp）
+bool WriteProjectJson(const WBSProject& project, WBSOutputSink& sink);
+bool IsJsonProjectPath(const std::wstring& filePath);
+
+// タスク表（CSV/TSV）入出力モジュール（WBS_CSV_Functions.cpp）
+bool WriteProjectTaskTable(const WBSProject& project, WBSOutputSink& sink, char delimiter);
+char GetTaskTableDelimiter(const std::wstring& filePath);
+
+// ============================================================================
+// ジャーナルの状態
+// ============================================================================
+
+const uint64_t kJournalMinCompactionBytes = 64 * 1024;     ///< これ以下のジャーナルは圧縮しない
+
+/**
+ * @brief 現在のプロジェクトに対応するジャーナルの状態
+ *
+ * projectPath が空の場合は、まだファイルに保存されていない（対応付けなし）状態です。
+ */
+struct ProjectJournalState {
+    std::wstring projectPath;       ///< 対応するスナップショットのパス
+    uint64_t snapshotSize = 0;      ///< スナップショットのバイト数
+    uint64_t journalSize = 0;       ///< ジャーナルファイルのバイト数（ヘッダーを含む）
+    bool needsCompaction = false;   ///< 次回の保存を全体保存にする
+    std::string pending;            ///< 未保存のレコード
+};
+
+ProjectJournalState g_projectJournal;
+
+/**
+ * @brief プロジェクトファイルに対応するジャーナルのパスを取得
+ * @param projectPath プロジェクトファイルのパス
+ * @return ジャーナルのパス（"<プロジェクトファイル>.wbsj"）
+ */
+std::wstring GetJournalFilePath(const std::wstring& projectPath) {
+    return projectPath + L".wbsj";
+}
+
+/**
+ * @brief ジャーナルとの対応付けを解除（新規プロジェクト作成時）
+ *
+ * 次回の保存は必ず全体保存になります。
+ */
+void JournalDetach() {
+    g_projectJournal = ProjectJournalState();
+}
+
+// ============================================================================
+// 編集の記録
+// ============================================================================
+
+/**
+ * @brief タスクのルートからのパス（子索引の列）を求める
+ *
+ * @param item 対象のタスク
+ * @param path 求めたパスの格納先（ルートタスクは空）
+ * @return 親子関係が整合している場合true
+ */
+bool GetTaskPath(const WBSItem& item, std::vector<uint32_t>& path) {
+    path.clear();
+    const WBSItem* current = &item;
+    std::shared_ptr<WBSItem> parent = current->parent.lock();
+
+    while (parent) {
+        auto found = std::find_if(parent->children.begin(), parent->children.end(),
+                                  [current](const std::shared_ptr<WBSItem>& child) { return child.get() == current; });
+        if (found == parent->children.end() || path.size() >= kWBSJournalMaxDepth) {
+            return false;
+        }
+        path.push_back(static_cast<uint32_t>(found - parent->children.begin()));
+        current = parent.get();
+        parent = current->parent.lock();
+    }
+
+    std::reverse(path.begin(), path.end());
+    return true;
+}
+
+/**
+ * @brief 記録の前準備（対応付けがない場合は記録しない）
+ * @return 記録を続ける場合true
+ */
+bool BeginJournalRecord(const WBSItem& item, std::vector<uint32_t>& path) {
+    if (g_projectJournal.projectPath.empty() || g_projectJournal.needsCompaction) {
+        return false; // 次回は全体保存になるため記録不要
+    }
+    if (!GetTaskPath(item, path)) {
+        g_projectJournal.needsCompaction = true; // 記録できない変更
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 文字列フィールドの変更を記録
+ */
+void AppendTextFieldRecord(const std::vector<uint32_t>& path, WBSJournalField field, const std::string& value) {
+    WBSJournalRecordWriter writer(g_projectJournal.pending);
+    writer.Begin(WBSJournalOp::SetField, static_cast<uint8_t>(field), path);
+    writer.PutText(value);
+    writer.End();
+}
+
+/**
+ * @brief 数値フィールドの変更を記録
+ */
+void AppendDoubleFieldRecord(const std::vector<uint32_t>& path, WBSJournalField field, double value) {
+    WBSJournalRecordWriter writer(g_projectJournal.pending);
+    writer.Begin(WBSJournalOp::SetField, static_cast<uint8_t>(field), path);
+    writer.PutDouble(value);
+    writer.End();
+}
+
+/**
+ * @brief 列挙型フィールド（状態・優先度）の変更を記録
+ */
+void AppendEnumFieldRecord(const std::vector<uint32_t>& path, WBSJournalField field, int value) {
+    WBSJournalRecordWriter writer(g_projectJournal.pending);
+    writer.Begin(WBSJournalOp::SetField, static_cast<uint8_t>(field), path);
+    writer.PutI32(value);
+    writer.End();
+}
+
+/**
+ * @brief 日時フィールドの変更を記録
+ */
+void AppendDateFieldRecord(const std::vector<uint32_t>& path, WBSJournalField field, WBSDateTime value) {
+    WBSJournalRecordWriter writer(g_projectJournal.pending);
+    writer.Begin(WBSJournalOp::SetField, static_cast<uint8_t>(field), path);
+    writer.PutU64(PackDateTime(value));
+    writer.End();
+}
+
+/**
+ * @brief タスク編集の差分を記録
+ *
+ * @param before 編集前のタスクの値（コピー）
+ * @param after 編集後のタスク（ツリー内の実体）
+ *
+ * 値が変わったフィールドだけをレコードにします。
+ */
+void JournalRecordEdits(const WBSItem& before, const WBSItem& after) {
+    std::vector<uint32_t> path;
+    if (!BeginJournalRecord(after, path)) {
+        return;
+    }
+
+    if (before.id != after.id) AppendTextFieldRecord(path, WBSJournalField::Id, after.id.ToString());
+    if (before.taskName != after.taskName) AppendTextFieldRecord(path, WBSJournalField::TaskName, after.taskName);
+    if (before.description != after.description) AppendTextFieldRecord(path, WBSJournalField::Description, after.description.str());
+    if (before.assignedTo != after.assignedTo) AppendTextFieldRecord(path, WBSJournalField::AssignedTo, after.assignedTo.str());
+    if (before.status != after.status) AppendEnumFieldRecord(path, WBSJournalField::Status, static_cast<int>(after.status));
+    if (before.priority != after.priority) AppendEnumFieldRecord(path, WBSJournalField::Priority, static_cast<int>(after.priority));
+    if (before.estimatedHours != after.estimatedHours) AppendDoubleFieldRecord(path, WBSJournalField::EstimatedHours, after.estimatedHours);
+    if (before.actualHours != after.actualHours) AppendDoubleFieldRecord(path, WBSJournalField::ActualHours, after.actualHours);
+    if (before.startDate != after.startDate) AppendDateFieldRecord(path, WBSJournalField::StartDate, after.startDate);
+    if (before.endDate != after.endDate) AppendDateFieldRecord(path, WBSJournalField::EndDate, after.endDate);
+}
+
+/**
+ * @brief タスクの挿入を記録（ツリーへ追加した直後に呼び出す）
+ *
+ * @param item 挿入したタスク（子タスクを持たないこと）
+ */
+void JournalRecordInsert(const WBSItem& item) {
+    std::vector<uint32_t> path;
+    if (!BeginJournalRecord(item, path)) {
+        return;
+    }
+    if (path.empty() || !item.children.empty()) {
+        g_projectJournal.needsCompaction = true; // ルートの置き換えや部分木の挿入は全体保存
+        return;
+    }
+
+    WBSJournalRecordWriter writer(g_projectJournal.pending);
+    writer.Begin(WBSJournalOp::InsertTask, 0, path);
+    writer.PutText(item.id.ToString());
+    writer.PutText(item.taskName);
+    writer.PutText(item.description.str());
+    writer.PutText(item.assignedTo.str());
+    writer.PutI32(static_cast<int32_t>(item.status));
+    writer.PutI32(static_cast<int32_t>(item.priority));
+    writer.PutI32(item.level);
+    writer.PutDouble(item.estimatedHours);
+    writer.PutDouble(item.actualHours);
+    writer.PutU64(PackDateTime(item.startDate));
+    writer.PutU64(PackDateTime(item.endDate));
+    writer.End();
+}
+
+/**
+ * @brief タスクの削除を記録（ツリーから取り除く直前に呼び出す）
+ *
+ * @param item 削除するタスク（部分木ごと削除される）
+ */
+void JournalRecordDelete(const WBSItem& item) {
+    std::vector<uint32_t> path;
+    if (!BeginJournalRecord(item, path)) {
+        return;
+    }
+    if (path.empty()) {
+        g_projectJournal.needsCompaction = true;
+        return;
+    }
+
+    WBSJournalRecordWriter writer(g_projectJournal.pending);
+    writer.Begin(WBSJournalOp::DeleteTask, 0, path);
+    writer.End();
+}
+
+// ============================================================================
+// 再生
+// ============================================================================
+
+/**
+ * @brief パスの先頭 depth 個を辿ってタスクを取得
+ * @return 見つからない場合はnullptr
+ *
+ * 途中のタスクの子が遅延読み込みのままなら、その階層だけを構築します。
+ */
+std::shared_ptr<WBSItem> ResolveTaskPath(const WBSProject& project, const WBSJournalRecordReader& record, uint16_t depth) {
+    std::shared_ptr<WBSItem> item = project.rootTask;
+    for (uint16_t i = 0; i < depth && item; ++i) {
+        uint32_t index = record.PathAt(i);
+        if (!item->LoadDeferredChildren()) {
+            return nullptr;
+        }
+        item = index < item->children.size() ? item->children[index] : nullptr;
+    }
+    return item;
+}
+
+/**
+ * @brief 状態・優先度の値が列挙型の範囲内か判定（他の形式の読み込みと同じ範囲）
+ */
+bool IsValidJournalStatus(int32_t value) {
+    return value >= static_cast<int32_t>(TaskStatus::NOT_STARTED) && value <= static_cast<int32_t>(TaskStatus::CANCELLED);
+}
+
+bool IsValidJournalPriority(int32_t value) {
+    return value >= static_cast<int32_t>(TaskPriority::LOW) && value <= static_cast<int32_t>(TaskPriority::URGENT);
+}
+
+/**
+ * @brief SetField レコードを適用
+ */
+bool ApplyFieldRecord(WBSProject& project, WBSItem& item, WBSJournalRecordReader& record) {
+    WBSJournalField field = static_cast<WBSJournalField>(record.Field());
+    switch (field) {
+        case WBSJournalField::Id: {
+            std::string id;
+            if (!record.GetText(id)) return false;
+            project.SetTaskId(item, WBSTaskId(id)); // IDの索引も更新
+            return true;
+        }
+        case WBSJournalField::TaskName:
+            return record.GetText(item.taskName);
+        case WBSJournalField::Description: {
+            std::string description;
+            if (!record.GetText(description)) return false;
+            item.description = description;
+            return true;
+        }
+        case WBSJournalField::AssignedTo: {
+            std::string assignedTo;
+            if (!record.GetText(assignedTo)) return false;
+            item.assignedTo = assignedTo;
+            return true;
+        }
+        case WBSJournalField::EstimatedHours:
+        case WBSJournalField::ActualHours: {
+            double hours;
+            if (!record.GetDouble(hours)) return false;
+            if (field == WBSJournalField::EstimatedHours) {
+                item.SetEstimatedHours(hours);
+            } else {
+                item.SetActualHours(hours);
+            }
+            return true;
+        }
+        case WBSJournalField::Status:
+        case WBSJournalField::Priority: {
+            int32_t value;
+            if (!record.GetI32(value)) return false;
+            if (field == WBSJournalField::Status ? !IsValidJournalStatus(value) : !IsValidJournalPriority(value)) {
+                return false; // 範囲外の値（破損したジャーナル）
+            }
+            if (field == WBSJournalField::Status) {
+                item.SetStatus(static_cast<TaskStatus>(value));
+            } else {
+                item.priority = static_cast<TaskPriority>(value);
+            }
+            return true;
+        }
+        case WBSJournalField::StartDate:
+        case WBSJournalField::EndDate: {
+            uint64_t packed;
+            if (!record.GetU64(packed)) return false;
+            (field == WBSJournalField::StartDate ? item.startDate : item.endDate) = UnpackDateTime(packed);
+            return true;
+        }
+        default:
+            return false; // 未知のフィールド
+    }
+}
+
+/**
+ * @brief InsertTask レコードを適用
+ */
+bool ApplyInsertRecord(WBSProject& project, WBSJournalRecordReader& record) {
+    uint16_t depth = record.Depth();
+    if (depth == 0) {
+        return false;
+    }
+    std::shared_ptr<WBSItem> parent = ResolveTaskPath(project, record, depth - 1);
+    uint32_t index = record.PathAt(depth - 1);
+    if (!parent || !parent->LoadDeferredChildren() || index > parent->children.size()) {
+        return false;
+    }
+
+    auto item = WBSItem::Create(project.arena);
+    std::string id;
+    std::string description;
+    std::string assignedTo;
+    int32_t status, priority, level;
+    uint64_t startDate, endDate;
+    if (!record.GetText(id) || !record.GetText(item->taskName) ||
+        !record.GetText(description) || !record.GetText(assignedTo) ||
+        !record.GetI32(status) || !record.GetI32(priority) || !record.GetI32(level) ||
+        !record.GetDouble(item->estimatedHours) || !record.GetDouble(item->actualHours) ||
+        !record.GetU64(startDate) || !record.GetU64(endDate) ||
+        !IsValidJournalStatus(status) || !IsValidJournalPriority(priority)) {
+        return false;
+    }
+    item->id.Assign(id);
+    item->description = description;
+    item->assignedTo = assignedTo;
+    item->status = static_cast<TaskStatus>(status);
+    item->priority = static_cast<TaskPriority>(priority);
+    item->level = level;
+    item->startDate = UnpackDateTime(startDate);
+    item->endDate = UnpackDateTime(endDate);
+    project.InsertTask(*parent, index, item);
+    return true;
+}
+
+/**
+ * @brief DeleteTask レコードを適用
+ */
+bool ApplyDeleteRecord(WBSProject& project, WBSJournalRecordReader& record) {
+    uint16_t depth = record.Depth();
+    if (depth == 0) {
+        return false;
+    }
+    std::shared_ptr<WBSItem> parent = ResolveTaskPath(project, record, depth - 1);
+    uint32_t index = record.PathAt(depth - 1);
+    if (!parent || !parent->LoadDeferredChildren() || index >= parent->children.size()) {
+        return false;
+    }
+    project.RemoveTask(*parent, index);
+    return true;
+}
+
+/**
+ * @brief スナップショットにジャーナルを適用し、対応付けの状態を求める
+ *
+ * @param projectPath 読み込んだスナップショットのパス
+ * @param project 読み込んだプロジェクト（ジャーナルの内容で更新される）
+ * @param state 対応付けの状態の格納先
+ *
+ * @details 処理フロー:
+ * 1. ジャーナルがなければ対応付けのみ行う（次回の保存は全体保存）
+ * 2. ヘッダーのサイズ・ハッシュをスナップショットと照合（不一致なら無視）
+ * 3. レコードを先頭から順に適用（破損したレコードで停止）
+ *
+ * 最後まで正常に適用できた場合のみ state.needsCompaction がfalseになります。
+ */
+void ReplayJournal(const std::wstring& projectPath, WBSProject& project, ProjectJournalState& state) {
+    state = ProjectJournalState();
+    state.projectPath = projectPath;
+    state.needsCompaction = true;
+
+    WBSMappedFile journal(GetJournalFilePath(projectPath));
+    if (!journal.IsOpen() || journal.Size() < sizeof(WBSJournalHeader)) {
+        return; // ジャーナルなし
+    }
+
+    WBSJournalHeader header;
+    memcpy(&header, journal.Data(), sizeof(header));
+    if (memcmp(header.magic, kWBSJournalMagic, sizeof(kWBSJournalMagic)) != 0 ||
+        header.version != kWBSJournalVersion || header.headerSize != sizeof(WBSJournalHeader)) {
+        return;
+    }
+
+    // スナップショットとの照合（サイズ → ハッシュの順に確認）
+    WBSMappedFile snapshot(projectPath);
+    if (!snapshot.IsOpen() || snapshot.Size() != header.snapshotSize ||
+        UpdateJournalHash(kWBSJournalHashSeed, snapshot.Data(), snapshot.Size()) != header.snapshotHash) {
+        return; // 別の保存内容に対するジャーナル
+    }
+
+    // レコードの再生
+    WBSJournalRecordReader record(journal.Data() + sizeof(WBSJournalHeader), journal.Data() + journal.Size());
+    bool applied = true;
+    while (applied && record.Next()) {
+        switch (record.Op()) {
+            case WBSJournalOp::SetField: {
+                std::shared_ptr<WBSItem> item = ResolveTaskPath(project, record, record.Depth());
+                applied = item && ApplyFieldRecord(project, *item, record);
+                if (applied) {
+                    item->InvalidateHash();
+                }
+                break;
+            }
+            case WBSJournalOp::InsertTask:
+                applied = ApplyInsertRecord(project, record);
+                break;
+            case WBSJournalOp::DeleteTask:
+                applied = ApplyDeleteRecord(project, record);
+                break;
+            default:
+                applied = false;
+                break;
+        }
+    }
+
+    // ジャーナルの内容と完全に一致する場合のみ追記を継続
+    size_t validSize = record.Position() - journal.Data();
+    state.snapshotSize = header.snapshotSize;
+    state.journalSize = journal.Size();
+    state.needsCompaction = !applied || validSize != journal.Size();
+}
+
+/**
+ * @brief 読み込んだスナップショットにジャーナルを適用し、以後の保存先として対応付ける
+ *
+ * @param projectPath 読み込んだスナップショットのパス
+ * @param project 読み込んだプロジェクト（ジャーナルの内容で更新される）
+ *
+ * 最後まで正常に適用できた場合のみ、以後の保存はジャーナルへの追記になります。
+ */
+void ApplyProjectJournal(const std::wstring& projectPath, WBSProject& project) {
+    ReplayJournal(projectPath, project, g_projectJournal);
+}
+
+/**
+ * @brief 読み込んだスナップショットにジャーナルを適用（対応付けは変更しない）
+ *
+ * @param projectPath 読み込んだスナップショットのパス
+ * @param project 読み込んだプロジェクト（ジャーナルの内容で更新される）
+ *
+ * マージの入力など、現在のプロジェクトとは別に読み込むファイルに使用します。
+ */
+void ReplayProjectJournal(const std::wstring& projectPath, WBSProject& project) {
+    ProjectJournalState state;
+    ReplayJournal(projectPath, project, state);
+}
+
+// ============================================================================
+// 保存
+// ============================================================================
+
+/**
+ * @brief 保存を開始し、書き込みに必要な内容をジョブへ取り込む（UIスレッド）
+ *
+ * @param project 保存対象のプロジェクト
+ * @param filePath 保存先のパス
+ * @param copySnapshot 全体保存の場合にプロジェクトを複製するか
+ *                     （falseの場合、RunProjectSave() が終わるまで project を変更しないこと）
+ * @return 保存ジョブ（RunProjectSave() → FinishProjectSave() の順に渡す）
+ *
+ * @details 次の条件をすべて満たす場合は未保存のレコードを取り込むだけです（追記）:
+ * - 前回の読み込み・保存と同じパスへの保存
+ * - 記録漏れ・ジャーナルの破損がない
+ * - 追記後のジャーナルがスナップショットの1/4（最低64KB）を超えない
+ *
+ * それ以外の場合はスナップショット全体を書き直し、ジャーナルを空にします（圧縮）。
+ * ジャーナルの状態は取り込んだ時点の内容を基準に更新されるため、
+ * この関数から戻った後の編集は次回の保存で記録されます。
+ *
+ * 全体保存の前には遅延読み込みのタスクをすべて構築します（読み込み元のファイルの
+ * マップが解放され、同じファイルへ書き込めるようになります）。構築できない場合は
+ * ジャーナルの状態を変えずに std::runtime_error を送出します。
+ *
+ * @note 全体保存でこのスレッドに残る処理は、未構築のタスクの構築と
+ *       WBSProject::Snapshot() による木の複製（説明のテキストは共有）で、
+ *       いずれもタスク数に比例します。構築済みの27万タスクでは複製が約0.1秒です
+ *       （変換・圧縮・書き込みはワーカースレッドで行う）。
+ */
+std::unique_ptr<WBSSaveJob> BeginProjectSave(const WBSProject& project, const std::wstring& filePath, bool copySnapshot) {
+    ProjectJournalState& state = g_projectJournal;
+    uint64_t limit = std::max<uint64_t>(kJournalMinCompactionBytes, state.snapshotSize / 4);
+
+    auto job = std::make_unique<WBSSaveJob>();
+    job->filePath = filePath;
+
+    if (state.projectPath != filePath || state.needsCompaction ||
+        state.journalSize + state.pending.size() > limit) {
+        // 全体保存: 以後の編集は新しいスナップショットに対して記録する
+        if (project.rootTask && !project.rootTask->LoadDeferredSubtree()) {
+            throw std::runtime_error("deferred tasks could not be loaded");
+        }
+        if (copySnapshot) {
+            job->ownedSnapshot = project.Snapshot();
+            job->snapshot = job->ownedSnapshot.get();
+        } else {
+            job->snapshot = &project;
+        }
+        JournalDetach();
+        state.projectPath = filePath;
+        state.journalSize = sizeof(WBSJournalHeader);
+    } else {
+        job->journalRecords.swap(state.pending);
+    }
+    return job;
+}
+
+/**
+ * @brief スナップショット全体を保存し、空のジャーナルを作成
+ * @param job 保存ジョブ（結果が設定される）
+ */
+void WriteSnapshotJob(WBSSaveJob& job) {
+    uint64_t snapshotHash;
+    {
+        WBSFileSink file(job.filePath);
+        if (!file.IsOpen()) {
+            return;
+        }
+        WBSHashingSink hashing(file);
+        // ハッシュは圧縮後のバイト列（ファイルの内容）に対して計算する
+        char delimiter = GetTaskTableDelimiter(job.filePath);
+        bool written = IsBinaryProjectPath(job.filePath) ? WriteProjectBinary(*job.snapshot, hashing)
+            : IsCompressedProjectPath(job.filePath) ? WriteProjectCompressedXml(*job.snapshot, hashing, kWBSCompressionDefaultLevel)
+            : IsJsonProjectPath(job.filePath) ? WriteProjectJson(*job.snapshot, hashing)
+            : delimiter ? WriteProjectTaskTable(*job.snapshot, hashing, delimiter)
+            : WriteProjectXml(*job.snapshot, hashing);
+        if (!file.Close() || !written) {
+            return;
+        }
+        job.snapshotSize = hashing.Size();
+        snapshotHash = hashing.Hash();
+    }
+    job.succeeded = true;
+
+    // 新しいスナップショットに対応する空のジャーナル
+    WBSJournalHeader header = {};
+    memcpy(header.magic, kWBSJournalMagic, sizeof(header.magic));
+    header.version = kWBSJournalVersion;
+    header.headerSize = sizeof(WBSJournalHeader);
+    header.snapshotSize = job.snapshotSize;
+    header.snapshotHash = snapshotHash;
+
+    WBSFileSink journal(GetJournalFilePath(job.filePath));
+    job.journalCreated = journal.IsOpen() &&
+                         journal.Write(reinterpret_cast<const char*>(&header), sizeof(header)) &&
+                         journal.Close();
+}
+
+/**
+ * @brief 未保存のレコードをジャーナルへ追記
+ * @param job 保存ジョブ（結果が設定される）
+ */
+void WriteJournalJob(WBSSaveJob& job) {
+    if (job.journalRecords.empty()) {
+        job.succeeded = true; // 変更なし
+        return;
+    }
+
+    WBSFileSink journal(GetJournalFilePath(job.filePath), true);
+    bool written = journal.IsOpen() && journal.Write(job.journalRecords.data(), job.journalRecords.size());
+    job.succeeded = journal.Close() && written;
+}
+
+/**
+ * @brief ジョブの内容をファイルへ書き込む（任意のスレッド）
+ *
+ * @param job BeginProjectSave() が作成したジョブ（結果が設定される）
+ *
+ * ジョブ以外の状態には触れないため、ワーカースレッドから呼び出せます。
+ */
+void RunProjectSave(WBSSaveJob& job) {
+    try {
+        if (job.snapshot) {
+            WriteSnapshotJob(job);
+        } else {
+            WriteJournalJob(job);
+        }
+    } catch (...) {
+        job.succeeded = false; // メモリ不足等
+    }
+}
+
+/**
+ * @brief 書き込み結果をジャーナルの状態へ反映する（UIスレッド）
+ *
+ * @param job RunProjectSave() を終えたジョブ
+ * @return 保存に成功した場合true
+ *
+ * 失敗した場合はファイルが途中まで書かれた可能性があるため、次回の保存を全体保存にします。
+ */
+bool FinishProjectSave(const WBSSaveJob& job) {
+    ProjectJournalState& state = g_projectJournal;
+    if (state.projectPath != job.filePath) {
+        return job.succeeded; // 保存中に対応付けが解除された（新規作成等）
+    }
+    if (!job.succeeded) {
+        state.needsCompaction = true;
+        return false;
+    }
+
+    if (job.snapshot) {
+        state.snapshotSize = job.snapshotSize;
+        if (!job.journalCreated) {
+            // スナップショットは保存済み（ジャーナルは次回の全体保存で作り直す）
+            state.needsCompaction = true;
+        }
+    } else {
+        state.journalSize += job.journalRecords.size();
+    }
+    return true;
+}
+
+/**
+ * @brief プロジェクトを保存（可能な場合はジャーナルへの追記のみ）
+ *
+ * @param project 保存対象のプロジェクト
+ * @param filePath 保存先のパス
+ * @return 保存に成功した場合true
+ *
+ * BeginProjectSave() → RunProjectSave() → FinishProjectSave() を呼び出し元の
+ * スレッドで実行します（プロジェクトは複製しません）。
+ * 追記に失敗した場合はスナップショット全体を書き直して回復します。
+ */
+bool SaveProjectWithJournal(const WBSProject& project, const std::wstring& filePath) {
+    try {
+        std::unique_ptr<WBSSaveJob> job = BeginProjectSave(project, filePath, false);
+        RunProjectSave(*job);
+        if (FinishProjectSave(*job) || job->snapshot) {
+            return job->succeeded;
+        }
+
+        // 途中まで書かれた可能性があるため全体保存で回復
+        job = BeginProjectSave(project, filePath, false);
+        RunProjectSave(*job);
+        return FinishProjectSave(*job);
+    } catch (...) {
+        return false; // 遅延読み込みのタスクを構築できない等
+    }
+}
+
+// ============================================================================
+// バックグラウンド保存
+// ============================================================================
+
+/**
+ * @brief バックグラウンド保存の状態（UIスレッドのみが操作）
+ */
+struct BackgroundSaveState {
+    std::thread worker;                 ///< 書き込み中のワーカースレッド
+    std::unique_ptr<WBSSaveJob> job;    ///< 書き込み中のジョブ（なければnullptr）
+    HWND notifyWindow = nullptr;        ///< 完了通知先
+    uint32_t sequence = 0;              ///< 最後に開始したジョブの通し番号（完了通知の wParam）
+    bool requested = false;             ///< 書き込み中に次の保存が要求された
+    std::wstring requestedPath;         ///< 次の保存先（最後に要求されたパス）
+};
+
+BackgroundSaveState g_backgroundSave;
+
+/**
+ * @brief プロジェクトを取り込み、ワーカースレッドで書き込みを開始
+ */
+void LaunchBackgroundSave(const WBSProject& project, const std::wstring& filePath) {
+    BackgroundSaveState& state = g_backgroundSave;
+    state.job = BeginProjectSave(project, filePath, true);
+
+    WBSSaveJob* job = state.job.get();
+    HWND notifyWindow = state.notifyWindow;
+    WPARAM sequence = ++state.sequence;
+    try {
+        state.worker = std::thread([job, notifyWindow, sequence]() {
+            RunProjectSave(*job);
+            PostMessage(notifyWindow, WM_WBS_SAVE_COMPLETED, sequence, 0);
+        });
+    } catch (...) {
+        // スレッドを作成できない場合はこのスレッドで書き込む
+        RunProjectSave(*job);
+        PostMessage(notifyWindow, WM_WBS_SAVE_COMPLETED, sequence, 0);
+    }
+}
+
+/**
+ * @brief 書き込みを終えたジョブを回収して結果を反映
+ * @return 保存に成功した場合true
+ */
+bool CollectBackgroundSave() {
+    BackgroundSaveState& state = g_backgroundSave;
+    if (state.worker.joinable()) {
+        state.worker.join();
+    }
+    std::unique_ptr<WBSSaveJob> job = std::move(state.job);
+    bool saved = FinishProjectSave(*job);
+
+    if (!saved && !job->snapshot && !state.requested) {
+        // 追記に失敗: 次の保存（全体保存）で回復
+        state.requested = true;
+        state.requestedPath = job->filePath;
+    }
+    return saved;
+}
+
+/**
+ * @brief バックグラウンド保存を要求（UIスレッド）
+ *
+ * @param project 保存対象のプロジェクト（この時点の内容が保存される）
+ * @param filePath 保存先のパス
+ * @param notifyWindow 完了時に WM_WBS_SAVE_COMPLETED を受け取るウィンドウ
+ *
+ * プロジェクトの取り込み（複製または未保存レコードの移動）だけをこのスレッドで行い、
+ * 変換と書き込みはワーカースレッドで行います。戻った直後から編集を続けられます。
+ *
+ * 書き込み中に呼び出された場合は待ち行列に積まず、書き込みが終わった時点の内容で
+ * 1回だけ保存し直します（何度要求されても次の保存は1回にまとめられます）。
+ */
+void RequestBackgroundSave(const WBSProject& project, const std::wstring& filePath, HWND notifyWindow) {
+    BackgroundSaveState& state = g_backgroundSave;
+    state.notifyWindow = notifyWindow;
+    if (state.job) {
+        state.requested = true;
+        state.requestedPath = filePath;
+        return;
+    }
+    LaunchBackgroundSave(project, filePath);
+}
+
+/**
+ * @brief バックグラウンド保存の完了処理（WM_WBS_SAVE_COMPLETED の受信時、UIスレッド）
+ *
+ * @param project 現在のプロジェクト（まとめられた次の保存に使用）
+ * @param sequence 通知の wParam（完了したジョブの通し番号）
+ * @param savedPath 保存したパスの格納先
+ * @return 保存の結果。次の保存を開始した場合や通知が古い場合は WBSSaveStatus::Pending
+ *
+ * 書き込み中に次の保存が要求されていた場合は、現在の内容で続けて保存を開始し、
+ * 結果はその保存の完了時に通知します。
+ */
+WBSSaveStatus CompleteBackgroundSave(const WBSProject* project, WPARAM sequence, std::wstring& savedPath) {
+    BackgroundSaveState& state = g_backgroundSave;
+    if (!state.job || sequence != static_cast<WPARAM>(state.sequence)) {
+        // WaitForBackgroundSave() で回収済みのジョブの通知（実行中の別のジョブは待たない）
+        return WBSSaveStatus::Pending;
+    }
+
+    savedPath = state.job->filePath;
+    bool saved = CollectBackgroundSave();
+
+    if (state.requested && project) {
+        state.requested = false;
+        LaunchBackgroundSave(*project, state.requestedPath);
+        return WBSSaveStatus::Pending;
+    }
+    state.requested = false;
+    return saved ? WBSSaveStatus::Succeeded : WBSSaveStatus::Failed;
+}
+
+/**
+ * @brief 書き込み中・要求中のバックグラウンド保存をすべて完了させる（UIスレッド）
+ *
+ * @param project 現在のプロジェクト（まとめられた次の保存に使用、nullptrなら破棄）
+ * @return 最後の保存が成功した場合（保存がなかった場合を含む）true
+ *
+ * アプリケーションの終了、新規作成、プロジェクトを開く前に呼び出し、
+ * 書き込み途中のファイルやジャーナルの状態の食い違いが残らないようにします。
+ * まとめられた次の保存はこのスレッドで同期的に実行します。
+ */
+bool WaitForBackgroundSave(const WBSProject* project) {
+    BackgroundSaveState& state = g_backgroundSave;
+    bool saved = true;
+    if (state.job) {
+        saved = CollectBackgroundSave();
+    }
+    if (state.requested && project) {
+        saved = SaveProjectWithJournal(*project, state.requestedPath);
+    }
+    state.requested = false;
+    return saved;
+}
@@ -0,0 +1,1110 @@
+/*
+ * ============================================================================
+ * WBS_Merge_Functions.cpp - 差分・3方向マージ処理モジュール
+ * ============================================================================
+ *
+ * このモジュールは、同じプロジェクトファイルの複製をそれぞれ編集した結果を
+ * 比較・統合する機能を提供します。結果の型は WBSProjectDiff.h で定義されています。
+ *
+ * 【主な機能】
+ * - 差分: 2つのプロジェクトのタスクを対応付け、フィールド変更・移動・挿入・削除を列挙
+ * - 3方向マージ: 共通の元プロジェクトからの双方の変更を1つのプロジェクトに統合
+ * - 競合の明示: 自動で決められない変更は現在の値を残し、タスクに印を付ける
+ * - UI: 現在のプロジェクトに、元ファイルと取り込むファイルを指定してマージ
+ *
+ * 【処理方式】
+ * - ツリーを行きがけ順の配列に平坦化し、以降は索引だけで処理する
+ * - 対応したタスクの子どうしを id で揃え、残ったタスクだけを id・内容ハッシュの索引で対応付ける
+ * - 部分木ハッシュが一致する部分木は、子孫を位置でまとめて対応付ける
+ * - 兄弟間の順序の変更は最長増加部分列で最小の移動として検出する
+ * 処理量はタスク数にほぼ比例します（総当たり比較は行いません）。
+ *
+ * 【マージの規則】
+ * - フィールド: 一方だけが変更した値を採用。両方が異なる値に変更した場合は競合
+ * - 削除: 他方が変更していなければ削除。変更されていれば競合として残す
+ *   （子孫が残る場合も、親は削除を取り消して競合とする）
+ * - 移動: 一方だけが移動した位置を採用。両方が異なる親へ移動した場合は競合
+ * - 順序: 現在のプロジェクトが兄弟の並びを変えていなければ取り込む側の並びを採用。
+ *   挿入・移動されたタスクは、元の側で直前にあった兄弟の後ろに置く
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#include <windows.h>   // Windows基本API
+#include <commdlg.h>   // コモンダイアログAPI（ファイル選択）
+#include <memory>      // スマートポインタ（メモリ安全性）
+#include <vector>      // 動的配列（平坦化したツリー・対応表）
+#include <string>      // 文字列クラス（テキスト処理）
+#include <unordered_map> // id・内容ハッシュの索引
+#include <algorithm>   // std::upper_bound（最長増加部分列）
+
+#include "WBS_cpp_win32/WBSClasses.h"       // WBSクラス定義
+#include "WBS_cpp_win32/WBSProjectDiff.h"   // 差分・マージの結果型
+#include "WBS_cpp_win32/WBSFieldCodec.h"    // 工数・日時の文字列変換
+#include "WBS_cpp_win32/WBSUtf8.h"          // UTF-8とUTF-16の変換（画面表示用）
+
+// ============================================================================
+// 外部依存関係 - メインアプリケーション・他の処理モジュールとの連携
+// ============================================================================
+
+extern std::unique_ptr<WBSProject> g_currentProject;   // 現在のプロジェクトインスタンス
+extern HWND g_hMainDialog;                             // メインダイアログ
+extern void RefreshTreeView();                         // UI更新：ツリービューの再描画
+extern void RefreshListView();                         // UI更新：詳細ビューの再描画
+
+// XML処理モジュール（WBS_XML_Functions.cpp）
+bool ReadProjectFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project, int lazyDepth);
+
+// 編集ジャーナル処理モジュール（WBS_Journal_Functions.cpp）
+void ReplayProjectJournal(const std::wstring& projectPath, WBSProject& project);
+void JournalDetach();
+bool WaitForBackgroundSave(const WBSProject* project);
+
+// ============================================================================
+// ツリーの平坦化と索引
+// ============================================================================
+
+/**
+ * @brief 平坦化したツリーのタスク1件
+ *
+ * 配列は行きがけ順で、部分木は [自身の索引, subtreeEnd) の連続範囲です。
+ */
+struct DiffTaskNode {
+    const WBSItem* item;    ///< タスク
+    int32_t parent;         ///< 親の索引（ルートは-1）
+    uint32_t subtreeEnd;    ///< 部分木の終端（次の兄弟の索引）
+};
+
+/**
+ * @brief ツリーを行きがけ順の配列に平坦化
+ *
+ * @param root ルートタスク
+ * @param nodes 平坦化したタスクの格納先
+ * @return 遅延読み込みの子タスクが残っていない場合true
+ */
+bool FlattenTaskTree(const WBSItem& root, std::vector<DiffTaskNode>& nodes) {
+    nodes.clear();
+    if (root.HasDeferredChildren()) {
+        return false;
+    }
+    nodes.push_back({ &root, -1, 0 });
+
+    std::vector<std::pair<uint32_t, size_t>> stack; // (索引, 次に辿る子の位置)
+    stack.push_back(std::make_pair(0u, size_t(0)));
+    while (!stack.empty()) {
+        uint32_t index = stack.back().first;
+        const WBSItem* item = nodes[index].item;
+        if (stack.back().second < item->children.size()) {
+            const WBSItem* child = item->children[stack.back().second++].get();
+            if (!child) {
+                continue;
+            }
+            if (child->HasDeferredChildren()) {
+                return false;
+            }
+            nodes.push_back({ child, static_cast<int32_t>(index), 0 });
+            stack.push_back(std::make_pair(static_cast<uint32_t>(nodes.size() - 1), size_t(0)));
+        } else {
+            nodes[index].subtreeEnd = static_cast<uint32_t>(nodes.size());
+            stack.pop_back();
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 兄弟の中での位置を求める
+ */
+void GetSiblingPositions(const std::vector<DiffTaskNode>& nodes, std::vector<uint32_t>& positions) {
+    positions.assign(nodes.size(), 0);
+    for (uint32_t parent = 0; parent < nodes.size(); ++parent) {
+        uint32_t position = 0;
+        for (uint32_t child = parent + 1; child < nodes[parent].subtreeEnd; child = nodes[child].subtreeEnd) {
+            positions[child] = position++;
+        }
+    }
+}
+
+/**
+ * @brief 直前の兄弟の索引を求める（先頭の子は-1）
+ */
+void GetPreviousSiblings(const std::vector<DiffTaskNode>& nodes, std::vector<int32_t>& previous) {
+    previous.assign(nodes.size(), -1);
+    for (uint32_t parent = 0; parent < nodes.size(); ++parent) {
+        int32_t last = -1;
+        for (uint32_t child = parent + 1; child < nodes[parent].subtreeEnd; child = nodes[child].subtreeEnd) {
+            previous[child] = last;
+            last = static_cast<int32_t>(child);
+        }
+    }
+}
+
+/**
+ * @brief タスクIDの索引（IDをコピーせず、タスクのメンバを指す）
+ */
+struct TaskIdHash {
+    size_t operator()(const WBSTaskId* id) const {
+        return static_cast<size_t>(id->Hash());
+    }
+};
+
+struct TaskIdEqual {
+    bool operator()(const WBSTaskId* a, const WBSTaskId* b) const {
+        return *a == *b;
+    }
+};
+
+typedef std::unordered_map<const WBSTaskId*, int32_t, TaskIdHash, TaskIdEqual> TaskIdIndex;
+
+// ============================================================================
+// フィールドの比較
+// ============================================================================
+
+/**
+ * @brief 値が異なるフィールドを求める
+ * @return kWBSDiffFieldXxx の組み合わせ（階層レベル・子タスクは比較しない）
+ */
+uint32_t CompareTaskFields(const WBSItem& a, const WBSItem& b) {
+    uint32_t fields = 0;
+    if (a.id != b.id) fields |= kWBSDiffFieldId;
+    if (a.taskName != b.taskName) fields |= kWBSDiffFieldTaskName;
+    if (a.description != b.description) fields |= kWBSDiffFieldDescription;
+    if (a.assignedTo != b.assignedTo) fields |= kWBSDiffFieldAssignedTo;
+    if (a.status != b.status) fields |= kWBSDiffFieldStatus;
+    if (a.priority != b.priority) fields |= kWBSDiffFieldPriority;
+    if (a.estimatedHours != b.estimatedHours) fields |= kWBSDiffFieldEstimatedHours;
+    if (a.actualHours != b.actualHours) fields |= kWBSDiffFieldActualHours;
+    if (a.startDate != b.startDate) fields |= kWBSDiffFieldStartDate;
+    if (a.endDate != b.endDate) fields |= kWBSDiffFieldEndDate;
+    return fields;
+}
+
+/**
+ * @brief 指定したフィールドの値をコピー
+ * @param fields kWBSDiffFieldXxx の組み合わせ
+ */
+void CopyTaskFields(WBSItem& dst, const WBSItem& src, uint32_t fields) {
+    if (fields & kWBSDiffFieldId) dst.id = src.id;
+    if (fields & kWBSDiffFieldTaskName) dst.taskName = src.taskName;
+    if (fields & kWBSDiffFieldDescription) dst.description = src.description;
+    if (fields & kWBSDiffFieldAssignedTo) dst.assignedTo = src.assignedTo;
+    if (fields & kWBSDiffFieldStatus) dst.status = src.status;
+    if (fields & kWBSDiffFieldPriority) dst.priority = src.priority;
+    if (fields & kWBSDiffFieldEstimatedHours) dst.estimatedHours = src.estimatedHours;
+    if (fields & kWBSDiffFieldActualHours) dst.actualHours = src.actualHours;
+    if (fields & kWBSDiffFieldStartDate) dst.startDate = src.startDate;
+    if (fields & kWBSDiffFieldEndDate) dst.endDate = src.endDate;
+}
+
+/**
+ * @brief id 以外のフィールドの内容ハッシュ（id が振り直されたタスクの対応付け用）
+ */
+uint64_t GetTaskContentHash(const WBSItem& item) {
+    uint64_t hash = UpdateWBSHash(kWBSHashSeed, item.taskName);
+    hash = UpdateWBSHash(hash, item.description.str()); // 符号化の違いに左右されないよう復元した内容で計算
+    hash = UpdateWBSHash(hash, item.assignedTo.Hash());
+    hash = UpdateWBSHash(hash, (static_cast<uint64_t>(item.status) << 32) | static_cast<uint32_t>(item.priority));
+    hash = UpdateWBSHash(hash, &item.estimatedHours, sizeof(item.estimatedHours));
+    hash = UpdateWBSHash(hash, &item.actualHours, sizeof(item.actualHours));
+    return UpdateWBSHash(hash, (static_cast<uint64_t>(item.startDate.Minutes()) << 32) | item.endDate.Minutes());
+}
+
+/**
+ * @brief フィールドの値を表示用の文字列に変換（競合の印に使用）
+ */
+std::string FormatTaskField(const WBSItem& item, uint32_t field) {
+    char buffer[kWBSFieldBufferSize];
+    size_t length = 0;
+    switch (field) {
+        case kWBSDiffFieldId: return item.id.ToString();
+        case kWBSDiffFieldTaskName: return item.taskName;
+        case kWBSDiffFieldDescription: return item.description.str();
+        case kWBSDiffFieldAssignedTo: return item.assignedTo.str();
+        case kWBSDiffFieldStatus: return WideToUtf8(item.GetStatusString());
+        case kWBSDiffFieldPriority: return WideToUtf8(item.GetPriorityString());
+        case kWBSDiffFieldEstimatedHours: length = FormatDoubleField(buffer, item.estimatedHours); break;
+        case kWBSDiffFieldActualHours: length = FormatDoubleField(buffer, item.actualHours); break;
+        case kWBSDiffFieldStartDate: length = FormatDateField(buffer, item.startDate); break;
+        case kWBSDiffFieldEndDate: length = FormatDateField(buffer, item.endDate); break;
+        default: break;
+    }
+    return std::string(buffer, length);
+}
+
+// ============================================================================
+// タスクの対応付け
+// ============================================================================
+
+/**
+ * @brief 比較元と比較先のタスクの対応表
+ */
+struct TaskMatching {
+    std::vector<int32_t> baseToOther;   ///< 比較元の索引 → 比較先の索引（なしは-1）
+    std::vector<int32_t> otherToBase;   ///< 比較先の索引 → 比較元の索引（なしは-1）
+    std::vector<uint8_t> sameSubtree;   ///< 比較先の索引ごと: 部分木ハッシュの一致で対応付けた（内容も同一）
+};
+
+/**
+ * @brief 対応付けを記録し、部分木ハッシュが一致すれば子孫を位置でまとめて対応付ける
+ */
+void LinkMatchedTasks(const std::vector<DiffTaskNode>& base, const std::vector<DiffTaskNode>& other,
+                      uint32_t b, uint32_t o, TaskMatching& matching) {
+    matching.baseToOther[b] = static_cast<int32_t>(o);
+    matching.otherToBase[o] = static_cast<int32_t>(b);
+
+    uint32_t size = other[o].subtreeEnd - o;
+    if (base[b].subtreeEnd - b != size ||
+        base[b].item->GetSubtreeHash() != other[o].item->GetSubtreeHash()) {
+        return;
+    }
+    matching.sameSubtree[o] = 1;
+    for (uint32_t k = 1; k < size; ++k) {
+        if (matching.baseToOther[b + k] < 0) {
+            matching.baseToOther[b + k] = static_cast<int32_t>(o + k);
+            matching.otherToBase[o + k] = static_cast<int32_t>(b + k);
+            matching.sameSubtree[o + k] = 1;
+        }
+    }
+}
+
+/**
+ * @brief 2つのツリーのタスクを対応付け
+ *
+ * @param base 比較元の平坦化したツリー
+ * @param other 比較先の平坦化したツリー
+ * @param matching 対応表の格納先
+ *
+ * @details 対応付けの順序:
+ * 1. ルートどうしを対応付け、対応したタスクの子どうしを並び順に id で揃える
+ *    （挿入・1件の削除による位置のずれは読み飛ばす）
+ * 2. 残ったタスクを、比較元の残ったタスクの id 索引で対応付ける（移動・並べ替え）
+ * 3. さらに残ったタスクのうち、id 以外のフィールドがすべて一致するもの
+ * 1・2で部分木ハッシュが一致した部分木は、子孫を位置でまとめて対応付けます。
+ * 変更のない部分は索引を作らずに対応付くため、処理量は主に変更の量で決まります。
+ */
+void MatchTaskTrees(const std::vector<DiffTaskNode>& base, const std::vector<DiffTaskNode>& other,
+                    TaskMatching& matching) {
+    matching.baseToOther.assign(base.size(), -1);
+    matching.otherToBase.assign(other.size(), -1);
+    matching.sameSubtree.assign(other.size(), 0);
+
+    // 1. ルートから順に、対応したタスクの子どうしを揃える
+    LinkMatchedTasks(base, other, 0, 0, matching);
+    for (uint32_t o = 0; o < other.size(); ++o) {
+        int32_t b = matching.otherToBase[o];
+        if (b < 0 || matching.sameSubtree[o]) {
+            continue; // 対応なし、または子孫も対応付け済み
+        }
+        uint32_t baseChild = b + 1;
+        uint32_t baseEnd = base[b].subtreeEnd;
+        for (uint32_t child = o + 1; child < other[o].subtreeEnd && baseChild < baseEnd; child = other[child].subtreeEnd) {
+            const WBSTaskId& id = other[child].item->id;
+            if (base[baseChild].item->id != id) {
+                uint32_t next = base[baseChild].subtreeEnd;
+                if (next < baseEnd && base[next].item->id == id) {
+                    baseChild = next; // 比較元の兄弟が1件削除されている
+                } else {
+                    continue;         // 比較先で挿入された（比較元の位置は進めない）
+                }
+            }
+            if (matching.baseToOther[baseChild] < 0) {
+                LinkMatchedTasks(base, other, baseChild, child, matching);
+            }
+            baseChild = base[baseChild].subtreeEnd;
+        }
+    }
+
+    // 2. 残ったタスクの id による対応付け
+    TaskIdIndex leftovers;
+    for (uint32_t b = 1; b < base.size(); ++b) {
+        if (matching.baseToOther[b] < 0) {
+            leftovers.emplace(&base[b].item->id, static_cast<int32_t>(b));
+        }
+    }
+    if (leftovers.empty()) {
+        return;
+    }
+    for (uint32_t o = 1; o < other.size(); ++o) {
+        if (matching.otherToBase[o] >= 0) {
+            continue;
+        }
+        auto found = leftovers.find(&other[o].item->id);
+        if (found != leftovers.end() && matching.baseToOther[found->second] < 0) {
+            LinkMatchedTasks(base, other, found->second, o, matching);
+        }
+    }
+
+    // 3. 内容による対応付け（残ったタスクだけを索引にする）
+    std::unordered_map<uint64_t, int32_t> contentHead;  // 内容ハッシュ → 最初の候補
+    std::vector<int32_t> contentNext;                    // 同じ内容ハッシュの次の候補
+    for (int32_t b = static_cast<int32_t>(base.size()) - 1; b > 0; --b) {
+        if (matching.baseToOther[b] >= 0) {
+            continue;
+        }
+        if (contentNext.empty()) {
+            contentNext.assign(base.size(), -1);
+        }
+        auto inserted = contentHead.emplace(GetTaskContentHash(*base[b].item), b);
+        if (!inserted.second) {
+            contentNext[b] = inserted.first->second; // 索引の小さい候補が先頭になるよう逆順に追加
+            inserted.first->second = b;
+        }
+    }
+    if (contentHead.empty()) {
+        return;
+    }
+    for (uint32_t o = 1; o < other.size(); ++o) {
+        if (matching.otherToBase[o] >= 0) {
+            continue;
+        }
+        auto found = contentHead.find(GetTaskContentHash(*other[o].item));
+        if (found == contentHead.end()) {
+            continue;
+        }
+        for (int32_t b = found->second; b >= 0; b = contentNext[b]) {
+            if (matching.baseToOther[b] < 0 &&
+                (CompareTaskFields(*base[b].item, *other[o].item) & ~kWBSDiffFieldId) == 0) {
+                matching.baseToOther[b] = static_cast<int32_t>(o);
+                matching.otherToBase[o] = b;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 最長増加部分列に含まれる要素に印を付ける
+ *
+ * @param values 値の列
+ * @param keep 最長増加部分列に含まれる要素をtrueにした格納先
+ */
+void MarkLongestIncreasingRun(const std::vector<uint32_t>& values, std::vector<uint8_t>& keep) {
+    keep.assign(values.size(), 0);
+    std::vector<uint32_t> tails;        // 長さ i+1 の増加部分列の末尾の値
+    std::vector<int32_t> tailIndex;     // その要素の位置
+    std::vector<int32_t> previous(values.size(), -1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        size_t length = std::upper_bound(tails.begin(), tails.end(), values[i]) - tails.begin();
+        if (length == tails.size()) {
+            tails.push_back(values[i]);
+            tailIndex.push_back(static_cast<int32_t>(i));
+        } else {
+            tails[length] = values[i];
+            tailIndex[length] = static_cast<int32_t>(i);
+        }
+        previous[i] = length > 0 ? tailIndex[length - 1] : -1;
+    }
+    for (int32_t i = tailIndex.empty() ? -1 : tailIndex.back(); i >= 0; i = previous[i]) {
+        keep[i] = 1;
+    }
+}
+
+/**
+ * @brief 移動したタスク（比較先の索引）に印を付ける
+ *
+ * 親が変わったタスクと、同じ親の下で順序が変わったタスクが対象です。
+ * 順序の変更は、元の順序を保つ最長の並びに含まれないタスクだけを移動とします。
+ */
+void FindMovedTasks(const std::vector<DiffTaskNode>& base, const std::vector<DiffTaskNode>& other,
+                    const TaskMatching& matching, std::vector<uint8_t>& moved) {
+    moved.assign(other.size(), 0);
+    for (uint32_t o = 1; o < other.size(); ++o) {
+        int32_t b = matching.otherToBase[o];
+        if (b >= 0 && matching.otherToBase[other[o].parent] != base[b].parent) {
+            moved[o] = 1;
+        }
+    }
+
+    std::vector<uint32_t> basePositions;
+    GetSiblingPositions(base, basePositions);
+    std::vector<uint32_t> sequence;
+    std::vector<uint32_t> members;
+    std::vector<uint8_t> keep;
+    for (uint32_t p = 0; p < other.size(); ++p) {
+        if (matching.otherToBase[p] < 0 || matching.sameSubtree[p]) {
+            continue;
+        }
+        sequence.clear();
+        members.clear();
+        for (uint32_t c = p + 1; c < other[p].subtreeEnd; c = other[c].subtreeEnd) {
+            if (matching.otherToBase[c] >= 0 && !moved[c]) {
+                sequence.push_back(basePositions[matching.otherToBase[c]]);
+                members.push_back(c);
+            }
+        }
+        MarkLongestIncreasingRun(sequence, keep);
+        for (size_t i = 0; i < members.size(); ++i) {
+            if (!keep[i]) {
+                moved[members[i]] = 1;
+            }
+        }
+    }
+}
+
+// ============================================================================
+// 差分
+// ============================================================================
+
+/**
+ * @brief 2つのプロジェクトの構造的な差分を求める
+ *
+ * @param base 比較元のプロジェクト
+ * @param other 比較先のプロジェクト
+ * @param diff 差分の格納先（ポインタは両プロジェクトのタスクを指す）
+ * @return 比較できた場合true（遅延読み込みの子タスクが残っている場合false）
+ *
+ * 内容ハッシュが一致する場合は走査せずに空の差分を返します。
+ */
+bool DiffProjects(const WBSProject& base, const WBSProject& other, WBSProjectDiff& diff) {
+    diff = WBSProjectDiff();
+    if (!base.rootTask || !other.rootTask) {
+        return false;
+    }
+    diff.projectNameChanged = base.projectName != other.projectName;
+    diff.descriptionChanged = base.description != other.description;
+    if (base.rootTask->GetSubtreeHash() == other.rootTask->GetSubtreeHash() &&
+        !base.rootTask->HasDeferredChildren() && !other.rootTask->HasDeferredChildren()) {
+        return true;
+    }
+
+    std::vector<DiffTaskNode> baseNodes;
+    std::vector<DiffTaskNode> otherNodes;
+    if (!FlattenTaskTree(*base.rootTask, baseNodes) || !FlattenTaskTree(*other.rootTask, otherNodes)) {
+        return false;
+    }
+    TaskMatching matching;
+    MatchTaskTrees(baseNodes, otherNodes, matching);
+    std::vector<uint8_t> moved;
+    FindMovedTasks(baseNodes, otherNodes, matching, moved);
+
+    for (uint32_t o = 0; o < otherNodes.size(); ++o) {
+        int32_t b = matching.otherToBase[o];
+        if (b < 0) {
+            diff.entries.push_back({ WBSDiffKind::Inserted, nullptr, otherNodes[o].item, 0 });
+            continue;
+        }
+        uint32_t fields = matching.sameSubtree[o] ? 0 : CompareTaskFields(*baseNodes[b].item, *otherNodes[o].item);
+        if (moved[o]) {
+            diff.entries.push_back({ WBSDiffKind::Moved, baseNodes[b].item, otherNodes[o].item, fields });
+        } else if (fields) {
+            diff.entries.push_back({ WBSDiffKind::Modified, baseNodes[b].item, otherNodes[o].item, fields });
+        }
+    }
+    for (uint32_t b = 0; b < baseNodes.size(); ++b) {
+        if (matching.baseToOther[b] < 0) {
+            diff.entries.push_back({ WBSDiffKind::Deleted, baseNodes[b].item, nullptr, 0 });
+        }
+    }
+    return true;
+}
+
+// ============================================================================
+// 3方向マージ
+// ============================================================================
+
+/**
+ * @brief マージ結果のタスク1件（3つのプロジェクトのタスクを束ねたもの）
+ */
+struct MergeTaskNode {
+    int32_t base = -1;              ///< 元プロジェクトでの索引
+    int32_t ours = -1;              ///< 現在のプロジェクトでの索引
+    int32_t theirs = -1;            ///< 取り込むプロジェクトでの索引
+    int32_t parent = -1;            ///< マージ結果の親
+    bool alive = false;             ///< マージ結果に残るか
+    bool placed = false;            ///< 兄弟の並びに配置済みか
+    bool editDelete = false;        ///< 削除と変更の競合
+    bool moveConflict = false;      ///< 移動の競合
+    uint32_t conflictFields = 0;    ///< フィールドの競合
+    int32_t firstChild = -1;        ///< 結果の親が自身であるタスクの一覧（先頭）
+    int32_t nextSibling = -1;       ///< 同上（次）
+    int32_t firstFollower = -1;     ///< 自身の直後に置くタスクの一覧（後に処理したものが先頭）
+    int32_t nextFollower = -1;      ///< 同上（次）
+    std::shared_ptr<WBSItem> result;    ///< マージ結果のタスク
+};
+
+/**
+ * @brief マージ処理の作業領域
+ */
+struct ProjectMerger {
+    std::vector<DiffTaskNode> base;         ///< 共通の元プロジェクト
+    std::vector<DiffTaskNode> ours;         ///< 現在のプロジェクト
+    std::vector<DiffTaskNode> theirs;       ///< 取り込むプロジェクト
+    TaskMatching oursMatching;              ///< 元 → 現在
+    TaskMatching theirsMatching;            ///< 元 → 取り込む側
+    std::vector<int32_t> oursToNode;        ///< 現在のプロジェクトの索引 → マージ結果
+    std::vector<int32_t> theirsToNode;      ///< 取り込むプロジェクトの索引 → マージ結果
+    std::vector<int32_t> oursPrevious;      ///< 現在のプロジェクトでの直前の兄弟
+    std::vector<int32_t> theirsPrevious;    ///< 取り込むプロジェクトでの直前の兄弟
+    std::vector<MergeTaskNode> nodes;       ///< 先頭の base.size() 件は元プロジェクトのタスク
+    std::shared_ptr<WBSArena> arena;        ///< マージ結果のタスクの確保元（結果のプロジェクトが所有）
+
+    enum Side { SideOurs, SideTheirs, SideBase, SideNone };
+
+    /**
+     * @brief タスクの、指定した側での親（マージ結果の索引）
+     */
+    int32_t ParentIn(const MergeTaskNode& node, Side side) const {
+        switch (side) {
+            case SideOurs: return node.ours > 0 ? oursToNode[ours[node.ours].parent] : -1;
+            case SideTheirs: return node.theirs > 0 ? theirsToNode[theirs[node.theirs].parent] : -1;
+            case SideBase: return node.base > 0 ? base[node.base].parent : -1;
+            default: return -1;
+        }
+    }
+
+    /**
+     * @brief 指定した側の平坦化したツリー
+     */
+    const std::vector<DiffTaskNode>& TreeOf(Side side) const {
+        return side == SideOurs ? ours : side == SideTheirs ? theirs : base;
+    }
+
+    /**
+     * @brief 指定した側での索引 → マージ結果の索引
+     */
+    int32_t ToNode(Side side, uint32_t index) const {
+        return side == SideOurs ? oursToNode[index] : side == SideTheirs ? theirsToNode[index] : static_cast<int32_t>(index);
+    }
+
+    /**
+     * @brief マージ結果のタスク → 指定した側での索引（なしは-1）
+     */
+    int32_t IndexIn(const MergeTaskNode& node, Side side) const {
+        return side == SideOurs ? node.ours : side == SideTheirs ? node.theirs : side == SideBase ? node.base : -1;
+    }
+
+    void BuildNodes();
+    void ResolveParents();
+    void BreakCycles();
+    void ResolveFields();
+    void OrderChildren(int32_t parentNode);
+    void RenumberAddedTasks(WBSProject& result);
+};
+
+/**
+ * @brief マージ結果のタスクの一覧を作成
+ *
+ * 元プロジェクトのタスク、現在のプロジェクトにだけあるタスク、
+ * 取り込むプロジェクトにだけあるタスクの順に並べます。両方で同じ id・内容の
+ * タスクが追加されていた場合は1件にまとめます。
+ */
+void ProjectMerger::BuildNodes() {
+    nodes.assign(base.size(), MergeTaskNode());
+    oursToNode.assign(ours.size(), -1);
+    theirsToNode.assign(theirs.size(), -1);
+    GetPreviousSiblings(ours, oursPrevious);
+    GetPreviousSiblings(theirs, theirsPrevious);
+    for (uint32_t b = 0; b < base.size(); ++b) {
+        nodes[b].base = static_cast<int32_t>(b);
+        nodes[b].ours = oursMatching.baseToOther[b];
+        nodes[b].theirs = theirsMatching.baseToOther[b];
+        if (nodes[b].ours >= 0) oursToNode[nodes[b].ours] = static_cast<int32_t>(b);
+        if (nodes[b].theirs >= 0) theirsToNode[nodes[b].theirs] = static_cast<int32_t>(b);
+    }
+
+    TaskIdIndex addedIndex; // 現在のプロジェクトで追加されたタスクの id → マージ結果
+    for (uint32_t o = 0; o < ours.size(); ++o) {
+        if (oursToNode[o] < 0) {
+            MergeTaskNode node;
+            node.ours = static_cast<int32_t>(o);
+            oursToNode[o] = static_cast<int32_t>(nodes.size());
+            addedIndex.emplace(&ours[o].item->id, oursToNode[o]);
+            nodes.push_back(node);
+        }
+    }
+    for (uint32_t t = 0; t < theirs.size(); ++t) {
+        if (theirsToNode[t] >= 0) {
+            continue;
+        }
+        auto found = addedIndex.find(&theirs[t].item->id);
+        if (found != addedIndex.end() && nodes[found->second].theirs < 0 &&
+            CompareTaskFields(*ours[nodes[found->second].ours].item, *theirs[t].item) == 0) {
+            nodes[found->second].theirs = static_cast<int32_t>(t); // 両方で同じタスクを追加
+            theirsToNode[t] = found->second;
+            continue;
+        }
+        MergeTaskNode node;
+        node.theirs = static_cast<int32_t>(t);
+        theirsToNode[t] = static_cast<int32_t>(nodes.size());
+        nodes.push_back(node);
+    }
+}
+
+/**
+ * @brief 残すタスクと、マージ結果での親を決める
+ */
+void ProjectMerger::ResolveParents() {
+    for (size_t u = 0; u < nodes.size(); ++u) {
+        MergeTaskNode& node = nodes[u];
+        bool inOurs = node.ours >= 0;
+        bool inTheirs = node.theirs >= 0;
+
+        // 残すかどうか（一方で削除されたタスクは、他方で変更されていなければ削除）
+        if (node.base < 0 || (inOurs && inTheirs)) {
+            node.alive = true;
+        } else if (inOurs || inTheirs) {
+            const WBSItem& kept = inOurs ? *ours[node.ours].item : *theirs[node.theirs].item;
+            node.editDelete = CompareTaskFields(*base[node.base].item, kept) != 0;
+            node.alive = node.editDelete;
+        }
+
+        // 親（一方だけが移動していればその移動を採用）
+        if (u == 0) {
+            node.parent = -1;
+        } else if (inOurs && inTheirs && node.base >= 0) {
+            int32_t oursParent = ParentIn(node, SideOurs);
+            int32_t theirsParent = ParentIn(node, SideTheirs);
+            int32_t baseParent = ParentIn(node, SideBase);
+            if (oursParent == baseParent) {
+                node.parent = theirsParent;
+            } else {
+                node.parent = oursParent;
+                node.moveConflict = theirsParent != baseParent && theirsParent != oursParent;
+            }
+        } else {
+            node.parent = ParentIn(node, inOurs ? SideOurs : inTheirs ? SideTheirs : SideBase);
+        }
+    }
+
+    // 残るタスクの祖先は削除しない（削除を取り消して競合とする）
+    for (size_t u = 0; u < nodes.size(); ++u) {
+        if (!nodes[u].alive) {
+            continue;
+        }
+        for (int32_t p = nodes[u].parent; p >= 0 && !nodes[p].alive; p = nodes[p].parent) {
+            nodes[p].alive = true;
+            nodes[p].editDelete = true;
+        }
+    }
+}
+
+/**
+ * @brief 双方の移動の組み合わせで生じた親子の循環を解消
+ *
+ * 循環を閉じる位置のタスクをルートの直下へ移し、移動の競合とします。
+ */
+void ProjectMerger::BreakCycles() {
+    std::vector<uint8_t> state(nodes.size(), 0); // 0: 未訪問、1: 辿っている途中、2: ルートに届く
+    std::vector<int32_t> path;
+    for (size_t u = 0; u < nodes.size(); ++u) {
+        if (!nodes[u].alive || state[u] != 0) {
+            continue;
+        }
+        path.clear();
+        int32_t x = static_cast<int32_t>(u);
+        while (x >= 0 && state[x] == 0) {
+            state[x] = 1;
+            path.push_back(x);
+            x = nodes[x].parent;
+        }
+        if (x >= 0 && state[x] == 1) {
+            nodes[path.back()].parent = 0;
+            nodes[path.back()].moveConflict = true;
+        }
+        for (int32_t visited : path) {
+            state[visited] = 2;
+        }
+    }
+}
+
+/**
+ * @brief マージ結果のタスクを作成し、フィールドを3方向で統合
+ */
+void ProjectMerger::ResolveFields() {
+    const uint32_t allFields = (1u << kWBSDiffFieldCount) - 1;
+    for (size_t u = 0; u < nodes.size(); ++u) {
+        MergeTaskNode& node = nodes[u];
+        if (!node.alive) {
+            continue;
+        }
+        const WBSItem* oursItem = node.ours >= 0 ? ours[node.ours].item : nullptr;
+        const WBSItem* theirsItem = node.theirs >= 0 ? theirs[node.theirs].item : nullptr;
+        const WBSItem* baseItem = node.base >= 0 ? base[node.base].item : nullptr;
+
+        node.result = WBSItem::Create(arena);
+        CopyTaskFields(*node.result, oursItem ? *oursItem : theirsItem ? *theirsItem : *baseItem, allFields);
+        if (oursItem && theirsItem && baseItem) {
+            uint32_t oursChanged = oursMatching.sameSubtree[node.ours] ? 0 : CompareTaskFields(*baseItem, *oursItem);
+            uint32_t theirsChanged = theirsMatching.sameSubtree[node.theirs] ? 0 : CompareTaskFields(*baseItem, *theirsItem);
+            CopyTaskFields(*node.result, *theirsItem, theirsChanged & ~oursChanged);
+            if (oursChanged & theirsChanged) {
+                node.conflictFields = CompareTaskFields(*oursItem, *theirsItem) & oursChanged & theirsChanged;
+            }
+        }
+    }
+}
+
+/**
+ * @brief マージ結果の子タスクの並びを決めて親に追加
+ *
+ * 基準にする側（現在のプロジェクトが並びを変えていなければ取り込む側、
+ * それ以外は現在のプロジェクト）の並びに含まれるタスクを先に置き、
+ * 残りのタスクは元の側で直前にあった兄弟の後ろに置きます。
+ */
+void ProjectMerger::OrderChildren(int32_t parentNode) {
+    MergeTaskNode& parent = nodes[parentNode];
+    if (parent.firstChild < 0) {
+        return;
+    }
+
+    // 基準にする側
+    Side primary = parent.ours >= 0 ? SideOurs : parent.theirs >= 0 ? SideTheirs : SideBase;
+    if (parent.ours >= 0 && parent.theirs >= 0 && parent.base >= 0) {
+        bool unchanged = true;
+        uint32_t o = parent.ours + 1;
+        uint32_t b = parent.base + 1;
+        for (; o < ours[parent.ours].subtreeEnd && b < base[parent.base].subtreeEnd;
+             o = ours[o].subtreeEnd, b = base[b].subtreeEnd) {
+            if (oursToNode[o] != static_cast<int32_t>(b)) {
+                unchanged = false;
+                break;
+            }
+        }
+        if (unchanged && o == ours[parent.ours].subtreeEnd && b == base[parent.base].subtreeEnd) {
+            primary = SideTheirs;
+        }
+    }
+
+    std::vector<int32_t> sequence;
+    const std::vector<DiffTaskNode>& primaryTree = TreeOf(primary);
+    int32_t primaryIndex = IndexIn(parent, primary);
+    for (uint32_t c = primaryIndex + 1; c < primaryTree[primaryIndex].subtreeEnd; c = primaryTree[c].subtreeEnd) {
+        int32_t child = ToNode(primary, c);
+        if (child >= 0 && nodes[child].alive && nodes[child].parent == parentNode && !nodes[child].placed) {
+            nodes[child].placed = true;
+            sequence.push_back(child);
+        }
+    }
+
+    // 残りのタスクを、それぞれの側で直前にあった兄弟の後ろへ（見つからなければ先頭・末尾）
+    std::vector<int32_t> front;
+    std::vector<int32_t> back;
+    for (int32_t child = parent.firstChild; child >= 0; child = nodes[child].nextSibling) {
+        MergeTaskNode& node = nodes[child];
+        if (node.placed) {
+            continue;
+        }
+        Side side = SideNone;
+        if (ParentIn(node, SideTheirs) == parentNode) side = SideTheirs;
+        else if (ParentIn(node, SideOurs) == parentNode) side = SideOurs;
+
+        int32_t anchor = -1;
+        if (side != SideNone) {
+            // 直前の兄弟のうち、マージ結果でも同じ親を持つもの
+            const std::vector<int32_t>& previous = side == SideOurs ? oursPrevious : theirsPrevious;
+            for (int32_t c = previous[IndexIn(node, side)]; c >= 0 && anchor < 0; c = previous[c]) {
+                int32_t sibling = ToNode(side, c);
+                if (nodes[sibling].alive && nodes[sibling].parent == parentNode) {
+                    anchor = sibling;
+                }
+            }
+        }
+        node.placed = true;
+        if (anchor >= 0) {
+            node.nextFollower = nodes[anchor].firstFollower;
+            nodes[anchor].firstFollower = child;
+        } else if (side != SideNone) {
+            front.push_back(child);
+        } else {
+            back.push_back(child);
+        }
+    }
+
+    // 並びの確定（直後に置くタスクを深さ優先で展開）
+    std::vector<int32_t> stack;
+    auto emit = [&](int32_t first) {
+        stack.push_back(first);
+        while (!stack.empty()) {
+            int32_t x = stack.back();
+            stack.pop_back();
+            nodes[x].result->parent = parent.result;
+            parent.result->children.push_back(nodes[x].result);
+            for (int32_t f = nodes[x].firstFollower; f >= 0; f = nodes[f].nextFollower) {
+                stack.push_back(f); // 後に処理したものが先頭のため、取り出す順は元の順
+            }
+        }
+    };
+    for (int32_t child : front) emit(child);
+    for (int32_t child : sequence) emit(child);
+    for (int32_t child : back) emit(child);
+}
+
+/**
+ * @brief 競合したタスクに印を付け、一覧に追加
+ */
+void MarkMergeConflict(const ProjectMerger& merger, const MergeTaskNode& node, std::vector<WBSMergeConflict>& conflicts) {
+    WBSItem& item = *node.result;
+    std::string notes;
+    if (node.conflictFields) {
+        const WBSItem& oursItem = *merger.ours[node.ours].item;
+        const WBSItem& theirsItem = *merger.theirs[node.theirs].item;
+        notes += u8"\r\n<<<<<<< 現在のプロジェクト";
+        for (uint32_t field = 1; field < (1u << kWBSDiffFieldCount); field <<= 1) {
+            if (node.conflictFields & field) {
+                notes += "\r\n" + std::string(GetWBSDiffFieldName(field)) + ": " + FormatTaskField(oursItem, field);
+            }
+        }
+        notes += "\r\n=======";
+        for (uint32_t field = 1; field < (1u << kWBSDiffFieldCount); field <<= 1) {
+            if (node.conflictFields & field) {
+                notes += "\r\n" + std::string(GetWBSDiffFieldName(field)) + ": " + FormatTaskField(theirsItem, field);
+            }
+        }
+        notes += u8"\r\n>>>>>>> 取り込んだプロジェクト";
+        conflicts.push_back({ WBSMergeConflictKind::FieldEdit, &item, node.conflictFields });
+    }
+    if (node.editDelete) {
+        notes += u8"\r\n（一方のプロジェクトで削除されたタスクです。不要であれば削除してください）";
+        conflicts.push_back({ WBSMergeConflictKind::EditDelete, &item, 0 });
+    }
+    if (node.moveConflict) {
+        notes += u8"\r\n（両方のプロジェクトで異なる位置へ移動されたタスクです。位置を確認してください）";
+        conflicts.push_back({ WBSMergeConflictKind::Move, &item, 0 });
+    }
+    if (!notes.empty()) {
+        item.taskName = kWBSConflictMarker + item.taskName;
+        item.description = item.description.empty() ? notes.substr(2) : item.description.str() + notes; // 先頭の改行は区切り
+    }
+}
+
+/**
+ * @brief 取り込む側で追加されたタスクの重複した id を振り直す
+ *
+ * 双方が同じ親に別々のタスクを追加すると、同じ id（親のID + 連番）になるため、
+ * 取り込む側のタスクを「親のID + 子タスクの数」以降の未使用の番号に振り直します。
+ * 振り直したタスクの下に追加された子孫は、親の新しいIDに元と同じ番号を付けた
+ * IDへ移します（それも重複する場合は同じ規則で振り直す）。
+ * 現在のプロジェクトにあるタスクの id は変更しません。
+ *
+ * @param result マージ結果（ルートを設定済み）。重複の判定は WBSProject::FindTask() の
+ *               IDの索引で行い、振り直しは SetTaskId() で索引に反映します。
+ *
+ * 取り込む側だけのタスクは行きがけ順に並んでいるため、親は子より先に処理されます。
+ */
+void ProjectMerger::RenumberAddedTasks(WBSProject& result) {
+    std::unordered_map<int32_t, WBSTaskId> previousIds; // 振り直したタスク → 元の id
+    for (size_t n = 0; n < nodes.size(); ++n) {
+        MergeTaskNode& node = nodes[n];
+        if (!node.alive || node.ours >= 0 || node.base >= 0) {
+            continue;
+        }
+        WBSItem& item = *node.result;
+        const WBSItem& parentItem = *nodes[node.parent].result;
+        auto renamedParent = previousIds.find(node.parent);
+        if (renamedParent == previousIds.end() && !result.FindTask(item.id, &item)) {
+            continue;
+        }
+
+        WBSTaskId id = item.id;
+        if (renamedParent != previousIds.end()) {
+            const WBSTaskId& parentPrevious = renamedParent->second;
+            if (id.StartsWith(parentPrevious) && id.Depth() == parentPrevious.Depth() + 1) {
+                id.AssignChild(parentItem.id, id.Ordinal(id.Depth() - 1)); // 親の新しいIDの下へ移す
+            }
+        }
+        if (result.FindTask(id, &item)) {
+            size_t number = parentItem.children.size();
+            do {
+                id.AssignChild(parentItem.id, static_cast<uint32_t>(number++));
+            } while (result.FindTask(id, &item));
+        }
+        if (id != item.id) {
+            previousIds.emplace(static_cast<int32_t>(n), item.id);
+            result.SetTaskId(item, id); // IDの索引も更新
+        }
+    }
+}
+
+/**
+ * @brief マージ結果の階層レベルを設定
+ */
+void SetMergedTaskLevels(WBSItem& root) {
+    std::vector<WBSItem*> stack;
+    root.level = 0;
+    stack.push_back(&root);
+    while (!stack.empty()) {
+        WBSItem* item = stack.back();
+        stack.pop_back();
+        for (const auto& child : item->children) {
+            child->level = item->level + 1;
+            stack.push_back(child.get());
+        }
+    }
+}
+
+/**
+ * @brief 共通の元プロジェクトを基準に、2つのプロジェクトを3方向でマージ
+ *
+ * @param base 共通の元プロジェクト
+ * @param ours 現在のプロジェクト（競合時に値を残す側）
+ * @param theirs 取り込むプロジェクト
+ * @param conflicts 競合の格納先（ポインタはマージ結果のタスクを指す）
+ * @return マージ結果（遅延読み込みの子タスクが残っている場合はnullptr）
+ *
+ * 入力のプロジェクトは変更しません。マージ結果はどの入力とも木を共有しません。
+ */
+std::unique_ptr<WBSProject> MergeProjects(const WBSProject& base, const WBSProject& ours, const WBSProject& theirs,
+                                          std::vector<WBSMergeConflict>& conflicts) {
+    conflicts.clear();
+    if (!base.rootTask || !ours.rootTask || !theirs.rootTask) {
+        return nullptr;
+    }
+
+    ProjectMerger merger;
+    if (!FlattenTaskTree(*base.rootTask, merger.base) || !FlattenTaskTree(*ours.rootTask, merger.ours) ||
+        !FlattenTaskTree(*theirs.rootTask, merger.theirs)) {
+        return nullptr;
+    }
+    MatchTaskTrees(merger.base, merger.ours, merger.oursMatching);
+    MatchTaskTrees(merger.base, merger.theirs, merger.theirsMatching);
+
+    auto merged = std::make_unique<WBSProject>();
+    merger.arena = merged->arena;
+    merger.BuildNodes();
+    merger.ResolveParents();
+    merger.BreakCycles();
+    merger.ResolveFields();
+
+    // 結果の親ごとの子タスクの一覧（索引の昇順）を作成して並びを確定
+    for (int32_t u = static_cast<int32_t>(merger.nodes.size()) - 1; u > 0; --u) {
+        MergeTaskNode& node = merger.nodes[u];
+        if (node.alive) {
+            node.nextSibling = merger.nodes[node.parent].firstChild;
+            merger.nodes[node.parent].firstChild = u;
+        }
+    }
+    for (size_t u = 0; u < merger.nodes.size(); ++u) {
+        if (merger.nodes[u].alive) {
+            merger.OrderChildren(static_cast<int32_t>(u));
+        }
+    }
+    merged->rootTask = merger.nodes[0].result;
+    merged->InvalidateTaskIndex();
+    merger.RenumberAddedTasks(*merged);
+    for (const MergeTaskNode& node : merger.nodes) {
+        if (node.alive) {
+            MarkMergeConflict(merger, node, conflicts);
+        }
+    }
+
+    // プロジェクト名・説明の統合
+    auto mergeText = [&conflicts](const std::string& baseText, const std::string& oursText,
+                                  const std::string& theirsText, uint32_t field) {
+        if (oursText != baseText && theirsText != baseText && oursText != theirsText) {
+            conflicts.push_back({ WBSMergeConflictKind::FieldEdit, nullptr, field });
+        }
+        return oursText == baseText ? theirsText : oursText;
+    };
+    merged->projectName = mergeText(base.projectName, ours.projectName, theirs.projectName, kWBSDiffFieldTaskName);
+    merged->description = mergeText(base.description, ours.description, theirs.description, kWBSDiffFieldDescription);
+    SetMergedTaskLevels(*merged->rootTask);
+    return merged;
+}
+
+// ============================================================================
+// UI
+// ============================================================================
+
+/**
+ * @brief マージに使うプロジェクトファイルを選択して読み込み
+ *
+ * @param title ファイル選択ダイアログのタイトル
+ * @param project 読み込んだプロジェクトの格納先（遅延読み込みなし・ジャーナル適用済み）
+ * @return 読み込めた場合true（キャンセル・エラー時はfalse）
+ */
+bool SelectMergeInput(const wchar_t* title, std::unique_ptr<WBSProject>& project) {
+    OPENFILENAME ofn = {};
+    WCHAR szFile[260] = L""; // ファイルパスバッファ
+
+    ofn.lStructSize = sizeof(ofn);
+    ofn.hwndOwner = g_hMainDialog;
+    ofn.lpstrFile = szFile;
+    ofn.nMaxFile = sizeof(szFile) / sizeof(szFile[0]);
+    ofn.lpstrFilter = L"WBS XMLファイル\0*.xml\0WBSバイナリファイル\0*.wbsb\0WBS圧縮XMLファイル\0*.wbsz\0WBS JSONファイル\0*.json\0タスク表（CSV）\0*.csv\0タスク表（TSV）\0*.tsv\0すべてのファイル\0*.*\0";
+    ofn.nFilterIndex = 1;
+    ofn.lpstrTitle = title;
+    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST; // パスとファイルの存在チェック
+
+    if (GetOpenFileName(&ofn) != TRUE) {
+        return false;
+    }
+    if (!ReadProjectFile(szFile, project, 0) || !project) {
+        MessageBox(g_hMainDialog, L"プロジェクトファイルを読み込めませんでした。", L"エラー", MB_OK | MB_ICONERROR);
+        return false;
+    }
+    ReplayProjectJournal(szFile, *project);
+    return true;
+}
+
+/**
+ * @brief 現在のプロジェクトに、別のファイルでの編集をマージ
+ *
+ * @details 処理フロー:
+ * 1. 共通の元ファイル、取り込むファイルの順に選択して読み込み
+ * 2. 現在のプロジェクトの遅延読み込みを完了
+ * 3. MergeProjects() による3方向マージ
+ * 4. 結果を現在のプロジェクトに置き換え（保存先との対応付けは解除）
+ * 5. 取り込んだ変更の件数と競合の件数を通知
+ */
+void OnMergeProject() {
+    if (!g_currentProject) {
+        MessageBox(g_hMainDialog, L"マージ先のプロジェクトがありません。", L"エラー", MB_OK | MB_ICONWARNING);
+        return;
+    }
+
+    try {
+        std::unique_ptr<WBSProject> base;
+        std::unique_ptr<WBSProject> theirs;
+        if (!SelectMergeInput(L"共通の元になったプロジェクトファイルを選択", base) ||
+            !SelectMergeInput(L"取り込むプロジェクトファイルを選択", theirs)) {
+            return;
+        }
+
+        WaitForBackgroundSave(g_currentProject.get());
+        if (!g_currentProject->LoadDeferredTasks()) {
+            MessageBox(g_hMainDialog, L"子タスクを読み込めませんでした。", L"エラー", MB_OK | MB_ICONERROR);
+            return;
+        }
+
+        std::vector<WBSMergeConflict> conflicts;
+        std::unique_ptr<WBSProject> merged = MergeProjects(*base, *g_currentProject, *theirs, conflicts);
+        if (!merged) {
+            MessageBox(g_hMainDialog, L"プロジェクトをマージできませんでした。", L"エラー", MB_OK | MB_ICONERROR);
+            return;
+        }
+
+        // 取り込んだ変更の集計（置き換える前の現在のプロジェクトとの差分）
+        size_t counts[4] = {};
+        WBSProjectDiff diff;
+        if (DiffProjects(*g_currentProject, *merged, diff)) {
+            for (const WBSDiffEntry& entry : diff.entries) {
+                ++counts[static_cast<int>(entry.kind)];
+            }
+        }
+
+        g_currentProject = std::move(merged);
+        JournalDetach(); // 新しい内容のため、次回の保存は全体保存
+        RefreshTreeView();
+        RefreshListView();
+
+        std::wstring message = L"プロジェクトをマージしました。\n\n取り込んだ変更: 変更 " +
+            std::to_wstring(counts[static_cast<int>(WBSDiffKind::Modified)]) + L"件、移動 " +
+            std::to_wstring(counts[static_cast<int>(WBSDiffKind::Moved)]) + L"件、追加 " +
+            std::to_wstring(counts[static_cast<int>(WBSDiffKind::Inserted)]) + L"件、削除 " +
+            std::to_wstring(counts[static_cast<int>(WBSDiffKind::Deleted)]) + L"件\n";
+        if (conflicts.empty()) {
+            message += L"競合はありません。";
+        } else {
+            message += L"競合: " + std::to_wstring(conflicts.size()) + L"件（タスク名に「" +
+                Utf8ToWide(kWBSConflictMarker) + L"」が付いたタスクを確認してください）";
+        }
+        MessageBox(g_hMainDialog, message.c_str(), L"情報", MB_OK | (conflicts.empty() ? MB_ICONINFORMATION : MB_ICONWARNING));
+
+    } catch (...) {
+        // 全ての例外をキャッチ（ファイルI/O、メモリ不足等）
+        MessageBox(g_hMainDialog, L"プロジェクトのマージ中にエラーが発生しました。", L"エラー", MB_OK | MB_ICONERROR);
+    }
+}
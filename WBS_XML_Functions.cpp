@@ -1,31 +1,31 @@
 /*
  * ============================================================================
- * WBS_XML_Functions.cpp - XML僂W[
+ * WBS_XML_Functions.cpp - XML処理専門モジュール
  * ============================================================================
  * 
- * ̃W[́AWBSvWFNgf[^XML`ł̉i@\񋟂܂B
- * CAvP[ViWBS_cpp_win32.cppjƗ݌vɂA
- * ėpƕێ琫Ă܂B
+ * このモジュールは、WBSプロジェクトデータのXML形式での永続化機能を提供します。
+ * メインアプリケーション（WBS_cpp_win32.cpp）から独立した設計により、
+ * 高い再利用性と保守性を実現しています。
  * 
- * yȋ@\z
- * - WBSvWFNgXMLVAC[[V
- * - XMLWBSvWFNgfVAC[[V  
- * - Kw\̊SȕۑE
- * - XMLGXP[vɂSȃeLXg
- * - UTF-8GR[fBOΉ
- * - t@CI/OO
+ * 【主な機能】
+ * - WBSプロジェクト→XMLシリアライゼーション
+ * - XML→WBSプロジェクトデシリアライゼーション  
+ * - 階層構造の完全な保存・復元
+ * - XMLエスケープによる安全なテキスト処理
+ * - UTF-8エンコーディング対応
+ * - ファイルI/O例外処理
  * 
- * yXML\݌vz
+ * 【XML構造設計】
  * <?xml version="1.0" encoding="UTF-8"?>
  * <WBSProject>
- *   <ProjectName>vWFNg</ProjectName>
- *   <Description>vWFNg</Description>
+ *   <ProjectName>プロジェクト名</ProjectName>
+ *   <Description>プロジェクト説明</Description>
  *   <RootTask>
  *     <Task>
  *       <ID>1</ID>
- *       <Name>[g^XN</Name>
- *       <Description></Description>
- *       <AssignedTo>S</AssignedTo>
+ *       <Name>ルートタスク</Name>
+ *       <Description>説明</Description>
+ *       <AssignedTo>担当者</AssignedTo>
  *       <Status>0</Status>
  *       <Priority>1</Priority>
  *       <EstimatedHours>100.0</EstimatedHours>
@@ -34,777 +34,1206 @@
  *       <EndDate>2024-12-31T18:00:00</EndDate>
  *       <Level>0</Level>
  *       <Children>
- *         <!-- q^XN̍ċAI\ -->
+ *         <!-- 子タスクの再帰的構造 -->
  *         <Task>...</Task>
  *       </Children>
  *     </Task>
  *   </RootTask>
  * </WBSProject>
  * 
- * y݌vz
- * - ^S: ^`FbNƓK؂ȃLXg
- * - OS: SȗOƃ\[XǗ
- * - g: VtB[hǉɑΉ\Ȑ݌v
- * - ݊: قȂo[WԂł̃f[^݊
+ * 【設計原則】
+ * - 型安全性: 強い型チェックと適切なキャスト
+ * - 例外安全性: 完全な例外処理とリソース管理
+ * - 拡張性: 新しいフィールド追加に対応可能な設計
+ * - 互換性: 異なるバージョン間でのデータ互換性
  * 
- * yZpdlz
- * - GR[fBO: UTF-8 (t@C), UTF-16LE ()
- * - XMLW: W3C XML 1.0
- * - `: ISO 8601 (YYYY-MM-DDTHH:MM:SS)
- * - l`: IEEE 754{x_
+ * 【技術仕様】
+ * - 文字エンコーディング: UTF-8 (ファイル), UTF-16LE (内部処理)
+ * - XML標準: W3C XML 1.0準拠
+ * - 日時形式: ISO 8601準拠 (YYYY-MM-DDTHH:MM:SS)
+ * - 数値形式: IEEE 754準拠倍精度浮動小数点
  * 
- * 쐬: J`[
- * 쐬: 2024N
- * ŏIXV: 2024N
- * o[W: 1.0
+ * 作成者: 開発チーム
+ * 作成日: 2024年
+ * 最終更新: 2024年
+ * バージョン: 1.0
  * ============================================================================
  */
 
-// WBS XML Processing Module - C
-// XML僂W[id`폜j
+// WBS XML Processing Module - 修正版
+// XML処理専門モジュール（重複定義を削除）
 
-#include <fstream>     // t@CXg[io͑j
-#include <sstream>     // Xg[i񑀍j
-#include <codecvt>     // R[hϊiUTF-8  UTF-16j
-#include <locale>      // P[ݒiۉΉj
-#include <windows.h>   // Windows{API
-#include <commdlg.h>   // R_CAOAPIit@CIj
-#include <shlobj.h>    // VFIuWFNgAPIitH_j
-#include <memory>      // X}[g|C^iSj
-#include <vector>      // IziKwf[^Ǘj
-#include <string>      // NXieLXgj
+#include <fstream>     // ファイルストリーム（入出力操作）
+#include <sstream>     // 文字列ストリーム（文字列操作）
+#include <codecvt>     // 文字コード変換（UTF-8 ⇔ UTF-16）
+#include <locale>      // ロケール設定（国際化対応）
+#include <windows.h>   // Windows基本API
+#include <commdlg.h>   // コモンダイアログAPI（ファイル選択）
+#include <shlobj.h>    // シェルオブジェクトAPI（フォルダ操作）
+#include <memory>      // スマートポインタ（メモリ安全性）
+#include <vector>      // 動的配列（階層データ管理）
+#include <string>      // 文字列クラス（テキスト処理）
+#include <thread>      // 部分木の並列解析
+#include <atomic>      // 並列解析の作業索引
+#include <algorithm>   // std::sort（並列解析の割り当て順）
+#include <exception>   // std::exception_ptr（ワーカースレッドの例外の受け渡し）
+
+#include "WBS_cpp_win32/WBSClasses.h"    // WBSクラス定義
+#include "WBS_cpp_win32/WBSXmlReader.h"  // 前方向専用XMLプルパーサー
+#include "WBS_cpp_win32/WBSXmlWriter.h"  // ストリーミングXMLライター
+#include "WBS_cpp_win32/WBSMappedFile.h" // 読み取り専用メモリマップファイル
+#include "WBS_cpp_win32/WBSCompression.h" // 圧縮コンテナ形式（.wbsz）
+#include "WBS_cpp_win32/WBSFieldCodec.h"  // 数値・列挙型・日時フィールドの文字列変換
+#include "WBS_cpp_win32/WBSSaveJob.h"    // バックグラウンド保存の状態
 
 std::wstring GetConfigFilePath();
 void SaveLastOpenedFile(const std::wstring& filePath);
 std::wstring GetLastOpenedFile();
 // ============================================================================
-// Oˑ֌W - CAvP[VƂ̘Ag
+// 外部依存関係 - メインアプリケーションとの連携
 // ============================================================================
 
-// OϐFCAvP[VŒ`ĂO[o
-extern std::unique_ptr<WBSProject> g_currentProject;   // ݂̃vWFNgCX^X
-extern void RefreshTreeView();                         // UIXVFc[r[̍ĕ`
-extern void RefreshListView();                         // UIXVFڍ׃r[̍ĕ`
-extern void SaveLastOpenedFile(const std::wstring& filePath);  // ݒۑFŌɊJt@C
+// 外部変数：メインアプリケーションで定義されているグローバル状態
+extern std::unique_ptr<WBSProject> g_currentProject;   // 現在のプロジェクトインスタンス
+extern HWND g_hMainDialog;                             // メインダイアログ（保存完了の通知先）
+extern void RefreshTreeView();                         // UI更新：ツリービューの再描画
+extern void RefreshListView();                         // UI更新：詳細ビューの再描画
+extern void SaveLastOpenedFile(const std::wstring& filePath);  // 設定保存：最後に開いたファイル
+extern int GetLazyLoadDepth();                                 // 設定取得：遅延読み込みで構築する階層数
+
+// バイナリ形式（.wbsb）処理モジュール（WBS_Binary_Functions.cpp）
+bool ReadProjectBinaryFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project);
+
+// タスク表（CSV/TSV）入出力モジュール（WBS_CSV_Functions.cpp）
+char GetTaskTableDelimiter(const std::wstring& filePath);
+bool ReadProjectTaskTableFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project, char delimiter);
+
+// JSON形式（.json）入出力モジュール（WBS_JSON_Functions.cpp）
+bool IsJsonProjectPath(const std::wstring& filePath);
+bool ReadProjectJsonFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project);
+
+// 編集ジャーナル処理モジュール（WBS_Journal_Functions.cpp）
+void ApplyProjectJournal(const std::wstring& projectPath, WBSProject& project);
+void RequestBackgroundSave(const WBSProject& project, const std::wstring& filePath, HWND notifyWindow);
+WBSSaveStatus CompleteBackgroundSave(const WBSProject* project, WPARAM sequence, std::wstring& savedPath);
+bool WaitForBackgroundSave(const WBSProject* project);
 
 // ============================================================================
-// XML[eBeB֐Q
+// WBSデータシリアライゼーション関数群
 // ============================================================================
 
 /**
- * @brief XMLꕶGXP[v
- * 
- * @param text GXP[vΏۂ̕
- * @return GXP[vςݕ
- * 
- * XMLhLgœʂȈӖAΉXMLGeBeBɕϊ܂B
- * ɂACӂ̃[U[eLXgSXMLɖߍނƂł܂B
- * 
- * @details ϊdl:
- * - & (ApTh)  &amp;  : XMLGeBeB̊Jn
- * - < (Ȃ)  &lt;        : XML^O̊Jnh
- * - > (Ȃ)  &gt;        : XML^ȌIh  
- * - " (_uNH[g)  &quot; : XMLl̋؂蕶h
- * - ' (VONH[g)  &apos; : XMLl̋؂蕶h
- * 
- * @note ̏́A[U[͂^XN
- *       XML\j󂷂镶܂܂ĂĂSɕۑł悤ɂ܂
- * 
- * @example 
- * XmlEscape(L"<dv> A&B vWFNg \"ً}\"") 
- *  L"&lt;dv&gt; A&amp;B vWFNg &quot;ً}&quot;"
+ * @brief WBSアイテムをXMLライターへ書き込み（再帰的）
+ *
+ * @param writer 書き込み先のXMLライター
+ * @param item 書き込み対象のWBSアイテム
+ * @param indent インデント（空白文字数）
+ *
+ * ノードごとの文字列を作らず、ライターのUTF-8バッファへ直接書き込みます。
+ * 各バイトは一度だけコピーされ、計算量はタスク数に対して線形です。
+ *
+ * @note 数値・日時は WBSFieldCodec.h の書式で書き込みます。時間は小数点以下6桁で
+ *       表せる値なら従来の std::to_wstring(double)（"%f"）と同一で、
+ *       それ以外の値も読み込み時に元の値へ正確に戻ります
  */
-std::wstring XmlEscape(const std::wstring& text) {
-    std::wstring result;
-    result.reserve(text.length() * 1.2); // ptH[}XœKF\zTCYŗ\
-    
-    for (wchar_t c : text) {
-        switch (c) {
-            case L'&': result += L"&amp;"; break;   // ŏɏĩGeBeBƂ̋j
-            case L'<': result += L"&lt;"; break;    // XML^OJn
-            case L'>': result += L"&gt;"; break;    // XML^OI
-            case L'"': result += L"&quot;"; break;  // XMLl̋؂蕶
-            case L'\'': result += L"&apos;"; break; // XMLl̋؂蕶iցj
-            default: result += c; break;            // ʏ핶͂̂܂
+void WriteTaskXml(WBSXmlWriter& writer, const WBSItem& item, int indent) {
+    char buffer[kWBSFieldBufferSize];
+    size_t length;
+
+    writer.OpenTag(indent, "Task");
+
+    // 基本フィールド
+    writer.TextElement(indent + 2, "ID", item.id.ToString());
+    writer.TextElement(indent + 2, "Name", item.taskName);
+    writer.TextElement(indent + 2, "Description", item.description.str());
+    writer.TextElement(indent + 2, "AssignedTo", item.assignedTo.str());
+
+    // 列挙型・数値フィールド
+    length = FormatIntField(buffer, (int)item.status);
+    writer.RawElement(indent + 2, "Status", buffer, length);
+    length = FormatIntField(buffer, (int)item.priority);
+    writer.RawElement(indent + 2, "Priority", buffer, length);
+    length = FormatDoubleField(buffer, item.estimatedHours);
+    writer.RawElement(indent + 2, "EstimatedHours", buffer, length);
+    length = FormatDoubleField(buffer, item.actualHours);
+    writer.RawElement(indent + 2, "ActualHours", buffer, length);
+
+    // 日時フィールド（ISO 8601形式）
+    length = FormatDateField(buffer, item.startDate);
+    writer.RawElement(indent + 2, "StartDate", buffer, length);
+    length = FormatDateField(buffer, item.endDate);
+    writer.RawElement(indent + 2, "EndDate", buffer, length);
+
+    // 階層情報
+    length = FormatIntField(buffer, item.level);
+    writer.RawElement(indent + 2, "Level", buffer, length);
+
+    // 子要素の処理（再帰的）
+    if (!item.children.empty()) {
+        writer.OpenTag(indent + 2, "Children");
+        for (const auto& child : item.children) {
+            if (child) {
+                WriteTaskXml(writer, *child, indent + 4);
+            }
         }
+        writer.CloseTag(indent + 2, "Children");
     }
-    return result;
+
+    writer.CloseTag(indent, "Task");
 }
 
 /**
- * @brief XMLGeBeBAGXP[v
- * 
- * @param text AGXP[vΏۂ̕
- * @return AGXP[vςݕ
- * 
- * XMLǂݍ񂾃eLXgɊ܂܂XMLGeBeBA
- * ̕ɕ܂BXmlEscape()̋tϊłB
- * 
- * @details ϊdliGXP[v̋tŏj:
- * - &amp;  &   : ŌɏĩGeBeBƂ̋j
- * - &lt;  <    : XML^OJn̕
- * - &gt;  >    : XML^OI̕
- * - &quot;  "  : _uNH[g̕
- * - &apos;  '  : VONH[g̕
- * 
- * @warning dvF&amp;ŌɏȂƁA
- *          ̃GeBeB&ĕϊ
- * 
- * @note ptH[}XlFeGeBeBƂɕŜ𑖍
- *       pɂȃt@Cǂݍ݂łȂApȂ
+ * @brief プロジェクト全体をXML文書として出力先へ書き込み
+ *
+ * @param project 書き込み対象のプロジェクト
+ * @param sink 出力先（ファイル、メモリ等）
+ * @return 書き込みに成功した場合true
+ *
+ * ファイル冒頭の【XML構造設計】の文書をUTF-8で出力します。
+ * ライターのバッファは1MBごとに出力先へ書き出されるため、
+ * 使用メモリはプロジェクトの規模に依存しません。
  */
-std::wstring XmlUnescape(const std::wstring& text) {
-    std::wstring result = text;
-    size_t pos = 0;
-    
-    // &lt;  < ̕ϊ
-    while ((pos = result.find(L"&lt;", pos)) != std::wstring::npos) {
-        result.replace(pos, 4, L"<");
-        pos += 1;
-    }
-    pos = 0;
-    
-    // &gt;  > ̕ϊ
-    while ((pos = result.find(L"&gt;", pos)) != std::wstring::npos) {
-        result.replace(pos, 4, L">");
-        pos += 1;
-    }
-    pos = 0;
-    
-    // &quot;  " ̕ϊ
-    while ((pos = result.find(L"&quot;", pos)) != std::wstring::npos) {
-        result.replace(pos, 6, L"\"");
-        pos += 1;
-    }
-    pos = 0;
-    
-    // &apos;  ' ̕ϊ
-    while ((pos = result.find(L"&apos;", pos)) != std::wstring::npos) {
-        result.replace(pos, 6, L"'");
-        pos += 1;
+bool WriteProjectXml(const WBSProject& project, WBSOutputSink& sink) {
+    WBSXmlWriter writer(sink);
+
+    writer.Raw("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    writer.OpenTag(0, "WBSProject");
+    writer.TextElement(2, "ProjectName", project.projectName);
+    writer.TextElement(2, "Description", project.description);
+
+    writer.OpenTag(2, "RootTask");
+    if (project.rootTask) {
+        WriteTaskXml(writer, *project.rootTask, 4);
     }
-    pos = 0;
-    
-    // &amp;  & ̕ϊiŌɎsj
-    while ((pos = result.find(L"&amp;", pos)) != std::wstring::npos) {
-        result.replace(pos, 5, L"&");
-        pos += 1;
+    writer.CloseTag(2, "RootTask");
+
+    writer.CloseTag(0, "WBSProject");
+    return writer.Flush();
+}
+
+/**
+ * @brief プロジェクトを圧縮コンテナ（.wbsz）として出力先へ書き込み
+ *
+ * @param project 保存対象のプロジェクト
+ * @param sink 圧縮後のバイト列の出力先
+ * @param level 圧縮レベル（kWBSCompressionMinLevel ～ kWBSCompressionMaxLevel）
+ * @return 書き込みに成功した場合true
+ *
+ * WriteProjectXml() の出力を WBSCompressingSink でブロックごとに圧縮しながら
+ * 書き出すため、圧縮前のXML文書全体がメモリに置かれることはありません。
+ */
+bool WriteProjectCompressedXml(const WBSProject& project, WBSOutputSink& sink, int level) {
+    WBSCompressingSink compressing(sink, level);
+    bool written = WriteProjectXml(project, compressing);
+    return compressing.Finish() && written;
+}
+
+/**
+ * @brief プロジェクトをXMLファイルへ保存
+ *
+ * @param project 保存対象のプロジェクト
+ * @param filePath 保存先のファイルパス
+ * @return 保存に成功した場合true
+ */
+bool SaveProjectToFile(const WBSProject& project, const std::wstring& filePath) {
+    WBSFileSink file(filePath);
+    if (!file.IsOpen()) {
+        return false;
     }
-    
-    return result;
+
+    bool written = WriteProjectXml(project, file);
+    return file.Close() && written;
 }
 
 // ============================================================================
-// ϊ[eBeB֐Q
+// XMLデシリアライゼーション関数群
 // ============================================================================
 
 /**
- * @brief SYSTEMTIME\̂ISO 8601ɕϊ
- * 
- * @param st ϊΏۂSYSTEMTIME\
- * @return ISO 8601`̓ (YYYY-MM-DDTHH:MM:SS)
- * 
- * Windows APISYSTEMTIME\̂AەW̓`ɕϊ܂B
- * XMLۑɁA^XN̊JnEIW`ŋL^邽߂Ɏgp܂B
- * 
- * @details o͌`:
- * - N: 4iF2024j
- * - : 2iF01, 12j
- * - : 2iF01, 31j  
- * - ؂蕶: TiISO 8601j
- * - : 2iF00, 23j
- * - : 2iF00, 59j
- * - b: 2iF00, 59j
- * - ~b: ȗivWFNgǗł͕svj
- * 
- * @note ^C][͊܂܂܂i[JƂĈj
- * 
- * @example SystemTimeToString({2024, 12, 3, 25, 14, 30, 45, 0})
- *           L"2024-12-25T14:30:45"
+ * @brief タスク要素内のフィールド種別
+ *
+ * ParseTaskElement() がタグ名を一度だけ判定し、以降のテキストトークンの
+ * 格納先を決めるために使用します。
  */
-std::wstring SystemTimeToString(const SYSTEMTIME& st) {
-    wchar_t buffer[64];
-    swprintf_s(buffer, L"%04d-%02d-%02dT%02d:%02d:%02d",
-        st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, st.wSecond);
-    return std::wstring(buffer);
-}
+enum class TaskXmlField {
+    None,               // フィールド外（<Children> 等）
+    Id,
+    Name,
+    Description,
+    AssignedTo,
+    Status,
+    Priority,
+    EstimatedHours,
+    ActualHours,
+    StartDate,
+    EndDate,
+    Level
+};
 
 /**
- * @brief ISO 8601SYSTEMTIME\̂ɕϊ
- * 
- * @param str ϊΏۂISO 8601`
- * @return ϊꂽSYSTEMTIME\
- * 
- * XMLǂݍ񂾓AWindows APIŎgp\
- * SYSTEMTIME\̂ɕϊ܂BSystemTimeToString()̋tϊłB
- * 
- * @details ͌`v:
- * - ŏ: 19 ("YYYY-MM-DDTHH:MM:SS")
- * - ؂蕶: nCtATARʒuɂ邱
- * - l͈: etB[hLȔ͈͓ł邱
- * 
- * @note G[:
- * - 񂪒Zꍇ: ݂̃VXeԂ
- * - p[XG[̏ꍇ: ݂̃VXeԂitH[obNj
- * - ȓt̏ꍇ: ̂܂ܐݒiĂяoŌ؁j
- * 
- * @warning wDayOfWeektB[h͐ݒ肳܂iVXevZj
+ * @brief 現在の開始タグ名からタスクフィールド種別を判定
+ *
+ * @param reader StartElement を返した直後のリーダー（WBSBasicXmlReader）
+ * @return 対応するフィールド種別、該当しない場合は TaskXmlField::None
  */
-SYSTEMTIME StringToSystemTime(const std::wstring& str) {
-    SYSTEMTIME st = {};
-    
-    if (str.length() >= 19) {
-        // ISO 8601`̃p[X: "YYYY-MM-DDTHH:MM:SS"
-        swscanf_s(str.c_str(), L"%04hu-%02hu-%02huT%02hu:%02hu:%02hu",
-            &st.wYear, &st.wMonth, &st.wDay, &st.wHour, &st.wMinute, &st.wSecond);
-        
-        // wDayOfWeek͐ݒ肵ȂiWindowsvZj
-        st.wMilliseconds = 0; // ~b͏0
-    } else {
-        // p[XG[̃tH[obNFݎԂ
-        GetSystemTime(&st);
+template <typename Reader>
+TaskXmlField ClassifyTaskField(const Reader& reader) {
+    static const struct {
+        const char* name;
+        TaskXmlField field;
+    } fields[] = {
+        {"ID", TaskXmlField::Id},
+        {"Name", TaskXmlField::Name},
+        {"Description", TaskXmlField::Description},
+        {"AssignedTo", TaskXmlField::AssignedTo},
+        {"Status", TaskXmlField::Status},
+        {"Priority", TaskXmlField::Priority},
+        {"EstimatedHours", TaskXmlField::EstimatedHours},
+        {"ActualHours", TaskXmlField::ActualHours},
+        {"StartDate", TaskXmlField::StartDate},
+        {"EndDate", TaskXmlField::EndDate},
+        {"Level", TaskXmlField::Level},
+    };
+
+    for (const auto& entry : fields) {
+        if (reader.NameIs(entry.name)) {
+            return entry.field;
+        }
     }
-    
-    return st;
+    return TaskXmlField::None;
 }
 
-// ============================================================================
-// XML̓[eBeB֐Q  
-// ============================================================================
+/**
+ * @brief XMLエスケープされたUTF-8テキストを復元（WBSTextStore の復元関数）
+ */
+void DecodeXmlText(std::string& out, const char* first, const char* last) {
+    WBSBasicXmlReader<char>::AppendUnescaped(out, first, last);
+}
 
 /**
- * @brief XMLw^O̒l𒊏o
- * 
- * @param xml ΏۂXML
- * @param tag oΏۂ̃^OiJnEI^O̖Ô݁j
- * @param startPos JnʒuiftHg: 0j
- * @return oꂽliGXP[vς݁jAȂꍇ͋󕶎
- * 
- * XMLP̗vfl𒊏oėp֐łB
- * KwIXMLp[X̊{Iȍ\vfƂĎgp܂B
- * 
- * @details t[:
- * 1. Jn^O "<tag>" 
- * 2. ΉI^O "</tag>"   
- * 3. ^OԂ̃eLXg𒊏o
- * 4. XmlUnescape() ŃGeBeB𕜌
- * 5. ʕԂ
- * 
- * @note lXg^O͍l܂iŏɌI^Ogpj
- *       GȃlXg\̏ꍇ́Ap̃p[T[֐Kv
- * 
- * @warning ^Oɋ󔒕ꕶ܂܂ĂĂ͂܂
- * 
- * @example 
- * ExtractXmlValue(L"<Name>vWFNg</Name>", L"Name")  L"vWFNg"
- * ExtractXmlValue(L"<Data><Name>l</Name></Data>", L"Name")  L"l"
+ * @brief 数値・日付・説明フィールドの値をWBSアイテムへ反映
+ *
+ * @param item 反映先のWBSアイテム
+ * @param field フィールド種別
+ * @param value エンティティ復元済みのテキスト（説明はエスケープされたままのテキスト）
+ * @return 値の形式が正しい場合true（数値・列挙型が不正な場合false）
+ *
+ * 空文字列の場合は既定値を保持します（旧実装と同じ挙動）。
+ * 日時の形式が正しくない場合は現在時刻とします（旧実装と同じ挙動）。
  */
-std::wstring ExtractXmlValue(const std::wstring& xml, const std::wstring& tag, size_t startPos) {
-    // Jn^OƏI^O\z
-    std::wstring startTag = L"<" + tag + L">";
-    std::wstring endTag = L"</" + tag + L">";
-    
-    // Jn^Öʒu
-    size_t start = xml.find(startTag, startPos);
-    if (start == std::wstring::npos) {
-        return L""; // Jn^OȂ
+bool ApplyTaskScalarField(WBSItem& item, TaskXmlField field, const std::string& value) {
+    if (value.empty()) {
+        return true;
     }
-    
-    // eLXg̊JnʒuvZ
-    start += startTag.length();
-    
-    // I^Öʒu
-    size_t end = xml.find(endTag, start);
-    if (end == std::wstring::npos) {
-        return L""; // I^OȂi\G[j
+
+    const char* first = value.data();
+    const char* last = first + value.size();
+    switch (field) {
+        case TaskXmlField::Description:
+            // 説明は表示されるまで復元しない（エンティティを含まなければそのまま登録）
+            if (memchr(first, '&', value.size())) {
+                item.description.AssignEncoded(first, last, DecodeXmlText);
+            } else {
+                item.description.Assign(first, last);
+            }
+            return true;
+        case TaskXmlField::Id:             item.id.Assign(value); return true;   // 番号の並びへ解析して保持
+        case TaskXmlField::AssignedTo:     item.assignedTo = value; return true; // 担当者名はインターンして保持
+        case TaskXmlField::Status:         return ParseStatusField(first, last, item.status);
+        case TaskXmlField::Priority:       return ParsePriorityField(first, last, item.priority);
+        case TaskXmlField::EstimatedHours: return ParseDoubleField(first, last, item.estimatedHours);
+        case TaskXmlField::ActualHours:    return ParseDoubleField(first, last, item.actualHours);
+        case TaskXmlField::Level:          return ParseIntField(first, last, item.level);
+        case TaskXmlField::StartDate:
+            if (!ParseDateField(first, last, item.startDate)) item.startDate = WBSDateTime::Now();
+            return true;
+        case TaskXmlField::EndDate:
+            if (!ParseDateField(first, last, item.endDate)) item.endDate = WBSDateTime::Now();
+            return true;
+        default:
+            return true;
     }
-    
-    // ^OԂ̃eLXg𒊏oăGXP[v
-    return XmlUnescape(xml.substr(start, end - start));
 }
 
-// ============================================================================
-// WBSf[^VAC[[V֐Q
-// ============================================================================
+/**
+ * @brief <Task>要素内の子タスク1件分の範囲（リーダー先頭からの文字数）
+ *
+ * begin は子タスクの <Task> 開始タグの直後、end は対応する </Task> の直後です。
+ */
+struct TaskXmlRange {
+    size_t begin;
+    size_t end;
+};
 
 /**
- * @brief WBSACeXML`ɕϊiċAIj
- * 
- * @param item ϊΏۂWBSACe
- * @param indent Cfgxi`pAftHg: 0j
- * @return XML`̕
- * 
- * PWBSACeƂ̑SĂ̎qvfA\ꂽXML`ɕϊ܂B
- * Kw\ێ邽߁AċAIɎqvf܂B
- * 
- * @details oXML\:
- * <Task>
- *   <ID>^XNID</ID>
- *   <Name>^XN</Name>
- *   <Description></Description>
- *   <AssignedTo>S</AssignedTo>
- *   <Status>Ԓl</Status>
- *   <Priority>Dxl</Priority>
- *   <EstimatedHours>ςH</EstimatedHours>
- *   <ActualHours>эH</ActualHours>
- *   <StartDate>Jn</StartDate>
- *   <EndDate>I</EndDate>
- *   <Level>Kwx</Level>
- *   <Children>
- *     <!-- q^XNċAIɓWJ -->
- *   </Children>
- * </Task>
- * 
- * @note ptH[}Xl:
- * - A̍œKistd::wstring  += Zqj
- * - Cfgp󔒂̎OvZ
- * - qvf̗L`FbNɂsvȃ^O
- * 
- * @param indent Cfgxi2 ~ x̋󔒂}j
- *               ǐ̍XMLt@C𐶐邽
+ * @brief 遅延読み込みの設定（ParseTaskElement() に渡す）
+ *
+ * depthLimit より深い <Children> 要素は構築せず、読み込み元での範囲と
+ * 範囲内のタスクの集計値を WBSItem::deferredChildren に記録して読み飛ばします。
  */
-std::wstring WBSItemToXml(std::shared_ptr<WBSItem> item, int indent) {
-    if (!item) {
-        return L""; // nullptr`FbNFSm
-    }
-    
-    // Cfg𐶐iǐj
-    std::wstring indentStr(indent * 2, L' ');
-    std::wstring xml;
-    
-    // ^XNJn^O
-    xml += indentStr + L"<Task>\n";
-    
-    // {tB[h̃VAC[[V
-    xml += indentStr + L"  <ID>" + XmlEscape(item->id) + L"</ID>\n";
-    xml += indentStr + L"  <Name>" + XmlEscape(item->taskName) + L"</Name>\n";
-    xml += indentStr + L"  <Description>" + XmlEscape(item->description) + L"</Description>\n";
-    xml += indentStr + L"  <AssignedTo>" + XmlEscape(item->assignedTo) + L"</AssignedTo>\n";
-    
-    // 񋓌^̐lϊi^SƍۉΉj
-    xml += indentStr + L"  <Status>" + std::to_wstring((int)item->status) + L"</Status>\n";
-    xml += indentStr + L"  <Priority>" + std::to_wstring((int)item->priority) + L"</Priority>\n";
-    
-    // _l̕ϊ
-    xml += indentStr + L"  <EstimatedHours>" + std::to_wstring(item->estimatedHours) + L"</EstimatedHours>\n";
-    xml += indentStr + L"  <ActualHours>" + std::to_wstring(item->actualHours) + L"</ActualHours>\n";
-    
-    // f[^̕ϊ
-    xml += indentStr + L"  <StartDate>" + SystemTimeToString(item->startDate) + L"</StartDate>\n";
-    xml += indentStr + L"  <EndDate>" + SystemTimeToString(item->endDate) + L"</EndDate>\n";
-    
-    // Kw
-    xml += indentStr + L"  <Level>" + std::to_wstring(item->level) + L"</Level>\n";
-    
-    // qvf̏iċAIj
-    if (!item->children.empty()) {
-        xml += indentStr + L"  <Children>\n";
-        
-        // SĂ̎qvfċAIɃVACY
-        for (const auto& child : item->children) {
-            xml += WBSItemToXml(child, indent + 2); // Cfgx𑝉
+struct TaskXmlDeferral {
+    std::shared_ptr<WBSDeferredChildSource> source; ///< 範囲を後で解析する読み込み元
+    size_t baseOffset = 0;                          ///< リーダー先頭の読み込み元での位置
+    size_t depthLimit = 0;                          ///< 構築する階層数（解析するタスク自身は0）
+};
+
+/**
+ * @brief <Children>要素をタスクを構築せずに走査し、含まれるタスクの集計値を求める
+ *
+ * @param reader <Children> の StartElement を返した直後のリーダー（WBSBasicXmlReader）
+ * @param rollup 集計値の加算先
+ * @return 対応する終了タグまで走査できた場合true（構文エラー・数値の形式エラーはfalse）
+ *
+ * 遅延読み込みで読み飛ばす範囲の合計を WBSDeferredChildren::rollup へ記録し、
+ * 合計の表示のために子タスクを構築しなくて済むようにします。
+ * 状態と工数のフィールドだけを変換し、その他のテキストは読み捨てます。
+ */
+template <typename Reader>
+bool ScanTaskRollup(Reader& reader, WBSRollup& rollup) {
+    const int endDepth = reader.Depth() - 1;        // </Children> の後の深さ
+    std::vector<TaskStatus> statuses;               // 開いている <Task> ごとの状態
+    TaskXmlField field = TaskXmlField::None;        // 現在読み取り中のフィールド
+    int fieldDepth = 0;                             // フィールド要素の深さ
+    std::string value;                              // フィールド値の再利用バッファ
+
+    while (true) {
+        switch (reader.Next()) {
+            case WBSXmlToken::StartElement:
+                if (field != TaskXmlField::None) {
+                    break; // フィールド内の想定外の要素は無視
+                }
+                if (reader.NameIs("Task")) {
+                    statuses.push_back(TaskStatus::NOT_STARTED);
+                    break;
+                }
+                field = ClassifyTaskField(reader);
+                if (field == TaskXmlField::None) {
+                    break; // <Children> 等は中へ進む
+                }
+                if (statuses.empty() || (field != TaskXmlField::Status &&
+                    field != TaskXmlField::EstimatedHours && field != TaskXmlField::ActualHours)) {
+                    // 集計に使わないフィールド（説明等）は中身を字句解析せずに読み飛ばす
+                    field = TaskXmlField::None;
+                    if (!reader.SkipElement()) {
+                        return false;
+                    }
+                    break;
+                }
+                fieldDepth = reader.Depth();
+                value.clear();
+                break;
+
+            case WBSXmlToken::Text:
+                if (field != TaskXmlField::None) {
+                    reader.AppendText(value);
+                }
+                break;
+
+            case WBSXmlToken::EndElement:
+                if (field != TaskXmlField::None) {
+                    if (reader.Depth() < fieldDepth) {
+                        const char* first = value.data();
+                        const char* last = first + value.size();
+                        double hours = 0.0;
+                        bool valid = value.empty() ||
+                            (field == TaskXmlField::Status ? ParseStatusField(first, last, statuses.back())
+                                                           : ParseDoubleField(first, last, hours));
+                        if (!valid) {
+                            return false;
+                        }
+                        if (field == TaskXmlField::EstimatedHours) rollup.estimatedHours += hours;
+                        if (field == TaskXmlField::ActualHours) rollup.actualHours += hours;
+                        field = TaskXmlField::None;
+                    }
+                } else if (reader.NameIs("Task") && !statuses.empty()) {
+                    int index = static_cast<int>(statuses.back());
+                    statuses.pop_back();
+                    ++rollup.taskCount;
+                    if (index >= 0 && index < kTaskStatusCount) {
+                        ++rollup.statusCounts[index];
+                    }
+                }
+                if (reader.Depth() <= endDepth) {
+                    return statuses.empty();
+                }
+                break;
+
+            case WBSXmlToken::End:
+            case WBSXmlToken::Error:
+                return false; // 閉じられていない要素、または構文エラー
         }
-        
-        xml += indentStr + L"  </Children>\n";
     }
-    
-    // ^XNI^O
-    xml += indentStr + L"</Task>\n";
-    
-    return xml;
 }
 
 /**
- * @brief vWFNgŜXMLɕϊ
- * 
- * @return SXML
- * 
- * ݂WBSvWFNgŜAXML錾܂ފSXMLɕϊ܂B
- * t@CۑɎgpŏʃx̃VAC[[V֐łB
- * 
- * @details oXML\:
- * <?xml version="1.0" encoding="UTF-8"?>
- * <WBSProject>
- *   <ProjectName>vWFNg</ProjectName>
- *   <Description>vWFNg</Description>
- *   <RootTask>
- *     <!-- WBSItemToXml()̏o -->
- *   </RootTask>
- * </WBSProject>
- * 
- * @note G[:
- * - g_currentProject  nullptr ̏ꍇ: 󕶎Ԃ
- * - vWFNgf[^sSȏꍇ: p\ȕ݂̂o
- * 
- * @warning ̊֐͊Oˑ֌Wig_currentProjectjɈˑ܂
- *          P̃eXgsꍇ́AK؂ȃbNKv
+ * @brief <Task>要素をWBSアイテムの木として構築（単一パス）
+ *
+ * @param reader <Task> の StartElement を返した直後のリーダー（WBSBasicXmlReader）
+ * @param arena タスクの確保元のアリーナ（nullptr の場合は汎用ヒープ）
+ * @param deferredChildren nullptr以外の場合、直下の子タスクは構築せずに
+ *                         範囲だけを記録して読み飛ばす（並列解析用）
+ * @param deferral nullptr以外の場合、指定の階層より深い子タスクは構築せずに
+ *                 範囲だけを記録して読み飛ばす（遅延読み込み用）
+ * @return 構築されたWBSアイテム、構文エラーの場合はnullptr
+ *
+ * 再帰呼び出しや部分文字列の切り出しを行わず、祖先タスクのスタックを
+ * 使って入力を一度だけ前方へ走査します。<Children> 内の入れ子の </Task> も
+ * 要素の深さで正しく対応付けられます。
+ *
+ * @details 処理フロー:
+ * 1. <Task> 開始タグで新しいアイテムを作成し、スタック先頭の子として追加
+ * 2. フィールド開始タグで格納先を決定
+ * 3. テキストトークンを格納先へ直接追加（文字列フィールド）
+ *    またはバッファへ追加（数値・日付フィールド、エスケープされたままの説明）
+ * 4. フィールド終了タグで数値・日付を変換し、説明を登録
+ * 5. </Task> でスタックから取り除き、空になったら完了
+ *
+ * @note 計算量: 入力長に対して線形（木の深さに依存しない）
  */
-std::wstring ProjectToXml() {
-    if (!g_currentProject) {
-        return L""; // vWFNg݂Ȃꍇ̈Sȏ
+template <typename Reader>
+std::shared_ptr<WBSItem> ParseTaskElement(Reader& reader, const std::shared_ptr<WBSArena>& arena,
+                                          std::vector<TaskXmlRange>* deferredChildren = nullptr,
+                                          const TaskXmlDeferral* deferral = nullptr) {
+    std::vector<std::shared_ptr<WBSItem>> stack;    // 祖先タスクのスタック
+    TaskXmlField field = TaskXmlField::None;        // 現在読み取り中のフィールド
+    int fieldDepth = 0;                             // フィールド要素の深さ
+    std::string* target = nullptr;                  // 文字列フィールドの格納先
+    std::string value;                              // 数値・日付フィールドの再利用バッファ
+
+    auto root = WBSItem::Create(arena);
+    root->taskName.clear();
+    stack.push_back(root);
+
+    while (true) {
+        switch (reader.Next()) {
+            case WBSXmlToken::StartElement:
+                if (field != TaskXmlField::None) {
+                    break; // フィールド内の想定外の要素は無視
+                }
+                if (reader.NameIs("Task")) {
+                    if (deferredChildren && stack.size() == 1) {
+                        // 直下の子タスク: 構造だけを走査して範囲を記録
+                        TaskXmlRange range;
+                        range.begin = reader.Position();
+                        if (!reader.SkipElement()) {
+                            return nullptr;
+                        }
+                        range.end = reader.Position();
+                        deferredChildren->push_back(range);
+                        break;
+                    }
+                    // 子タスクの開始: 親子関係を設定してスタックへ積む
+                    auto child = WBSItem::Create(arena);
+                    child->taskName.clear();
+                    child->parent = stack.back();
+                    stack.back()->children.push_back(child);
+                    stack.push_back(child);
+                    break;
+                }
+                if (deferral && stack.size() > deferral->depthLimit && reader.NameIs("Children")) {
+                    // 指定の階層より深い子タスク: 範囲と集計値だけを記録して読み飛ばす
+                    auto deferred = std::make_shared<WBSDeferredChildren>();
+                    deferred->source = deferral->source;
+                    deferred->begin = deferral->baseOffset + reader.Position();
+                    if (!ScanTaskRollup(reader, deferred->rollup)) {
+                        return nullptr;
+                    }
+                    deferred->end = deferral->baseOffset + reader.Position();
+                    stack.back()->deferredChildren = deferred;
+                    break;
+                }
+
+                field = ClassifyTaskField(reader);
+                fieldDepth = reader.Depth();
+                value.clear();
+                switch (field) {
+                    case TaskXmlField::Name:        target = &stack.back()->taskName; break;
+                    default:                        target = &value; break;
+                }
+                target->clear();
+                break;
+
+            case WBSXmlToken::Text:
+                if (field == TaskXmlField::Description) {
+                    reader.AppendEscapedText(*target);
+                } else if (field != TaskXmlField::None) {
+                    reader.AppendText(*target);
+                }
+                break;
+
+            case WBSXmlToken::EndElement:
+                if (field != TaskXmlField::None) {
+                    if (reader.Depth() < fieldDepth) {
+                        if (!ApplyTaskScalarField(*stack.back(), field, value)) {
+                            return nullptr; // 数値・列挙型の形式エラー
+                        }
+                        field = TaskXmlField::None;
+                        target = nullptr;
+                    }
+                } else if (reader.NameIs("Task")) {
+                    stack.pop_back();
+                    if (stack.empty()) {
+                        return root; // 最上位の </Task> に到達
+                    }
+                }
+                break;
+
+            case WBSXmlToken::End:
+            case WBSXmlToken::Error:
+                return nullptr; // 閉じられていない要素、または構文エラー
+        }
     }
-    
-    std::wstring xml;
-    
-    // XML錾FGR[fBO̖
-    xml += L"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
-    
-    // [gvfJn
-    xml += L"<WBSProject>\n";
-    
-    // vWFNg^f[^
-    xml += L"  <ProjectName>" + XmlEscape(g_currentProject->projectName) + L"</ProjectName>\n";
-    xml += L"  <Description>" + XmlEscape(g_currentProject->description) + L"</Description>\n";
-    
-    // [g^XNƂ̊Kw\
-    xml += L"  <RootTask>\n";
-    xml += WBSItemToXml(g_currentProject->rootTask, 2); // Cfgx2Jn
-    xml += L"  </RootTask>\n";
-    
-    // [gvfI
-    xml += L"</WBSProject>\n";
-    
-    return xml;
 }
 
-// ============================================================================
-// XMLfVAC[[V֐Q
-// ============================================================================
+const size_t kParallelParseMinChars = 1024 * 1024;  ///< これ未満の子タスク群は並列化しない
 
 /**
- * @brief XML񂩂WBSACéiċAIj
- * 
- * @param xml ͑ΏۂXML
- * @param pos ͊JnʒuiQƓnF͌̈ʒuݒ肳j
- * @return ͂ꂽWBSACeAG[̏ꍇnullptr
- * 
- * XML񂩂P<Task>vf͂AΉWBSItemIuWFNg\z܂B
- * qvf݂ꍇ́AċAIɏĊSȊKw\𕜌܂B
- * 
- * @details ̓vZX:
- * 1. <Task>Jn^Ǒ
- * 2. </Task>I^Ǒ
- * 3. ^XNvf̒o
- * 4. etB[h̃p[Xƃf[^^ϊ
- * 5. qvf̍ċAI
- * 6. eq֌W̐ݒ
- * 
- * @note f[^^ϊ:
- * - tB[h: ExtractXmlValue() + XmlUnescape()
- * - 񋓌^: std::stoi() + LXg
- * - _: std::stod()
- * - : StringToSystemTime()
- * - : std::stoi()
- * 
- * @warning ptH[}Xl:
- * - 傫ȃvWFNgt@C̏ꍇAċA̐[ɒ
- * - gpʂ͊Kw̐[ƃ^XNɔ
- * 
- * @param pos ͈ʒuio̓p[^j
- *            : ͊Jnʒu
- *            o: ̗vf̉͊Jnʒu
+ * @brief 子タスクの範囲を並列に解析してルートタスクへ追加
+ *
+ * @tparam CharT 入力の文字型（wchar_t またはUTF-8の char）
+ * @param first ルートタスクを解析したリーダーの入力先頭
+ * @param ranges ParseTaskElement() が記録した直下の子タスクの範囲（文書順）
+ * @param root 子タスクの追加先
+ * @return 全ての子タスクを解析できた場合true
+ *
+ * 各範囲は独立した WBSBasicXmlReader で ParseTaskElement() により解析するため、
+ * 結果は逐次解析と同一です。範囲は大きい順にワーカースレッドへ割り当て
+ * （大きな部分木が最後に残って待たされないように）、解析後に元の順序で接続します。
+ * アリーナの排他制御で競合しないよう、各スレッドは自身のアリーナにタスクを確保します
+ * （各アリーナは確保したタスクから共有され、最後のタスクと共に解放されます）。
+ *
+ * @note 範囲の合計が kParallelParseMinChars 未満、または範囲が1件以下の場合は
+ *       呼び出し元のスレッドだけで解析します。
  */
-std::shared_ptr<WBSItem> ParseTaskFromXml(const std::wstring& xml, size_t& pos) {
-    // <Task>Jn^Ǒ
-    size_t taskStart = xml.find(L"<Task>", pos);
-    if (taskStart == std::wstring::npos) {
-        return nullptr; // ^XNvfȂ
+template <typename CharT>
+bool ParseTaskRangesParallel(const CharT* first, const std::vector<TaskXmlRange>& ranges, WBSItem& root) {
+    std::vector<std::shared_ptr<WBSItem>> results(ranges.size());
+
+    // 割り当て順: 大きい部分木から
+    std::vector<size_t> order(ranges.size());
+    size_t totalChars = 0;
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        order[i] = i;
+        totalChars += ranges[i].end - ranges[i].begin;
     }
-    
-    // </Task>I^Ǒ
-    size_t taskEnd = xml.find(L"</Task>", taskStart);
-    if (taskEnd == std::wstring::npos) {
-        return nullptr; // \G[FI^OȂ
+    std::sort(order.begin(), order.end(), [&ranges](size_t a, size_t b) {
+        return ranges[a].end - ranges[a].begin > ranges[b].end - ranges[b].begin;
+    });
+
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::atomic<bool> failed(false);
+    auto work = [&]() {
+        try {
+            auto arena = std::make_shared<WBSArena>();
+            for (size_t n = next++; n < order.size() && !failed; n = next++) {
+                const TaskXmlRange& range = ranges[order[n]];
+                WBSBasicXmlReader<CharT> reader(first + range.begin, first + range.end);
+                results[order[n]] = ParseTaskElement(reader, arena);
+                if (!results[order[n]]) {
+                    failed = true;
+                }
+            }
+        } catch (...) {
+            // 数値変換エラー等は呼び出し元のスレッドで再送出する
+            if (!failed.exchange(true)) {
+                error = std::current_exception();
+            }
+        }
+    };
+
+    // ワーカースレッドの起動（呼び出し元のスレッドも1つ分として働く）
+    size_t threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+    if (totalChars < kParallelParseMinChars) {
+        threadCount = 1;
     }
-    
-    // ^XNvfŜ𒊏o
-    std::wstring taskXml = xml.substr(taskStart, taskEnd - taskStart + 7);
-    pos = taskEnd + 7; // ͈̉ʒuXV
-    
-    // VWBSItemCX^X쐬
-    auto item = std::make_shared<WBSItem>();
-    
-    // {tB[h̉
-    item->id = ExtractXmlValue(taskXml, L"ID", 0);
-    item->taskName = ExtractXmlValue(taskXml, L"Name", 0);
-    item->description = ExtractXmlValue(taskXml, L"Description", 0);
-    item->assignedTo = ExtractXmlValue(taskXml, L"AssignedTo", 0);
-    
-    // 񋓌^tB[h̉́iG[nhOtj
-    std::wstring statusStr = ExtractXmlValue(taskXml, L"Status", 0);
-    if (!statusStr.empty()) {
-        item->status = (TaskStatus)std::stoi(statusStr);
+    threadCount = std::min(threadCount, ranges.size());
+
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) {
+        try {
+            workers.emplace_back(work);
+        } catch (...) {
+            break; // スレッドを作成できなければ起動済みのスレッドだけで続行
+        }
     }
-    
-    std::wstring priorityStr = ExtractXmlValue(taskXml, L"Priority", 0);
-    if (!priorityStr.empty()) {
-        item->priority = (TaskPriority)std::stoi(priorityStr);
+    work();
+    for (auto& worker : workers) {
+        worker.join();
     }
-    
-    // ltB[h̉́iG[nhOtj
-    std::wstring estimatedStr = ExtractXmlValue(taskXml, L"EstimatedHours", 0);
-    if (!estimatedStr.empty()) {
-        item->estimatedHours = std::stod(estimatedStr);
+
+    if (error) {
+        std::rethrow_exception(error);
     }
-    
-    std::wstring actualStr = ExtractXmlValue(taskXml, L"ActualHours", 0);
-    if (!actualStr.empty()) {
-        item->actualHours = std::stod(actualStr);
+    if (failed) {
+        return false;
     }
-    
-    // tB[h̉
-    std::wstring startDateStr = ExtractXmlValue(taskXml, L"StartDate", 0);
-    if (!startDateStr.empty()) {
-        item->startDate = StringToSystemTime(startDateStr);
+
+    // 文書順に接続
+    auto parent = root.shared_from_this();
+    root.children.reserve(root.children.size() + results.size());
+    for (auto& child : results) {
+        child->parent = parent;
+        root.children.push_back(std::move(child));
     }
-    
-    std::wstring endDateStr = ExtractXmlValue(taskXml, L"EndDate", 0);
-    if (!endDateStr.empty()) {
-        item->endDate = StringToSystemTime(endDateStr);
+    return true;
+}
+
+/**
+ * @brief <WBSProject> 文書の要素を読み取りプロジェクトを構築（単一パス）
+ *
+ * @tparam Reader WBSBasicXmlReader または WBSChunkedXmlReader
+ * @tparam RootTaskParser <Task> の StartElement を返した直後のリーダーを受け取り、
+ *                        ルートタスクを返す関数（構文エラーの場合はnullptr）
+ * @param reader 文書の先頭に位置するリーダー
+ * @param arena parseRoot がタスクの構築に使用するアリーナ（プロジェクトが所有する）
+ * @param parseRoot ルートタスクの解析方法（並列・遅延・逐次）
+ * @return 構築されたプロジェクト、構文エラーの場合はnullptr
+ *
+ * <WBSProject> 直下の <ProjectName>、<Description>、<RootTask> を
+ * 一度の前方走査で読み取ります。ルートタスクの名前はプロジェクト名に
+ * 統一されます。
+ */
+template <typename Reader, typename RootTaskParser>
+std::unique_ptr<WBSProject> ParseProjectElements(Reader& reader, const std::shared_ptr<WBSArena>& arena,
+                                                 RootTaskParser parseRoot) {
+    std::string projectName;
+    std::string description;
+    std::string* target = nullptr;                  // 現在のメタデータ格納先
+    std::shared_ptr<WBSItem> rootTask;
+    bool inRootTask = false;
+
+    while (true) {
+        WBSXmlToken token = reader.Next();
+        if (token == WBSXmlToken::End) {
+            break;
+        }
+        if (token == WBSXmlToken::Error) {
+            return nullptr;
+        }
+
+        switch (token) {
+            case WBSXmlToken::StartElement:
+                if (reader.Depth() == 2) {
+                    // <WBSProject> 直下のメタデータ
+                    if (reader.NameIs("ProjectName")) target = &projectName;
+                    else if (reader.NameIs("Description")) target = &description;
+                    else if (reader.NameIs("RootTask")) inRootTask = true;
+                } else if (reader.Depth() == 3 && inRootTask && !rootTask && reader.NameIs("Task")) {
+                    rootTask = parseRoot(reader);
+                    if (!rootTask) {
+                        return nullptr;
+                    }
+                }
+                break;
+
+            case WBSXmlToken::Text:
+                if (target) {
+                    reader.AppendText(*target);
+                }
+                break;
+
+            case WBSXmlToken::EndElement:
+                target = nullptr;
+                if (reader.Depth() == 1) {
+                    inRootTask = false;
+                }
+                break;
+
+            default:
+                break;
+        }
     }
-    
-    // Kwx̉
-    std::wstring levelStr = ExtractXmlValue(taskXml, L"Level", 0);
-    if (!levelStr.empty()) {
-        item->level = std::stoi(levelStr);
+
+    // プロジェクト名のバリデーション
+    if (projectName.empty()) {
+        projectName = u8"読み込まれたプロジェクト"; // フォールバック名
+    }
+
+    auto project = std::make_unique<WBSProject>(projectName, arena);
+    project->description = description;
+
+    if (rootTask) {
+        // ルートタスクの名前をプロジェクト名と統一
+        rootTask->taskName = projectName;
+        project->rootTask = rootTask;
+    }
+
+    return project;
+}
+
+/**
+ * @brief XML文書全体からプロジェクトを構築（単一パス）
+ *
+ * @tparam CharT 入力の文字型（wchar_t またはUTF-8の char）
+ * @param first XML文書の先頭
+ * @param last XML文書の終端
+ * @param arena プロジェクトが所有するアリーナ（遅延読み込みでは読み込み元と共有する）
+ * @return 構築されたプロジェクト、構文エラーの場合はnullptr
+ *
+ * ルートタスク直下の子タスク（フェーズ）は構造の走査で範囲だけを求め、
+ * ParseTaskRangesParallel() で並列に解析してから元の順序で接続します。
+ *
+ * @param deferral nullptr以外の場合は遅延読み込み: ルートタスクから
+ *                 deferral->depthLimit 階層までだけを構築します（並列解析は行わない）
+ */
+template <typename CharT>
+std::unique_ptr<WBSProject> ParseProjectFromXml(const CharT* first, const CharT* last,
+                                                const std::shared_ptr<WBSArena>& arena,
+                                                const TaskXmlDeferral* deferral = nullptr) {
+    WBSBasicXmlReader<CharT> reader(first, last);
+    return ParseProjectElements(reader, arena, [first, &arena, deferral](WBSBasicXmlReader<CharT>& reader) {
+        if (deferral) {
+            // 構築するのは浅い階層だけのため、構造の走査と同時に1パスで解析
+            return ParseTaskElement(reader, arena, nullptr, deferral);
+        }
+        std::vector<TaskXmlRange> phases;
+        auto rootTask = ParseTaskElement(reader, arena, &phases);
+        if (!rootTask || !ParseTaskRangesParallel(first, phases, *rootTask)) {
+            return std::shared_ptr<WBSItem>();
+        }
+        return rootTask;
+    });
+}
+
+// ============================================================================
+// ファイルI/O操作関数群
+// ============================================================================
+
+/**
+ * @brief wifstream 経由でXMLファイルを読み込み（互換経路）
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @return ファイルを開けた場合true
+ *
+ * std::codecvt_utf8 による1文字ずつの変換を行う従来の読み込み経路です。
+ * メモリマップできないファイルや、UTF-8として不正なファイルの読み込みに使用します。
+ */
+bool ReadProjectXmlCompat(const std::wstring& filePath, std::unique_ptr<WBSProject>& project) {
+    // ファイルストリームを開く（Unicode対応）
+    std::wifstream file(filePath);
+    if (!file.is_open()) {
+        return false; // ファイルオープンエラー
     }
     
-    // qvf̍ċAI
-    size_t childrenStart = taskXml.find(L"<Children>");
-    if (childrenStart != std::wstring::npos) {
-        size_t childrenEnd = taskXml.find(L"</Children>");
-        if (childrenEnd != std::wstring::npos) {
-            // qvf͈͂XML𒊏o
-            std::wstring childrenXml = taskXml.substr(childrenStart + 10, childrenEnd - childrenStart - 10);
-            
-            // SĂ̎q^XNċAIɉ
-            size_t childPos = 0;
+    // UTF-8エンコーディングの設定
+    file.imbue(std::locale(file.getloc(), new std::codecvt_utf8<wchar_t>));
+    
+    // ファイル全体を文字列として読み込み
+    std::wstring xmlContent((std::istreambuf_iterator<wchar_t>(file)),
+                          std::istreambuf_iterator<wchar_t>());
+    file.close();
+    
+    project = ParseProjectFromXml(xmlContent.data(), xmlContent.data() + xmlContent.size(), std::make_shared<WBSArena>());
+    return true;
+}
+
+const size_t kLazyLoadMinBytes = 4 * 1024 * 1024;  ///< これ未満のファイルは遅延読み込みしない
+
+/**
+ * @brief メモリマップしたXMLから子タスクを遅延読み込みする読み込み元
+ *
+ * マップはこのオブジェクトが所有し、未構築の範囲（WBSDeferredChildren）が
+ * 1つでも残っている間は保持されます。すべて構築されるとマップも解放されます。
+ * 構築した子タスクは、読み込み時のプロジェクトのアリーナに確保します。
+ */
+class XmlDeferredChildSource : public WBSDeferredChildSource,
+                               public std::enable_shared_from_this<XmlDeferredChildSource> {
+public:
+    /**
+     * @param file マップ済みのXMLファイル
+     * @param first 解析範囲の先頭（BOMの直後）。範囲のオフセットはここを基準とする
+     * @param arena 子タスクの確保元のアリーナ
+     */
+    XmlDeferredChildSource(std::unique_ptr<WBSMappedFile> file, const char* first, std::shared_ptr<WBSArena> arena)
+        : file_(std::move(file)), first_(first), arena_(std::move(arena)) {}
+
+    /**
+     * @brief <Children> の内容（終了タグまで）を解析して直下の子タスクを構築
+     *
+     * 構築した子タスクのさらに下の <Children> は、再び範囲だけを記録します。
+     */
+    bool LoadChildren(WBSItem& parent, size_t begin, size_t end) override {
+        try {
+            TaskXmlDeferral deferral;
+            deferral.source = shared_from_this();
+            deferral.baseOffset = begin;
+            deferral.depthLimit = 0;
+
+            WBSUtf8XmlReader reader(first_ + begin, first_ + end);
+            std::vector<std::shared_ptr<WBSItem>> loaded;
             while (true) {
-                auto child = ParseTaskFromXml(childrenXml, childPos);
-                if (!child) break; // qvfȂA܂͉͊
-                
-                // eq֌W̐ݒ
-                child->parent = item;
-                item->children.push_back(child);
+                WBSXmlToken token = reader.Next();
+                if (token == WBSXmlToken::End || token == WBSXmlToken::EndElement) {
+                    break; // </Children> に到達
+                }
+                if (token == WBSXmlToken::Error) {
+                    return false;
+                }
+                if (token == WBSXmlToken::StartElement) {
+                    if (!reader.NameIs("Task")) {
+                        if (!reader.SkipElement()) return false;
+                        continue;
+                    }
+                    auto child = ParseTaskElement(reader, arena_, nullptr, &deferral);
+                    if (!child) {
+                        return false;
+                    }
+                    loaded.push_back(child);
+                }
+            }
+
+            auto self = parent.shared_from_this();
+            parent.children.reserve(parent.children.size() + loaded.size());
+            for (auto& child : loaded) {
+                child->parent = self;
+                parent.children.push_back(std::move(child));
+            }
+            return true;
+        } catch (...) {
+            return false; // 数値変換エラー・メモリ不足等
+        }
+    }
+
+private:
+    std::unique_ptr<WBSMappedFile> file_;   ///< マップしたXMLファイル
+    const char* first_;                     ///< 解析範囲の先頭
+    std::shared_ptr<WBSArena> arena_;       ///< 子タスクの確保元
+};
+
+/**
+ * @brief XMLファイルをメモリマップして読み込み
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @param lazyDepth 遅延読み込みで構築する階層数（0の場合はすべて構築）
+ * @return ファイルを開けた場合true
+ *
+ * ファイルをメモリマップし、UTF-8のまま WBSUtf8XmlReader で解析します。
+ * テキスト要素の内容はUTF-8のまま内部文字列へコピーされ（エンティティのみ復元）、
+ * wchar_t への変換は一切行われません。
+ *
+ * @details 処理フロー:
+ * 1. ファイルのメモリマップ
+ * 2. UTF-8 BOM の読み飛ばし
+ * 3. IsValidUtf8() による検証（ASCII部分はSIMDで一括判定）
+ * 4. ParseProjectFromXml() による単一パス解析
+ *
+ * kLazyLoadMinBytes 以上のファイルで lazyDepth が1以上の場合は、ルートタスクから
+ * lazyDepth 階層までだけを構築し、それより深い <Children> は範囲だけを記録します
+ * （遅延読み込み）。範囲が残っている間はマップを保持するため、同じファイルへの
+ * 全体保存の前には WBSProject::LoadDeferredTasks() で残りを構築します。
+ *
+ * @note メモリマップに失敗した場合や、UTF-8として不正なバイト列を含む場合は
+ *       ReadProjectXmlCompat()（wifstream 経路）へフォールバックします。
+ */
+bool ReadProjectXmlFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project, int lazyDepth) {
+    {
+        auto file = std::make_unique<WBSMappedFile>(filePath);
+        if (file->IsOpen()) {
+            const char* first = file->Data();
+            const char* last = first + file->Size();
+            
+            // UTF-8 BOM の読み飛ばし
+            if (last - first >= 3 && memcmp(first, "\xEF\xBB\xBF", 3) == 0) {
+                first += 3;
+            }
+            
+            if (IsValidUtf8(first, last - first)) {
+                auto arena = std::make_shared<WBSArena>();
+                if (lazyDepth > 0 && file->Size() >= kLazyLoadMinBytes) {
+                    // マップの所有権を読み込み元へ移し、浅い階層だけを構築
+                    TaskXmlDeferral deferral;
+                    deferral.source = std::make_shared<XmlDeferredChildSource>(std::move(file), first, arena);
+                    deferral.depthLimit = static_cast<size_t>(lazyDepth);
+                    project = ParseProjectFromXml(first, last, arena, &deferral);
+                } else {
+                    project = ParseProjectFromXml(first, last, arena);
+                }
+                return true;
             }
         }
     }
     
-    return item;
+    // マップできない、またはUTF-8として不正な場合は互換経路で読み込む
+    return ReadProjectXmlCompat(filePath, project);
 }
 
-// ============================================================================
-// t@CI/O֐Q
-// ============================================================================
+/**
+ * @brief 圧縮コンテナ（.wbsz）のXMLファイルを読み込み
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @return ファイルを開けた場合true
+ *
+ * 圧縮されたファイルをメモリマップし、WBSCompressedReader で展開したブロックを
+ * WBSChunkedXmlReader へ順に供給して解析します。展開後の文書全体を
+ * メモリに置かないため、並列解析と遅延読み込みは行いません。
+ * ブロックのハッシュ不一致・展開エラー・途中で切れたファイルは形式エラーとなります。
+ */
+bool ReadProjectCompressedFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project) {
+    WBSMappedFile file(filePath);
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    WBSCompressedReader source(file.Data(), file.Size());
+    WBSChunkedXmlReader<WBSCompressedReader> reader(source);
+    auto arena = std::make_shared<WBSArena>();
+    project = ParseProjectElements(reader, arena, [&arena](WBSChunkedXmlReader<WBSCompressedReader>& reader) {
+        return ParseTaskElement(reader, arena);
+    });
+    if (source.Failed()) {
+        project.reset();
+    }
+    return true;
+}
+
+/**
+ * @brief 圧縮コンテナ（.wbsz）のファイルパスか判定
+ *
+ * @param filePath 判定対象のファイルパス
+ * @return 拡張子が ".wbsz"（大文字小文字を区別しない）の場合true
+ */
+bool IsCompressedProjectPath(const std::wstring& filePath) {
+    const wchar_t extension[] = L".wbsz";
+    const size_t length = sizeof(extension) / sizeof(extension[0]) - 1;
+    return filePath.size() >= length &&
+           _wcsicmp(filePath.c_str() + filePath.size() - length, extension) == 0;
+}
+
+/**
+ * @brief バイナリ形式（.wbsb）のファイルパスか判定
+ * 
+ * @param filePath 判定対象のファイルパス
+ * @return 拡張子が ".wbsb"（大文字小文字を区別しない）の場合true
+ */
+bool IsBinaryProjectPath(const std::wstring& filePath) {
+    const wchar_t extension[] = L".wbsb";
+    const size_t length = sizeof(extension) / sizeof(extension[0]) - 1;
+    return filePath.size() >= length &&
+           _wcsicmp(filePath.c_str() + filePath.size() - length, extension) == 0;
+}
+
+/**
+ * @brief 拡張子に応じた形式でプロジェクトファイルを読み込み
+ *
+ * @param filePath 読み込み対象のファイルパス
+ * @param project 読み込んだプロジェクトの格納先（形式エラーの場合はnullptr）
+ * @param lazyDepth XML形式で遅延読み込みする場合に構築する階層数（0なら全体を構築）
+ * @return ファイルを開けた場合true
+ *
+ * .wbsb はバイナリ形式、.wbsz は圧縮XML形式、.json はJSON形式、
+ * .csv/.tsv はタスク表、それ以外はXML形式として読み込みます。
+ * 編集ジャーナルは適用しません。
+ */
+bool ReadProjectFile(const std::wstring& filePath, std::unique_ptr<WBSProject>& project, int lazyDepth) {
+    char delimiter = GetTaskTableDelimiter(filePath);
+    return IsBinaryProjectPath(filePath) ? ReadProjectBinaryFile(filePath, project)
+        : IsCompressedProjectPath(filePath) ? ReadProjectCompressedFile(filePath, project)
+        : IsJsonProjectPath(filePath) ? ReadProjectJsonFile(filePath, project)
+        : delimiter ? ReadProjectTaskTableFile(filePath, project, delimiter)
+        : ReadProjectXmlFile(filePath, project, lazyDepth);
+}
 
 /**
- * @brief XMLt@CvWFNgǂݍ
+ * @brief XMLファイルからプロジェクトを読み込み
  * 
- * @param filePath ǂݍݑΏۂ̃t@CpX
- * @return ǂݍݐtrueAsfalse
+ * @param filePath 読み込み対象のファイルパス
+ * @return 読み込み成功時true、失敗時false
  * 
- * w肳ꂽXMLt@CWBSvWFNgf[^ǂݍ݁A
- * AvP[V݂̌̃vWFNgԂXV܂B
+ * 指定されたXMLファイルからWBSプロジェクトデータを読み込み、
+ * アプリケーションの現在のプロジェクト状態を更新します。
  * 
- * @details t[:
- * 1. t@CI[vƃGR[fBOݒ
- * 2. XMLȇSǂݍ
- * 3. vWFNg^f[^̒o
- * 4. [g^XN̍ċAI
- * 5. O[oԂ̍XV
- * 6. UIĕ`̎s
- * 7. ݒt@C̍XV
- * 8. [U[ʒm
+ * @details 処理フロー:
+ * 1. WaitForBackgroundSave() による実行中の保存の完了待ち
+ * 2. ReadProjectFile() 経由の ReadProjectXmlFile() によるメモリマップと単一パス解析
+ *    （大きなファイルは GetLazyLoadDepth() 階層までの遅延読み込み）
+ *    （拡張子が .wbsb の場合は ReadProjectBinaryFile()、
+ *     .wbsz の場合は ReadProjectCompressedFile() による逐次展開と解析、
+ *     .json の場合は ReadProjectJsonFile() によるJSON文書の単一パス解析、
+ *     .csv/.tsv の場合は ReadProjectTaskTableFile() による表からの階層の復元）
+ * 3. ApplyProjectJournal() による編集ジャーナルの再生
+ * 4. グローバル状態の更新
+ * 5. UI再描画の実行
+ * 6. 設定ファイルの更新
+ * 7. ユーザー通知
  * 
- * @note GR[fBO:
- * - t@C: UTF-8iXML̕Wj
- * - : UTF-16LEiWindows̕Wj
- * - std::codecvt_utf8 ɂ鎩ϊ
+ * @note エンコーディング処理:
+ * - ファイル: UTF-8（XMLの標準）
+ * - 内部処理: UTF-8（テキスト要素の内容は変換せずにコピー）
+ * - UTF-16 への変換は画面表示時のみ（Utf8ToWide()）
+ * - 不正なUTF-8の場合は std::codecvt_utf8 による互換経路
  * 
- * @warning G[nhO:
- * - t@CANZXG[
- * - XML\G[
- * - f[^^ϊG[
- * - s
- * SĂ̗OLb`falseԂ
+ * @warning エラーハンドリング:
+ * - ファイルアクセスエラー
+ * - XML構文エラー
+ * - データ型変換エラー
+ * - メモリ不足
+ * 全ての例外をキャッチしてfalseを返す
  */
 bool LoadProjectFromFile(const std::wstring& filePath) {
     try {
-        // t@CXg[JiUnicodeΉj
-        std::wifstream file(filePath);
-        if (!file.is_open()) {
-            return false; // t@CI[vG[
-        }
-        
-        // UTF-8GR[fBO̐ݒ
-        file.imbue(std::locale(file.getloc(), new std::codecvt_utf8<wchar_t>));
-        
-        // t@CŜ𕶎Ƃēǂݍ
-        std::wstring xmlContent((std::istreambuf_iterator<wchar_t>(file)),
-                              std::istreambuf_iterator<wchar_t>());
-        file.close();
-        
-        // vWFNg^f[^̒o
-        std::wstring projectName = ExtractXmlValue(xmlContent, L"ProjectName", 0);
-        std::wstring description = ExtractXmlValue(xmlContent, L"Description", 0);
-        
-        // vWFNg̃of[V
-        if (projectName.empty()) {
-            projectName = L"ǂݍ܂ꂽvWFNg"; // tH[obN
+        // 書き込み途中のファイルやジャーナルを読まないよう、実行中の保存を完了させる
+        WaitForBackgroundSave(g_currentProject.get());
+
+        // 拡張子に応じてバイナリ形式、圧縮XML形式またはXML形式（メモリマップ・単一パス解析）で読み込み
+        std::unique_ptr<WBSProject> loadedProject;
+        if (!ReadProjectFile(filePath, loadedProject, GetLazyLoadDepth())) {
+            return false; // ファイルオープンエラー
         }
-        
-        // VvWFNgCX^X̍쐬
-        g_currentProject = std::make_unique<WBSProject>(projectName);
-        g_currentProject->description = description;
-        
-        // [g^XN̉
-        size_t rootTaskStart = xmlContent.find(L"<RootTask>");
-        if (rootTaskStart != std::wstring::npos) {
-            size_t rootTaskEnd = xmlContent.find(L"</RootTask>");
-            if (rootTaskEnd != std::wstring::npos) {
-                // [g^XN͈͂XML𒊏o
-                std::wstring rootTaskXml = xmlContent.substr(rootTaskStart + 10, rootTaskEnd - rootTaskStart - 10);
-                
-                // [g^XN̍ċAI
-                size_t pos = 0;
-                auto loadedRootTask = ParseTaskFromXml(rootTaskXml, pos);
-                
-                if (loadedRootTask) {
-                    // [g^XN̖OvWFNgƓ
-                    loadedRootTask->taskName = projectName;
-                    g_currentProject->rootTask = loadedRootTask;
-                }
-            }
+        if (!loadedProject) {
+            // XML構文エラー（閉じられていない要素等）
+            MessageBox(nullptr, L"プロジェクトファイルの形式が正しくありません。", L"エラー", MB_OK | MB_ICONERROR);
+            return false;
         }
+
+        // 前回の保存以降の編集（ジャーナル）を適用
+        ApplyProjectJournal(filePath, *loadedProject);
+        g_currentProject = std::move(loadedProject);
         
-        // UIԂ̍XV
-        RefreshTreeView();  // c[r[̍ĕ`
-        RefreshListView();  // ڍ׃r[̍ĕ`
+        // UI状態の更新
+        RefreshTreeView();  // ツリービューの再描画
+        RefreshListView();  // 詳細ビューの再描画
         
-        // AvP[Vݒ̍XV
+        // アプリケーション設定の更新
         SaveLastOpenedFile(filePath);
         
-        // [U[ւ̐ʒm
-        MessageBox(nullptr, L"vWFNgXMLt@Cǂݍ݂܂B", L"", MB_OK | MB_ICONINFORMATION);
+        // ユーザーへの成功通知
+        MessageBox(nullptr, L"プロジェクトをファイルから読み込みました。", L"情報", MB_OK | MB_ICONINFORMATION);
         
         return true;
         
     } catch (...) {
-        // SĂ̗OLb`it@CI/OAXMĹAsj
-        MessageBox(nullptr, L"vWFNg̓ǂݍݒɃG[܂B", L"G[", MB_OK | MB_ICONERROR);
+        // 全ての例外をキャッチ（ファイルI/O、XML解析、メモリ不足等）
+        MessageBox(nullptr, L"プロジェクトの読み込み中にエラーが発生しました。", L"エラー", MB_OK | MB_ICONERROR);
         return false;
     }
 }
 
 /**
- * @brief vWFNgXMLt@Cɕۑ
+ * @brief プロジェクトをXMLファイルに保存
  * 
- * t@CI_CAO\A[U[Iꏊ
- * ݂̃vWFNgXML`ŕۑ܂B
+ * ファイル選択ダイアログを表示し、ユーザーが選択した場所に
+ * 現在のプロジェクトをXML形式で保存します。
  * 
- * @details t[:
- * 1. vWFNg݃`FbN
- * 2. t@Cۑ_CAO̕\
- * 3. XMLϊ
- * 4. t@C݁iUTF-8GR[fBOj
- * 5. ݒt@C̍XV
- * 6. [U[ʒm
+ * @details 処理フロー:
+ * 1. プロジェクト存在チェック
+ * 2. ファイル保存ダイアログの表示
+ * 3. RequestBackgroundSave() によるバックグラウンド保存の開始
+ *    （前回と同じファイルなら編集ジャーナルへの追記、
+ *     それ以外は拡張子に応じたXML形式・バイナリ形式・圧縮XML形式・JSON形式・タスク表の全体保存）
+ * 4. 完了時の設定ファイル更新・ユーザー通知は OnBackgroundSaveCompleted() が行う
  * 
- * @note _CAOݒ:
- * - t@CtB^: "*.xml"  "*.*"
- * - ftHggq: ".xml"
- * - ㏑mF: L
- * - pX: L
+ * @note 変換と書き込みはワーカースレッドで行われるため、保存中も編集を続けられます。
+ *       保存中に再度保存した場合は、現在の保存の完了後に1回だけ保存し直します。
+ * 
+ * @note ダイアログ設定:
+ * - ファイルフィルタ: "*.xml"、"*.wbsb"、"*.wbsz"、"*.json"、"*.csv"、"*.tsv" および "*.*"
+ * - デフォルト拡張子: ".xml"
+ * - 上書き確認: 有効
+ * - パス検証: 有効
  */
 void OnSaveProject() {
-    // vWFNg݃`FbN
+    // プロジェクト存在チェック
     if (!g_currentProject) {
-        MessageBox(nullptr, L"ۑvWFNg܂B", L"G[", MB_OK | MB_ICONWARNING);
+        MessageBox(nullptr, L"保存するプロジェクトがありません。", L"エラー", MB_OK | MB_ICONWARNING);
         return;
     }
 
-    // t@Cۑ_CAO̐ݒ
+    // ファイル保存ダイアログの設定
     OPENFILENAME ofn = {};
-    WCHAR szFile[260] = L""; // t@CpXobt@
+    WCHAR szFile[260] = L""; // ファイルパスバッファ
     
     ofn.lStructSize = sizeof(ofn);
     ofn.lpstrFile = szFile;
-    ofn.nMaxFile = sizeof(szFile);
-    ofn.lpstrFilter = L"WBS XMLt@C\0*.xml\0ׂẴt@C\0*.*\0";
+    ofn.nMaxFile = sizeof(szFile) / sizeof(szFile[0]);
+    ofn.lpstrFilter = L"WBS XMLファイル\0*.xml\0WBSバイナリファイル\0*.wbsb\0WBS圧縮XMLファイル\0*.wbsz\0WBS JSONファイル\0*.json\0タスク表（CSV）\0*.csv\0タスク表（TSV）\0*.tsv\0すべてのファイル\0*.*\0";
     ofn.nFilterIndex = 1;
     ofn.lpstrFileTitle = nullptr;
     ofn.nMaxFileTitle = 0;
     ofn.lpstrInitialDir = nullptr;
-    ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT; // pX؂Ə㏑mF
-    ofn.lpstrDefExt = L"xml"; // ftHggq
+    ofn.Flags = OFN_PATHMUSTEXIST | OFN_OVERWRITEPROMPT; // パス検証と上書き確認
+    ofn.lpstrDefExt = L"xml"; // デフォルト拡張子
 
-    // t@Cۑ_CAO̕\
+    // ファイル保存ダイアログの表示
     if (GetSaveFileName(&ofn) == TRUE) {
         try {
-            // t@CXg[J
-            std::wofstream file(szFile);
-            if (file.is_open()) {
-                // UTF-8GR[fBO̐ݒ
-                file.imbue(std::locale(file.getloc(), new std::codecvt_utf8<wchar_t>));
-                
-                // vWFNgXMLɕϊ
-                std::wstring xmlContent = ProjectToXml();
-                
-                // t@Cɏ
-                file << xmlContent;
-                file.close();
-                
-                // AvP[Vݒ̍XV
-                SaveLastOpenedFile(szFile);
-                
-                // [U[ւ̐ʒm
-                MessageBox(nullptr, L"vWFNgXMLt@Cɕۑ܂B", L"", MB_OK | MB_ICONINFORMATION);
-            } else {
-                // t@CI[vG[
-                MessageBox(nullptr, L"t@CJ܂łB", L"G[", MB_OK | MB_ICONERROR);
-            }
+            // 同じファイルへの保存は編集ジャーナルへの追記のみ、
+            // それ以外は拡張子に応じた形式でスナップショット全体を書き込み
+            RequestBackgroundSave(*g_currentProject, szFile, g_hMainDialog);
         } catch (...) {
-            // ݃G[ifBXNeʕsAG[j
-            MessageBox(nullptr, L"vWFNg̕ۑɃG[܂B", L"G[", MB_OK | MB_ICONERROR);
+            // スナップショットの取り込みエラー（メモリ不足等）
+            MessageBox(nullptr, L"プロジェクトの保存中にエラーが発生しました。", L"エラー", MB_OK | MB_ICONERROR);
+        }
+    }
+}
+
+/**
+ * @brief バックグラウンド保存の完了通知（WM_WBS_SAVE_COMPLETED）を処理
+ * 
+ * CompleteBackgroundSave() で結果を反映し、保存が終わっていれば
+ * 設定ファイルを更新してユーザーに通知します。続けて保存し直す場合は
+ * その完了時に通知します。
+ *
+ * @param sequence 通知の wParam（完了したジョブの通し番号）
+ */
+void OnBackgroundSaveCompleted(WPARAM sequence) {
+    try {
+        std::wstring savedPath;
+        WBSSaveStatus status = CompleteBackgroundSave(g_currentProject.get(), sequence, savedPath);
+        if (status == WBSSaveStatus::Succeeded) {
+            // アプリケーション設定の更新
+            SaveLastOpenedFile(savedPath);
+            
+            // ユーザーへの成功通知
+            MessageBox(g_hMainDialog, L"プロジェクトをファイルに保存しました。", L"情報", MB_OK | MB_ICONINFORMATION);
+        } else if (status == WBSSaveStatus::Failed) {
+            // ファイルオープン・書き込みエラー
+            MessageBox(g_hMainDialog, L"ファイルに書き込めませんでした。", L"エラー", MB_OK | MB_ICONERROR);
         }
+    } catch (...) {
+        // 続けて行う保存の取り込みエラー（メモリ不足等）
+        MessageBox(g_hMainDialog, L"プロジェクトの保存中にエラーが発生しました。", L"エラー", MB_OK | MB_ICONERROR);
     }
 }
 
 /**
- * @brief vWFNgt@CJ
+ * @brief プロジェクトファイルを開く
  * 
- * t@CI_CAO\A[U[IXMLt@C
- * vWFNgǂݍ݂܂B
+ * ファイル選択ダイアログを表示し、ユーザーが選択したXMLファイルから
+ * プロジェクトを読み込みます。
  * 
- * @details t[:
- * 1. t@CI_CAO̕\
- * 2. LoadProjectFromFile() ̌Ăяo
- * 3. G[nhOLoadProjectFromFile()ɈϏ
+ * @details 処理フロー:
+ * 1. ファイル選択ダイアログの表示
+ * 2. LoadProjectFromFile() の呼び出し
+ * 3. エラーハンドリングはLoadProjectFromFile()に委譲
  * 
- * @note _CAOݒ:
- * - t@CtB^: "*.xml"  "*.*"
- * - t@C݃`FbN: L
- * - pX: L
+ * @note ダイアログ設定:
+ * - ファイルフィルタ: "*.xml"、"*.wbsb"、"*.wbsz"、"*.json"、"*.csv"、"*.tsv" および "*.*"
+ * - ファイル存在チェック: 有効
+ * - パス検証: 有効
  */
 void OnOpenProject() {
-    // t@CI_CAO̐ݒ
+    // ファイル選択ダイアログの設定
     OPENFILENAME ofn = {};
-    WCHAR szFile[260] = L""; // t@CpXobt@
+    WCHAR szFile[260] = L""; // ファイルパスバッファ
     
     ofn.lStructSize = sizeof(ofn);
     ofn.lpstrFile = szFile;
-    ofn.nMaxFile = sizeof(szFile);
-    ofn.lpstrFilter = L"WBS XMLt@C\0*.xml\0ׂẴt@C\0*.*\0";
+    ofn.nMaxFile = sizeof(szFile) / sizeof(szFile[0]);
+    ofn.lpstrFilter = L"WBS XMLファイル\0*.xml\0WBSバイナリファイル\0*.wbsb\0WBS圧縮XMLファイル\0*.wbsz\0WBS JSONファイル\0*.json\0タスク表（CSV）\0*.csv\0タスク表（TSV）\0*.tsv\0すべてのファイル\0*.*\0";
     ofn.nFilterIndex = 1;
     ofn.lpstrFileTitle = nullptr;
     ofn.nMaxFileTitle = 0;
     ofn.lpstrInitialDir = nullptr;
-    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST; // pXƃt@C̑݃`FbN
+    ofn.Flags = OFN_PATHMUSTEXIST | OFN_FILEMUSTEXIST; // パスとファイルの存在チェック
 
-    // t@CI_CAO̕\
+    // ファイル選択ダイアログの表示
     if (GetOpenFileName(&ofn) == TRUE) {
-        // Iꂽt@CvWFNgǂݍ
-        // G[nhOLoadProjectFromFile()Ŏs
+        // 選択されたファイルからプロジェクトを読み込み
+        // エラーハンドリングはLoadProjectFromFile()内で実行される
         LoadProjectFromFile(szFile);
     }
 }
\ No newline at end of file
@@ -72,6 +72,7 @@
 #define IDM_FILE_NEW                    110
 #define IDM_FILE_OPEN                   111
 #define IDM_FILE_SAVE                   112
+#define IDM_FILE_MERGE                  113
 
 #define IDM_EDIT_ADD_TASK              120
 #define IDM_EDIT_ADD_SUBTASK           121
@@ -1,26 +1,26 @@
 /*
  * ============================================================================
- * ResponsiveLayout.h - WBSAvP[V X|VuCAEg@\
+ * ResponsiveLayout.h - WBSアプリケーション レスポンシブレイアウト機能
  * ============================================================================
  * 
- * ̃wb_[t@ĆAWBSAvP[ṼC_CAO
- * X|VuΉɂ邽߂̋@\񋟂܂B
+ * このヘッダーファイルは、WBSアプリケーションのメインダイアログを
+ * レスポンシブ対応にするための機能を提供します。
  * 
- * yȋ@\z
- * - _CAOTCYύX̃Rg[TCY
- * - Rg[̑Έʒuێ
- * - ŏTCY
- * - eRg[̓K؂Ȕzu
+ * 【主な機能】
+ * - ダイアログサイズ変更時のコントロール自動リサイズ
+ * - コントロールの相対位置保持
+ * - 最小サイズ制限
+ * - 各コントロールの適切な配置調整
  * 
- * y݌vz
- * - TreeView͕ŒA
- * - ListView͕Eɉ
- * - {^Q͑Έʒuێ
- * - ŏTCYł̎gm
+ * 【設計原則】
+ * - TreeViewは幅固定、高さ可変
+ * - ListViewは幅・高さ共に可変
+ * - ボタン群は相対位置を保持
+ * - 最小サイズでの使い勝手を確保
  * 
- * 쐬: WBSJ`[
- * 쐬: 2024N
- * o[W: 1.0
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
  * ============================================================================
  */
 
@@ -29,68 +29,68 @@
 #include <Windows.h>
 
 // ============================================================================
-// X|VuCAEgǗp\
+// レスポンシブレイアウト管理用構造体
 // ============================================================================
 
 /**
- * @brief Rg[̃CAEgǗ\
+ * @brief コントロールのレイアウト情報を管理する構造体
  * 
- * _CAOTCYꂽۂɁAeRg[ǂ̂悤
- * TCYEړ邩̏ێ܂B
+ * ダイアログがリサイズされた際に、各コントロールをどのように
+ * リサイズ・移動するかの情報を保持します。
  */
 struct ControlLayoutInfo {
-    int controlId;          ///< Rg[ID
-    RECT originalRect;      ///< ʒuƃTCY
-    bool resizeWidth;       ///< TCY邩
-    bool resizeHeight;      ///< TCY邩
-    bool moveRight;         ///< E[ɌŒ肷邩
-    bool moveBottom;        ///< [ɌŒ肷邩
-    double widthRatio;      ///< ̊gk䗦i0.0-1.0j
-    double heightRatio;     ///< ̊gk䗦i0.0-1.0j
+    int controlId;          ///< コントロールID
+    RECT originalRect;      ///< 初期位置とサイズ
+    bool resizeWidth;       ///< 幅をリサイズするか
+    bool resizeHeight;      ///< 高さをリサイズするか
+    bool moveRight;         ///< 右端に固定するか
+    bool moveBottom;        ///< 下端に固定するか
+    double widthRatio;      ///< 幅の拡縮比率（0.0-1.0）
+    double heightRatio;     ///< 高さの拡縮比率（0.0-1.0）
 };
 
 // ============================================================================
-// O[oϐiX|Vu@\pj
+// グローバル変数（レスポンシブ機能用）
 // ============================================================================
 
-extern SIZE g_originalDialogSize;                      ///< _CAȌTCY
-extern std::vector<ControlLayoutInfo> g_controlLayouts; ///< Rg[CAEg
+extern SIZE g_originalDialogSize;                      ///< ダイアログの初期サイズ
+extern std::vector<ControlLayoutInfo> g_controlLayouts; ///< コントロールレイアウト情報
 
 // ============================================================================
-// X|VuCAEg֐錾
+// レスポンシブレイアウト関数宣言
 // ============================================================================
 
 /**
- * @brief Rg[̃CAEg
+ * @brief コントロールのレイアウト情報を初期化
  * 
- * @param hDlg _CAOnh
+ * @param hDlg ダイアログハンドル
  * 
- * _CAȌɌĂяoAeRg[̏ʒu
- * TCY`܂B̊֐WM_INITDIALOGŌĂяoĂB
+ * ダイアログの初期化時に呼び出され、各コントロールの初期位置と
+ * リサイズ動作を定義します。この関数はWM_INITDIALOGで呼び出してください。
  * 
- * @note ̊֐͈xĂяoĂB
+ * @note この関数は一度だけ呼び出してください。
  */
 void InitializeResponsiveLayout(HWND hDlg);
 
 /**
- * @brief Rg[̈ʒuƃTCYXV
+ * @brief コントロールの位置とサイズを更新
  * 
- * @param hDlg _CAOnh
- * @param newWidth V_CAO
- * @param newHeight V_CAO
+ * @param hDlg ダイアログハンドル
+ * @param newWidth 新しいダイアログ幅
+ * @param newHeight 新しいダイアログ高さ
  * 
- * _CAÕTCYύXɌĂяoAeRg[̈ʒu
- * TCYV_CAOTCYɍ킹Ē܂B
- * ̊֐WM_SIZEbZ[Wnh[ŌĂяoĂB
+ * ダイアログのサイズ変更時に呼び出され、各コントロールの位置と
+ * サイズを新しいダイアログサイズに合わせて調整します。
+ * この関数はWM_SIZEメッセージハンドラーで呼び出してください。
  */
 void UpdateResponsiveLayout(HWND hDlg, int newWidth, int newHeight);
 
 /**
- * @brief ŏTCYݒ
+ * @brief 最小サイズ制限を設定
  * 
- * @param lpMMI MINMAXINFO\̂̃|C^
+ * @param lpMMI MINMAXINFO構造体のポインタ
  * 
- * _CAO̍ŏTCYݒ肵܂B
- * ̊֐WM_GETMINMAXINFObZ[Wnh[ŌĂяoĂB
+ * ダイアログの最小サイズを設定します。
+ * この関数はWM_GETMINMAXINFOメッセージハンドラーで呼び出してください。
  */
 void SetMinimumSize(LPMINMAXINFO lpMMI);
\ No newline at end of file
@@ -0,0 +1,240 @@
+/*
+ * ============================================================================
+ * WBSArena.h - WBSアプリケーション プロジェクト単位のメモリアリーナ
+ * ============================================================================
+ *
+ * このヘッダーファイルは、プロジェクトのタスク（WBSItem と shared_ptr の
+ * 制御ブロック）を大きなブロックからまとめて確保するアリーナと、
+ * 標準ライブラリのアロケーター要件を満たすアダプターを提供します。
+ *
+ * 【主な機能】
+ * - WBSArena: 64KB単位のブロックから順に切り出すバンプアロケーター
+ *   （解放された領域はサイズ別の空きリストで再利用）
+ * - WBSArenaAllocator<T>: std::allocate_shared() に渡すアロケーター
+ * - タスクの作成は WBSItem::Create() / WBSProject::NewItem()（WBSClasses.h）から行う
+ * - タスクの説明を保持するテキストストア（WBSTextStore.h）と、担当者名の
+ *   文字列プール（WBSStringPool.h）もアリーナと同じ寿命で保持
+ *
+ * 【設計原則】
+ * - 確保はブロック内のポインタを進めるだけ（汎用ヒープを呼ばない）
+ * - 汎用ヒープの呼び出しはブロック単位: タスクの破棄は空きリストへの返却だけで、
+ *   ブロックは最後のタスクが破棄されたとき、ブロック数回の free() でまとめて返す
+ * - 寿命の安全性: 各タスクの制御ブロックがアロケーター経由でアリーナを
+ *   shared_ptr で保持するため、プロジェクトより長く生きるタスクがあっても
+ *   アリーナは先に解放されない
+ * - スレッド安全: 並列読み込み・バックグラウンド保存からの確保に備え、排他制御付き
+ *
+ * @note アリーナに載るのはタスク本体（WBSItem と制御ブロック）と説明・担当者名の文字列だけです。
+ *       タスク名（短文字列最適化に収まらないもの）・子の配列・深いID（WBSTaskId の
+ *       内部領域を超える段数）は汎用ヒープから確保されます。プロジェクトの破棄では
+ *       タスクごとのデストラクタが実行され（O(タスク数)）、それらの領域も個別に
+ *       解放されます。アリーナが省くのはタスク本体の個別の malloc() / free() と、
+ *       本体をブロック内に連続して配置することによる走査時のキャッシュミスです。
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+#include "WBSStringPool.h"
+#include "WBSTextStore.h"
+
+// ============================================================================
+// アリーナ
+// ============================================================================
+
+/**
+ * @brief ブロック単位で確保し、まとめて解放するメモリアリーナ
+ *
+ * 確保は現在のブロックの残りから切り出し、足りなくなれば新しいブロックを
+ * 追加します。解放された領域は16バイト単位のサイズ別空きリストに戻し、
+ * 同じサイズの確保で再利用します（編集でタスクを削除・追加しても増え続けない）。
+ * ブロックはアリーナの破棄時にまとめて解放されます。
+ */
+class WBSArena {
+public:
+    static const size_t kBlockSize = 64 * 1024;            ///< 通常のブロックサイズ
+    static const size_t kGranularity = 16;                  ///< 確保単位（アラインメントを兼ねる）
+    static const size_t kMaxPooledSize = 1024;              ///< 空きリストで再利用する最大サイズ
+
+    /**
+     * @brief 確保の統計
+     */
+    struct Stats {
+        size_t allocationCount = 0;     ///< Allocate() の呼び出し回数
+        size_t reuseCount = 0;          ///< うち空きリストから再利用した回数
+        size_t blockCount = 0;          ///< 確保済みブロック数
+        size_t reservedBytes = 0;       ///< 確保済みブロックの合計バイト数
+    };
+
+    WBSArena() : current_(nullptr), remaining_(0) {
+        for (auto& head : freeLists_) {
+            head = nullptr;
+        }
+    }
+
+    WBSArena(const WBSArena&) = delete;
+    WBSArena& operator=(const WBSArena&) = delete;
+
+    /**
+     * @brief すべてのブロックを解放（個々の領域は解放しない）
+     */
+    ~WBSArena() {
+        for (void* block : blocks_) {
+            std::free(block);
+        }
+    }
+
+    /**
+     * @brief 領域を確保
+     * @param size バイト数
+     * @param alignment アラインメント（kGranularity 以下であること）
+     * @return 確保した領域（確保できない場合は std::bad_alloc を送出）
+     */
+    void* Allocate(size_t size, size_t alignment) {
+        if (alignment > kGranularity) {
+            throw std::bad_alloc();
+        }
+        size = RoundUp(size);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++stats_.allocationCount;
+        if (size <= kMaxPooledSize) {
+            FreeNode*& head = freeLists_[size / kGranularity - 1];
+            if (head) {
+                FreeNode* node = head;
+                head = node->next;
+                ++stats_.reuseCount;
+                return node;
+            }
+        }
+        if (size > remaining_) {
+            AddBlock(size);
+        }
+        void* result = current_;
+        current_ += size;
+        remaining_ -= size;
+        return result;
+    }
+
+    /**
+     * @brief 領域を解放（空きリストへ戻す。大きな領域はアリーナの破棄まで保持）
+     * @param pointer Allocate() で確保した領域
+     * @param size 確保時のバイト数
+     */
+    void Deallocate(void* pointer, size_t size) {
+        size = RoundUp(size);
+        if (!pointer || size > kMaxPooledSize) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        FreeNode* node = static_cast<FreeNode*>(pointer);
+        node->next = freeLists_[size / kGranularity - 1];
+        freeLists_[size / kGranularity - 1] = node;
+    }
+
+    /**
+     * @brief 確保の統計を取得
+     */
+    Stats GetStats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+    /**
+     * @brief このアリーナのタスクのコールドテキスト（説明）の格納先
+     *
+     * タスクはアリーナを shared_ptr で保持するため、タスクが参照している間は
+     * ストアも解放されません。
+     */
+    WBSTextStore& Texts() {
+        return texts_;
+    }
+
+    /**
+     * @brief このアリーナのタスクの担当者名のインターンプール
+     */
+    WBSStringPool& Strings() {
+        return strings_;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static size_t RoundUp(size_t size) {
+        return size == 0 ? kGranularity : (size + kGranularity - 1) & ~(kGranularity - 1);
+    }
+
+    void AddBlock(size_t minimumSize) {
+        // 現在のブロックの残りは捨てる（タスク1件分に満たない端数のみ）
+        size_t blockSize = minimumSize > kBlockSize ? minimumSize : kBlockSize;
+        void* block = std::malloc(blockSize);
+        if (!block) {
+            throw std::bad_alloc();
+        }
+        blocks_.push_back(block);
+        current_ = static_cast<char*>(block);
+        remaining_ = blockSize;
+        ++stats_.blockCount;
+        stats_.reservedBytes += blockSize;
+    }
+
+    std::mutex mutex_;                                          ///< 確保・解放の排他制御
+    std::vector<void*> blocks_;                                 ///< 確保済みブロック
+    char* current_;                                             ///< 現在のブロックの未使用領域の先頭
+    size_t remaining_;                                          ///< 現在のブロックの残りバイト数
+    FreeNode* freeLists_[kMaxPooledSize / kGranularity];        ///< サイズ別の空きリスト
+    Stats stats_;                                               ///< 確保の統計
+    WBSTextStore texts_;                                        ///< タスクの説明の格納先
+    WBSStringPool strings_;                                     ///< タスクの担当者名の格納先
+};
+
+// ============================================================================
+// アロケーター
+// ============================================================================
+
+/**
+ * @brief WBSArena から確保する標準アロケーター
+ *
+ * std::allocate_shared() に渡すと、オブジェクトと制御ブロックが1回の確保で
+ * アリーナ上に配置されます。制御ブロックはアロケーターの複製（アリーナへの
+ * shared_ptr）を保持するため、アリーナは最後のオブジェクトより長く生存します。
+ */
+template <typename T>
+class WBSArenaAllocator {
+public:
+    typedef T value_type;
+
+    explicit WBSArenaAllocator(std::shared_ptr<WBSArena> arena) : arena_(std::move(arena)) {}
+
+    template <typename U>
+    WBSArenaAllocator(const WBSArenaAllocator<U>& other) : arena_(other.arena_) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count) {
+        arena_->Deallocate(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const WBSArenaAllocator<U>& other) const { return arena_ == other.arena_; }
+    template <typename U>
+    bool operator!=(const WBSArenaAllocator<U>& other) const { return arena_ != other.arena_; }
+
+private:
+    template <typename U> friend class WBSArenaAllocator;
+
+    std::shared_ptr<WBSArena> arena_;   ///< 確保元のアリーナ
+};
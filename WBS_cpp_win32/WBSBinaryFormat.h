@@ -0,0 +1,202 @@
+/*
+ * ============================================================================
+ * WBSBinaryFormat.h - WBSアプリケーション バイナリプロジェクト形式（.wbsb）
+ * ============================================================================
+ *
+ * このヘッダーファイルは、XMLと同じ内容を保持するコンパクトなバイナリ形式の
+ * ファイルレイアウトと、その検証・変換用の補助関数を定義します。
+ *
+ * 【ファイル構造】（全てリトルエンディアン、オフセットはファイル先頭から）
+ * +----------------------------+
+ * | WBSBinaryHeader (64バイト)  |
+ * +----------------------------+
+ * | WBSBinaryTaskRecord × N    |  タスクレコード（行きがけ順、64バイト固定長）
+ * +----------------------------+
+ * | uint32_t × (M + 1)         |  文字列オフセット表（文字列データ内の位置）
+ * +----------------------------+
+ * | 文字列データ (UTF-8)       |  重複排除済みの文字列を連結したもの
+ * +----------------------------+
+ *
+ * 【設計原則】
+ * - 固定長レコード: タスク i の位置は taskOffset + i * recordSize で求まる
+ * - 行きがけ順: 子タスクは親の直後に並び、部分木は [i, subtreeEnd) の連続範囲
+ * - 重複排除: 同じ担当者名や空文字列は文字列表に一度だけ格納
+ * - 境界検査: 全てのオフセットと索引は読み込み時にファイルサイズと照合
+ * - バージョン管理: 形式を変更する場合は kWBSBinaryVersion を上げる
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include "WBSDateTime.h"
+
+// ============================================================================
+// 形式定数
+// ============================================================================
+
+const char kWBSBinaryMagic[4] = { 'W', 'B', 'S', 'B' };    ///< ファイル識別子
+const uint16_t kWBSBinaryVersion = 1;                       ///< 現在の形式バージョン
+const uint32_t kWBSBinaryNoParent = 0xFFFFFFFFu;            ///< ルートタスクの親索引
+
+// ============================================================================
+// ファイルレイアウト
+// ============================================================================
+
+/**
+ * @brief .wbsb ファイルのヘッダー（64バイト）
+ */
+struct WBSBinaryHeader {
+    char magic[4];                  ///< "WBSB"
+    uint16_t version;               ///< 形式バージョン
+    uint16_t headerSize;            ///< sizeof(WBSBinaryHeader)
+    uint32_t recordSize;            ///< sizeof(WBSBinaryTaskRecord)
+    uint32_t taskCount;             ///< タスクレコード数
+    uint32_t stringCount;           ///< 文字列表の要素数
+    uint32_t projectNameString;     ///< プロジェクト名の文字列索引
+    uint32_t descriptionString;     ///< プロジェクト説明の文字列索引
+    uint32_t reserved;              ///< 予約（0）
+    uint64_t taskOffset;            ///< タスクレコード配列の位置
+    uint64_t stringTableOffset;     ///< 文字列オフセット表の位置
+    uint64_t stringDataOffset;      ///< 文字列データの位置
+    uint64_t stringDataSize;        ///< 文字列データのバイト数
+};
+
+/**
+ * @brief タスク1件分の固定長レコード（64バイト）
+ *
+ * 文字列フィールドは文字列表の索引、日時は PackDateTime() の値です。
+ */
+struct WBSBinaryTaskRecord {
+    uint32_t parentIndex;           ///< 親タスクの索引（ルートは kWBSBinaryNoParent）
+    uint32_t subtreeEnd;            ///< 部分木の終端索引（次の兄弟の索引）
+    uint32_t childCount;            ///< 直接の子タスク数
+    uint32_t idString;              ///< タスクID
+    uint32_t nameString;            ///< タスク名
+    uint32_t descriptionString;     ///< 詳細説明
+    uint32_t assignedToString;      ///< 担当者名
+    uint8_t status;                 ///< TaskStatus の値
+    uint8_t priority;               ///< TaskPriority の値
+    uint16_t level;                 ///< 階層レベル
+    double estimatedHours;          ///< 見積もり工数
+    double actualHours;             ///< 実績工数
+    uint64_t startDate;             ///< 開始予定日（パック形式）
+    uint64_t endDate;               ///< 終了予定日（パック形式）
+};
+
+static_assert(sizeof(WBSBinaryHeader) == 64, "WBSBinaryHeader must be 64 bytes");
+static_assert(sizeof(WBSBinaryTaskRecord) == 64, "WBSBinaryTaskRecord must be 64 bytes");
+
+// ============================================================================
+// 日時のパック変換
+// ============================================================================
+
+/**
+ * @brief 日時を64ビット値にパック
+ *
+ * @param value 変換元の日時
+ * @return 年(16) 月(8) 日(8) 時(8) 分(8) 秒(8) の順に詰めた値（秒は常に0）
+ *
+ * ファイル上の表現は SYSTEMTIME を保持していた版と同じです。
+ * 値の大小関係は日時の前後関係と一致します。
+ */
+inline uint64_t PackDateTime(WBSDateTime value) {
+    int year, month, day, hour, minute;
+    value.ToCivil(year, month, day, hour, minute);
+    return (static_cast<uint64_t>(year) << 40) |
+           (static_cast<uint64_t>(month) << 32) |
+           (static_cast<uint64_t>(day) << 24) |
+           (static_cast<uint64_t>(hour) << 16) |
+           (static_cast<uint64_t>(minute) << 8);
+}
+
+/**
+ * @brief 64ビット値から日時を復元
+ * @param packed PackDateTime() の値
+ * @return 復元した日時（秒は切り捨て。範囲外の値は WBSDateTime() の既定値）
+ */
+inline WBSDateTime UnpackDateTime(uint64_t packed) {
+    WBSDateTime value;
+    WBSDateTime::FromCivil(static_cast<int>((packed >> 40) & 0xFFFF), static_cast<int>((packed >> 32) & 0xFF),
+                           static_cast<int>((packed >> 24) & 0xFF), static_cast<int>((packed >> 16) & 0xFF),
+                           static_cast<int>((packed >> 8) & 0xFF), value);
+    return value;
+}
+
+// ============================================================================
+// 検証関数
+// ============================================================================
+
+/**
+ * @brief ヘッダーと各セクションの範囲を検証
+ *
+ * @param data ファイル内容の先頭
+ * @param size ファイルサイズ
+ * @param header 検証済みヘッダーの格納先
+ * @return 全セクションがファイル内に収まっている場合true
+ *
+ * タスク数に依存しない定数時間の検査です。レコード内の索引は
+ * 読み込み側で個別に検査してください。
+ */
+inline bool ValidateBinaryHeader(const char* data, size_t size, WBSBinaryHeader& header) {
+    if (size < sizeof(WBSBinaryHeader)) {
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, kWBSBinaryMagic, sizeof(kWBSBinaryMagic)) != 0 ||
+        header.version != kWBSBinaryVersion ||
+        header.headerSize != sizeof(WBSBinaryHeader) ||
+        header.recordSize != sizeof(WBSBinaryTaskRecord) ||
+        header.taskCount == 0) {
+        return false;
+    }
+
+    // 各セクションの範囲検査（オーバーフローを避けるため減算で比較）
+    uint64_t fileSize = size;
+    uint64_t recordBytes = static_cast<uint64_t>(header.taskCount) * header.recordSize;
+    uint64_t tableBytes = (static_cast<uint64_t>(header.stringCount) + 1) * sizeof(uint32_t);
+    if (header.taskOffset > fileSize || recordBytes > fileSize - header.taskOffset ||
+        header.stringTableOffset > fileSize || tableBytes > fileSize - header.stringTableOffset ||
+        header.stringDataOffset > fileSize || header.stringDataSize > fileSize - header.stringDataOffset) {
+        return false;
+    }
+
+    // レコードはアラインされた位置から始まること
+    if (header.taskOffset % alignof(WBSBinaryTaskRecord) != 0 ||
+        header.stringTableOffset % alignof(uint32_t) != 0) {
+        return false;
+    }
+
+    return header.projectNameString < header.stringCount &&
+           header.descriptionString < header.stringCount;
+}
+
+/**
+ * @brief 文字列表の i 番目の範囲を取得
+ *
+ * @param data ファイル内容の先頭
+ * @param header 検証済みヘッダー
+ * @param index 文字列索引
+ * @param first 文字列の先頭の格納先
+ * @param length 文字列のバイト数の格納先
+ * @return 索引とオフセットが範囲内の場合true
+ */
+inline bool GetBinaryString(const char* data, const WBSBinaryHeader& header, uint32_t index,
+                            const char*& first, size_t& length) {
+    if (index >= header.stringCount) {
+        return false;
+    }
+    uint32_t offsets[2];
+    memcpy(offsets, data + header.stringTableOffset + static_cast<uint64_t>(index) * sizeof(uint32_t), sizeof(offsets));
+    if (offsets[0] > offsets[1] || offsets[1] > header.stringDataSize) {
+        return false;
+    }
+    first = data + header.stringDataOffset + offsets[0];
+    length = offsets[1] - offsets[0];
+    return true;
+}
@@ -1,43 +1,112 @@
 /*
  * ============================================================================
- * WBSClasses.h - WBSAvP[V NX`wb_[
+ * WBSClasses.h - WBSアプリケーション クラス定義ヘッダー
  * ============================================================================
  * 
- * ̃t@Cɂ́AWBSiWork Breakdown StructurejǗAvP[V
- * gpvȃNXƗ񋓌^̒`܂܂Ă܂B
+ * このファイルには、WBS（Work Breakdown Structure）管理アプリケーションで
+ * 使用される主要なクラスと列挙型の定義が含まれています。
  * 
- * y܂܂NXz
- * - TaskStatus: ^XN̐isԂ\񋓌^
- * - TaskPriority: ^XN̗Dx\񋓌^  
- * - WBSItem: ʂ̃^XNETu^XN\NX
- * - WBSProject: vWFNgŜǗNX
+ * 【含まれるクラス】
+ * - TaskStatus: タスクの進行状態を表す列挙型
+ * - TaskPriority: タスクの優先度を表す列挙型  
+ * - WBSItem: 個別のタスク・サブタスクを表すクラス
+ * - WBSProject: プロジェクト全体を管理するクラス
  * 
- * y݌vz
- * - RAII: IuWFNg̎Iȃ\[XǗ
- * - ^S: 񋓃NXɂ鋭^t
- * - S: X}[g|C^̊p
- * - g: ̋@\ǉɑΉ݌v
+ * 【部分木ハッシュ】
+ * 各 WBSItem は自身のフィールドと子タスクのハッシュを組み合わせた
+ * 部分木ハッシュ（Merkleハッシュ）を遅延計算してキャッシュします。
+ * 編集時は InvalidateHash() で祖先のキャッシュだけを無効化するため、
+ * 比較・再描画は変更のない部分木を読み飛ばせます。
  * 
- * 쐬: WBSJ`[
- * 쐬: 2024N
- * o[W: 1.0
+ * 【部分木の集計】
+ * 各 WBSItem は部分木全体の工数合計・タスク数・状態別のタスク数（WBSRollup）を
+ * キャッシュします。SetEstimatedHours() 等のセッター、AddChild() / InsertChild() /
+ * RemoveChild() は差分を親へ順に加算するため、更新は O(深さ)、合計の参照は O(1) です。
+ * フィールドや children を直接書き換えた場合は InvalidateRollup() を呼び出してください
+ * （次の参照時に無効化された経路だけを再計算します）。
+ * 
+ * 【IDによる検索】
+ * WBSProject::FindTask() は階層ID（"1.2.3"）を子の番号として根から辿り
+ * （O(深さ)。遅延読み込みの子はその経路だけを構築）、IDが番号どおりでない
+ * タスクはIDの索引（ハッシュ表）で探します。索引は最初の検索で構築済みのタスクから
+ * 作成し、遅延読み込みの範囲は構築された後の検索でその範囲だけを追加します。
+ * タスクの追加・削除・ID変更は WBSProject::AddTask() / InsertTask() / RemoveTask() /
+ * SetTaskId() / RenumberTasks() で行うと索引も更新されます（ルートの差し替えなど
+ * 木をまとめて書き換えた場合は InvalidateTaskIndex() を呼び出してください）。
+ * 
+ * 【階層ID】
+ * タスクのID（WBSItem::id）は番号の並び（WBSTaskId、WBSTaskId.h）で保持します。
+ * 子のIDは親のIDに番号を追加して構築し、比較は番号ごとの数値比較（"1.2" < "1.10"）、
+ * 文字列への変換はファイル・画面への出力時にのみ行います。RenumberChildren() による
+ * 部分木のIDの振り直しは、タスクごとのメモリ確保なしで行われます。
+ * 
+ * 【メモリ確保】
+ * 各 WBSProject はメモリアリーナ（WBSArena）を所有し、タスクは WBSItem::Create() /
+ * WBSProject::NewItem() によりアリーナ上に制御ブロックごと確保されます。
+ * アリーナに載るのはタスク本体・制御ブロックと説明・担当者名（ストア・プール）だけで、
+ * タスク名・子の配列・深いID（WBSTaskId の内部領域に収まらない段数）は汎用ヒープです。
+ * プロジェクトの破棄ではタスクごとのデストラクタが従来どおり実行され（O(タスク数)）、
+ * 省けるのはタスク本体の個別の free() だけです（ヒープへの返却はブロック単位）。
+ * タスクは必ずアリーナ（のテキストストア）を指定して作成し、プロセス共有の格納先は持ちません。
+ * 担当者名はアリーナが持つ文字列プール（WBSStringPool）にインターンされ、
+ * タスクはプールへのポインタと整数IDだけを保持します。
+ * 
+ * 【ホット／コールドの分離】
+ * WBSItem のメンバーは、ツリーの走査・集計で参照するもの（状態・日付・工数・親子関係）を
+ * 先頭にまとめて配置します。大きなテキストである説明はタスク本体に置かず、
+ * アリーナが持つテキストストア（WBSTextStore）に格納してIDだけを保持します。
+ * 読み込み処理は説明をファイル上の表現のまま登録し、復元は画面表示などで
+ * 最初に参照されたときに行います。
+ * 
+ * 【日時表現】
+ * 開始日・終了日は分単位の32ビット整数（WBSDateTime、WBSDateTime.h）で保持します。
+ * 期間による絞り込みや並べ替えは整数の比較で行い、SYSTEMTIME への変換
+ * （DateTimeToSystemTime()）はWin32 APIとの受け渡し時にのみ行います。
+ * タスクのモデル（このヘッダー）は windows.h なしでもビルドできます。
+ * 
+ * 【文字列表現】
+ * タスク・プロジェクトのテキストはUTF-8の std::string で保持します。
+ * ファイルの読み書きは変換なしでコピーし、wchar_t への変換（Utf8ToWide() /
+ * WideToUtf8()、WBSUtf8.h）はWin32 UIとの受け渡し時にのみ行います。
+ * 
+ * 【設計原則】
+ * - RAII: オブジェクトの自動的なリソース管理
+ * - 型安全性: 列挙クラスによる強い型付け
+ * - メモリ安全性: スマートポインタの活用
+ * - 拡張性: 将来の機能追加に対応した設計
+ * 
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
  * ============================================================================
  */
 
 #pragma once
 
+#ifdef _WIN32
 #include <windows.h>
 #include <commctrl.h>
 #include <windowsx.h>
+#endif
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdint>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_map>
+#include "WBSArena.h"
+#include "WBSStringPool.h"
+#include "WBSTextStore.h"
+#include "WBSDateTime.h"
+#include "WBSTaskId.h"
 
+#ifdef _WIN32
 // ============================================================================
-// Common Controls }N`⊮
+// Common Controls マクロ定義補完
 // ============================================================================
 
-// ComboBox}N`ĂȂꍇ̕⊮`
+// ComboBoxマクロが定義されていない場合の補完定義
 #ifndef ComboBox_AddString
 #define ComboBox_AddString(hwndCtl, lpsz) \
     ((int)(DWORD)SendMessage((hwndCtl), CB_ADDSTRING, 0L, (LPARAM)(LPCTSTR)(lpsz)))
@@ -53,7 +122,7 @@
     ((int)(DWORD)SendMessage((hwndCtl), CB_GETCURSEL, 0L, 0L))
 #endif
 
-// ComboBoxbZ[W萔̒`
+// ComboBoxメッセージ定数の定義
 #ifndef CB_ADDSTRING
 #define CB_ADDSTRING            0x0143
 #endif
@@ -65,166 +134,1026 @@
 #ifndef CB_GETCURSEL
 #define CB_GETCURSEL            0x0147
 #endif
+#endif // _WIN32
 
 // ============================================================================
-// 񋓌^`
+// 列挙型定義
 // ============================================================================
 
 /**
- * @brief WBS^XN̐isԂ\񋓌^
+ * @brief WBSタスクの進行状態を表す列挙型
  * 
- * vWFNgǗɂāAe^XŇ݂̏󋵂𖾊mɕނ邽߂Ɏgp܂B
- * i|[g̐AvWFNgŜ̏󋵔cɊp܂B
+ * プロジェクト管理において、各タスクの現在の状況を明確に分類するために使用します。
+ * 進捗レポートの生成や、プロジェクト全体の状況把握に活用されます。
  * 
- * @note ԑJڂ̐p^[:
- *       NOT_STARTED  IN_PROGRESS  COMPLETED
- *       OI ON_HOLD  CANCELLED ւ̕ύX\
+ * @note 状態遷移の推奨パターン:
+ *       NOT_STARTED → IN_PROGRESS → COMPLETED
+ *       例外的に ON_HOLD や CANCELLED への変更も可能
  */
 enum class TaskStatus {
-    NOT_STARTED = 0,    // Jn - ^XN܂JnĂȂ
-    IN_PROGRESS = 1,    // is - ^XNݎsĂ  
-    COMPLETED = 2,      //  - ^XNɊ
-    ON_HOLD = 3,        // ۗ - ꎞIɍƂ~Ă
-    CANCELLED = 4       // LZ - ^XN~ꂽ
+    NOT_STARTED = 0,    // 未開始 - タスクがまだ開始されていない状態
+    IN_PROGRESS = 1,    // 進行中 - タスクが現在実行されている状態  
+    COMPLETED = 2,      // 完了 - タスクが正常に完了した状態
+    ON_HOLD = 3,        // 保留 - 一時的に作業が停止されている状態
+    CANCELLED = 4       // キャンセル - タスクが中止された状態
 };
 
+const int kTaskStatusCount = 5;     ///< TaskStatus の値の数（状態別の集計用）
+
 /**
- * @brief WBS^XN̏dvxEً}x\񋓌^
+ * @brief WBSタスクの重要度・緊急度を表す列挙型
  * 
- * \[XzƏ̌AXPW[ɂ
- * ^XN̗D揇ʂ𔻒f邽߂Ɏgp܂B
+ * リソース配分や作業順序の決定、スケジュール調整において
+ * タスクの優先順位を判断するために使用します。
  * 
- * @note Dx̔f:
- *       URGENT: ɑΉKvi؂ꃊXN)
- *       HIGH: dvő߂̊KvivWFNgɒj
- *       MEDIUM: WIȗDxiʏ̍Əŏ)
- *       LOW: Ԃɗ]TꍇɎsi摗\)
+ * @note 優先度の判断基準:
+ *       URGENT: 即座に対応が必要（期限切れリスク高)
+ *       HIGH: 重要で早めの完了が必要（プロジェクト成功に直結）
+ *       MEDIUM: 標準的な優先度（通常の作業順序で処理)
+ *       LOW: 時間に余裕がある場合に実行（先送り可能)
  */
 enum class TaskPriority {
-    LOW = 0,            // Dx - Ԃɗ]TꍇɎs
-    MEDIUM = 1,         // Dx - WIȗDxx
-    HIGH = 2,           // Dx - dvő߂̊Kv
-    URGENT = 3          // ً} - ŗDőɑΉKv
+    LOW = 0,            // 低優先度 - 時間に余裕がある場合に実行
+    MEDIUM = 1,         // 中優先度 - 標準的な優先度レベル
+    HIGH = 2,           // 高優先度 - 重要で早めの完了が必要
+    URGENT = 3          // 緊急 - 最優先で即座に対応が必要
 };
 
 // ============================================================================
-// NX`
+// ハッシュ関数
 // ============================================================================
 
+const uint64_t kWBSHashSeed = 0xCBF29CE484222325ULL;   ///< FNV-1a 64ビットの初期値
+
+/**
+ * @brief バイト列でハッシュを更新（FNV-1a 64ビット）
+ */
+inline uint64_t UpdateWBSHash(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
 /**
- * @brief WBSiWork Breakdown Structureǰʍƍڂ\NX
+ * @brief 64ビット値でハッシュを更新（8バイトをまとめて混合）
+ */
+inline uint64_t UpdateWBSHash(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * @brief 文字列でハッシュを更新（長さを含めるため、フィールドの境界がずれても衝突しない）
+ */
+inline uint64_t UpdateWBSHash(uint64_t hash, const std::string& text) {
+    hash = UpdateWBSHash(hash, static_cast<uint64_t>(text.size()));
+    return UpdateWBSHash(hash, text.data(), text.size());
+}
+
+// ============================================================================
+// クラス定義
+// ============================================================================
+
+class WBSItem;
+
+/**
+ * @brief 部分木全体の集計値
+ *
+ * タスク自身とすべての子孫タスクの値の合計です。範囲外の状態の値は
+ * タスク数にだけ数えます。
+ */
+struct WBSRollup {
+    double estimatedHours = 0.0;                            ///< 見積もり工数の合計
+    double actualHours = 0.0;                               ///< 実績工数の合計
+    uint32_t taskCount = 0;                                 ///< タスク数（自身を含む）
+    uint32_t statusCounts[kTaskStatusCount] = {};           ///< 状態別のタスク数（TaskStatus の値で添字）
+
+    /**
+     * @brief 工数で重み付けした進捗率（WBSItem::GetProgressPercentage() と同じ規則）
+     */
+    double GetProgressPercentage() const {
+        if (estimatedHours == 0.0) return 0.0;
+        return (actualHours / estimatedHours) * 100.0;
+    }
+
+    /**
+     * @brief 指定した状態のタスク数
+     */
+    uint32_t GetStatusCount(TaskStatus status) const {
+        int index = static_cast<int>(status);
+        return (index >= 0 && index < kTaskStatusCount) ? statusCounts[index] : 0;
+    }
+
+    void Add(const WBSRollup& other) {
+        estimatedHours += other.estimatedHours;
+        actualHours += other.actualHours;
+        taskCount += other.taskCount;
+        for (int i = 0; i < kTaskStatusCount; ++i) statusCounts[i] += other.statusCounts[i];
+    }
+
+    void Subtract(const WBSRollup& other) {
+        estimatedHours -= other.estimatedHours;
+        actualHours -= other.actualHours;
+        taskCount -= other.taskCount;
+        for (int i = 0; i < kTaskStatusCount; ++i) statusCounts[i] -= other.statusCounts[i];
+    }
+};
+
+/**
+ * @brief 遅延読み込みされる子タスクの読み込み元
+ *
+ * 大きなプロジェクトを開くと、指定の深さより下の子タスクは構築されず、
+ * ファイル内の範囲だけが記録されます。実装（メモリマップしたXMLの
+ * <Children> 要素を解析するもの）は WBS_XML_Functions.cpp にあります。
+ * 読み込み元は変更されないため、複数のスレッドから同時に呼び出せます。
+ */
+class WBSDeferredChildSource {
+public:
+    virtual ~WBSDeferredChildSource() {}
+
+    /**
+     * @brief 範囲内の子タスクを構築して parent に追加
+     * @param parent 追加先のタスク
+     * @param begin 範囲の先頭（読み込み元の先頭からのオフセット）
+     * @param end 範囲の終端
+     * @return 範囲を解析できた場合true
+     */
+    virtual bool LoadChildren(WBSItem& parent, size_t begin, size_t end) = 0;
+};
+
+/**
+ * @brief まだ構築されていない子タスクの範囲
+ */
+struct WBSDeferredChildren {
+    std::shared_ptr<WBSDeferredChildSource> source;         ///< 読み込み元（範囲が残っている間は保持）
+    size_t begin = 0;                                       ///< 範囲の先頭
+    size_t end = 0;                                         ///< 範囲の終端
+    WBSRollup rollup;                                       ///< 範囲内のすべてのタスクの集計値（読み飛ばし時に計算）
+};
+
+/**
+ * @brief WBS（Work Breakdown Structure）の個別作業項目を表すクラス
  * 
- * vWFNg\X̃^XNTu^XN\AKw\`܂B
- * shared_from_thisp邱ƂŁASȎȎQƋ@\񋟂A
- * eq֌W̊ǗɂzQƂh܂B
+ * プロジェクトを構成する個々のタスクやサブタスクを表現し、階層構造を形成します。
+ * shared_from_thisを継承することで、安全な自己参照機能を提供し、
+ * 親子関係の管理における循環参照を防ぎます。
  */
 class WBSItem : public std::enable_shared_from_this<WBSItem> {
 public:
-    // oϐipublicANZX - ȈՓIȎ̂߁j
-    std::wstring id;                                        ///< ^XN̈ӎʎqiKwIIĎn)
-    std::wstring taskName;                                  ///< ^XN̖
-    std::wstring description;                               ///< ^XN̏ڍא
-    std::wstring assignedTo;                                ///< SҖ
-    TaskStatus status;                                      ///< ݂̐is
-    TaskPriority priority;                                  ///< Dxx
-    double estimatedHours;                                  ///< ςHiԒP)
-    double actualHours;                                     ///< эHiԒP)
-    SYSTEMTIME startDate;                                   ///< Jn\
-    SYSTEMTIME endDate;                                     ///< I\
-    int level;                                              ///< Kwxi0=[g)
-    std::vector<std::shared_ptr<WBSItem>> children;         ///< q^XÑRNV
-    std::weak_ptr<WBSItem> parent;                          ///< e^XNւ̎QƁizQƉj
+    // メンバ変数（publicアクセス - 簡易的な実装のため）
+    // ツリーの走査・集計で参照するフィールド（ホット）
+    TaskStatus status;                                      ///< 現在の進行状態
+    TaskPriority priority;                                  ///< 優先度レベル
+    int level;                                              ///< 階層レベル（0=ルート)
+    WBSDateTime startDate;                                  ///< 開始予定日（UTC、分単位）
+    WBSDateTime endDate;                                    ///< 終了予定日（UTC、分単位）
+    double estimatedHours;                                  ///< 見積もり工数（時間単位)
+    double actualHours;                                     ///< 実績工数（時間単位)
+    std::vector<std::shared_ptr<WBSItem>> children;         ///< 子タスクのコレクション
+    std::weak_ptr<WBSItem> parent;                          ///< 親タスクへの弱参照（循環参照回避）
+
+    // 表示・保存で参照するフィールド（コールド）
+    WBSTaskId id;                                           ///< タスクの一意識別子（階層的なID体系。番号の並び）
+    std::string taskName;                                   ///< タスクの名称（UTF-8）
+    WBSInternedString assignedTo;                           ///< 担当者名（アリーナのプールにインターン。比較はIDで行う）
+    WBSColdText description;                                ///< タスクの詳細説明（テキストストアに格納。参照時に復元）
+    std::shared_ptr<const WBSDeferredChildren> deferredChildren; ///< 未構築の子タスク（遅延読み込み時のみ）
 
     /**
-     * @brief ftHgRXgN^
+     * @brief コンストラクタ
+     * @param arena 説明・担当者名の格納先（タスクより長く生存すること）
      */
-    WBSItem() : status(TaskStatus::NOT_STARTED), priority(TaskPriority::MEDIUM), 
-                estimatedHours(0.0), actualHours(0.0), level(0) {
-        GetSystemTime(&startDate);
-        GetSystemTime(&endDate);
-        taskName = L"V^XN";
+    explicit WBSItem(WBSArena& arena)
+        : status(TaskStatus::NOT_STARTED), priority(TaskPriority::MEDIUM), level(0),
+          startDate(WBSDateTime::Now()), endDate(startDate),
+          estimatedHours(0.0), actualHours(0.0),
+          assignedTo(arena.Strings()), description(arena.Texts()),
+          subtreeHash_(0), subtreeHashValid_(false), rollupValid_(false) {
+        taskName = u8"新しいタスク";
     }
 
     /**
-     * @brief OwRXgN^
+     * @brief タスクを作成（アリーナ指定）
+     * @param arena 確保元のアリーナ（nullptr の場合は std::invalid_argument を送出）
+     * @return 作成したタスク（既定値で初期化済み）
+     *
+     * タスクは制御ブロックと共にアリーナ上に1回の確保で配置され、説明は
+     * アリーナのテキストストアに、担当者名はアリーナの文字列プールに格納されます。読み込み処理や編集でプロジェクトに
+     * タスクを追加する場合は、プロジェクトのアリーナ（WBSProject::arena）を指定してください。
      */
-    WBSItem(const std::wstring& name) : WBSItem() {
-        taskName = name;
+    static std::shared_ptr<WBSItem> Create(const std::shared_ptr<WBSArena>& arena) {
+        if (!arena) {
+            throw std::invalid_argument("WBSItem::Create: arena is null");
+        }
+        return std::allocate_shared<WBSItem>(WBSArenaAllocator<WBSItem>(arena), *arena);
     }
 
     /**
-     * @brief q^XNKw\ɒǉ
+     * @brief 子タスクを階層構造に追加
      */
     void AddChild(std::shared_ptr<WBSItem> child) {
+        LoadDeferredChildren(); // 既存の子の後ろに追加する
         child->parent = shared_from_this();
         child->level = this->level + 1;
-        child->id = this->id + L"." + std::to_wstring(children.size() + 1);
+        child->id.AssignChild(this->id, static_cast<uint32_t>(children.size() + 1));
+        child->subtreeHashValid_ = false;
         children.push_back(child);
+        InvalidateHash();
+        if (rollupValid_) {
+            UpdateRollups(child->GetRollup(), WBSRollup());
+        }
+    }
+
+    /**
+     * @brief 子タスクを指定位置に挿入（ID・階層レベルは変更しない）
+     * @param index 挿入位置（children.size() 以下）
+     */
+    void InsertChild(size_t index, std::shared_ptr<WBSItem> child) {
+        LoadDeferredChildren();
+        child->parent = shared_from_this();
+        children.insert(children.begin() + index, child);
+        InvalidateHash();
+        if (rollupValid_) {
+            UpdateRollups(child->GetRollup(), WBSRollup());
+        }
+    }
+
+    /**
+     * @brief 子タスクを取り除く
+     * @param index 取り除く位置（children.size() 未満）
+     * @return 取り除いた子タスク（親は未設定になる）
+     */
+    std::shared_ptr<WBSItem> RemoveChild(size_t index) {
+        LoadDeferredChildren();
+        std::shared_ptr<WBSItem> child = children[index];
+        if (rollupValid_ && child) {
+            UpdateRollups(WBSRollup(), child->GetRollup());
+        }
+        children.erase(children.begin() + index);
+        InvalidateHash();
+        if (child) {
+            child->parent.reset();
+        }
+        return child;
+    }
+
+    /**
+     * @brief 子孫タスクのIDを子の位置どおりに振り直す（自身のIDは変更しない）
+     *
+     * 各子タスクのIDを「親のID + 位置（1から）」に、階層レベルを親の次に設定します。
+     * IDは既存の領域に上書きするため、6段までのIDではメモリを確保しません。
+     * 遅延読み込みの子タスクは構築してから振り直します。
+     */
+    void RenumberChildren() {
+        LoadDeferredChildren();
+        for (size_t i = 0; i < children.size(); ++i) {
+            WBSItem* child = children[i].get();
+            if (child) {
+                child->id.AssignChild(id, static_cast<uint32_t>(i + 1));
+                child->level = level + 1;
+                child->subtreeHashValid_ = false; // 祖先は下の InvalidateHash() で無効化する
+                child->RenumberChildren();
+            }
+        }
+        InvalidateHash();
+    }
+
+    /**
+     * @brief 見積もり工数を設定（祖先の集計も更新）
+     */
+    void SetEstimatedHours(double hours) {
+        WBSRollup before = GetOwnRollup();
+        estimatedHours = hours;
+        OnOwnRollupChanged(before);
+    }
+
+    /**
+     * @brief 実績工数を設定（祖先の集計も更新）
+     */
+    void SetActualHours(double hours) {
+        WBSRollup before = GetOwnRollup();
+        actualHours = hours;
+        OnOwnRollupChanged(before);
+    }
+
+    /**
+     * @brief 進行状態を設定（祖先の集計も更新）
+     */
+    void SetStatus(TaskStatus value) {
+        WBSRollup before = GetOwnRollup();
+        status = value;
+        OnOwnRollupChanged(before);
+    }
+
+    /**
+     * @brief 部分木全体を複製（ディープコピー）
+     *
+     * 子タスクも再帰的に複製し、複製どうしで親子関係を設定します。
+     * 戻り値の親は未設定です。バックグラウンド保存のスナップショットなど、
+     * 元のツリーと独立して読み書きしたい場合に使用します。
+     *
+     * @param arena 複製の確保元のアリーナ
+     */
+    std::shared_ptr<WBSItem> CloneSubtree(const std::shared_ptr<WBSArena>& arena) const {
+        auto copy = Create(arena);
+        copy->id = id;
+        copy->taskName = taskName;
+        copy->description = description;            // 複製先のストアへ符号化されたまま複製
+        copy->assignedTo = assignedTo;
+        copy->status = status;
+        copy->priority = priority;
+        copy->estimatedHours = estimatedHours;
+        copy->actualHours = actualHours;
+        copy->startDate = startDate;
+        copy->endDate = endDate;
+        copy->level = level;
+        copy->deferredChildren = deferredChildren; // 未構築の範囲は読み込み元を共有
+        copy->subtreeHash_ = subtreeHash_;         // 内容が同じためハッシュ・集計も引き継ぐ
+        copy->subtreeHashValid_ = subtreeHashValid_;
+        copy->rollup_ = rollup_;
+        copy->rollupValid_ = rollupValid_;
+        copy->children.reserve(children.size());
+        for (const auto& child : children) {
+            if (child) {
+                auto childCopy = child->CloneSubtree(arena);
+                childCopy->parent = copy;
+                copy->children.push_back(childCopy);
+            }
+        }
+        return copy;
+    }
+
+    /**
+     * @brief 遅延読み込みされた子タスクが残っているか判定
+     *
+     * true の場合、children はまだ空で、子タスクはファイル内にだけ存在します。
+     */
+    bool HasDeferredChildren() const {
+        return deferredChildren != nullptr;
+    }
+
+    /**
+     * @brief 遅延読み込みされた子タスク（直下の1階層）を構築
+     * @return 構築できた場合（遅延読み込みでない場合を含む）true
+     *
+     * ツリーの展開時や、子タスクの位置を参照する処理の前に呼び出します。
+     * 構築された子タスクの子は、引き続き遅延読み込みのまま残ります。
+     */
+    bool LoadDeferredChildren() {
+        if (!deferredChildren) {
+            return true;
+        }
+        std::shared_ptr<const WBSDeferredChildren> deferred = std::move(deferredChildren);
+        deferredChildren = nullptr;
+        if (!deferred->source->LoadChildren(*this, deferred->begin, deferred->end)) {
+            deferredChildren = deferred; // 失敗した場合は再試行できるよう範囲を残す
+            return false;
+        }
+        InvalidateHash(); // 範囲に代わり構築した子タスクでハッシュを計算し直す
+        InvalidateRollup();
+        return true;
+    }
+
+    /**
+     * @brief 部分木全体の遅延読み込みを完了
+     * @return すべて構築できた場合true
+     *
+     * 保存など、部分木全体を走査する処理の前に呼び出します。
+     */
+    bool LoadDeferredSubtree() {
+        if (!LoadDeferredChildren()) {
+            return false;
+        }
+        for (const auto& child : children) {
+            if (child && !child->LoadDeferredSubtree()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief タスク自身のフィールドのハッシュを計算（子タスクを含まない）
+     */
+    uint64_t GetFieldHash() const {
+        uint64_t hash = kWBSHashSeed;
+        hash = UpdateWBSHash(hash, id.Hash());
+        hash = UpdateWBSHash(hash, taskName);
+        hash = UpdateWBSHash(hash, description.Hash()); // 説明は復元せずに登録時のハッシュを使う
+        hash = UpdateWBSHash(hash, assignedTo.Hash());  // プールによらない内容のハッシュ
+        hash = UpdateWBSHash(hash, (static_cast<uint64_t>(status) << 32) | static_cast<uint32_t>(priority));
+        hash = UpdateWBSHash(hash, &estimatedHours, sizeof(estimatedHours));
+        hash = UpdateWBSHash(hash, &actualHours, sizeof(actualHours));
+        hash = UpdateWBSHash(hash, (static_cast<uint64_t>(startDate.Minutes()) << 32) | endDate.Minutes());
+        return UpdateWBSHash(hash, static_cast<uint64_t>(static_cast<int64_t>(level)));
+    }
+
+    /**
+     * @brief 部分木全体の内容ハッシュ（Merkleハッシュ）を取得
+     *
+     * 自身のフィールドのハッシュに、子タスクの部分木ハッシュを順に組み合わせた値です。
+     * 計算結果はキャッシュされ、InvalidateHash() が呼ばれるまで再利用されるため、
+     * 編集後の再計算は変更されたタスクから根までの経路上だけで行われます。
+     *
+     * @note 未構築の子タスク（遅延読み込み）は読み込み元と範囲で代用するため、
+     *       構築の前後で値が変わります。値はプロセス内でのみ有効で、保存はしません。
+     */
+    uint64_t GetSubtreeHash() const {
+        if (subtreeHashValid_) {
+            return subtreeHash_;
+        }
+        uint64_t hash = UpdateWBSHash(GetFieldHash(), static_cast<uint64_t>(children.size()));
+        for (const auto& child : children) {
+            hash = UpdateWBSHash(hash, child ? child->GetSubtreeHash() : 0);
+        }
+        if (deferredChildren) {
+            hash = UpdateWBSHash(hash, reinterpret_cast<uintptr_t>(deferredChildren->source.get()));
+            hash = UpdateWBSHash(hash, static_cast<uint64_t>(deferredChildren->begin));
+            hash = UpdateWBSHash(hash, static_cast<uint64_t>(deferredChildren->end));
+        }
+        subtreeHash_ = hash;
+        subtreeHashValid_ = true;
+        return hash;
+    }
+
+    /**
+     * @brief 自身と祖先の部分木ハッシュを無効化
+     *
+     * フィールドを直接書き換えた後はそのタスクで、children を直接変更した
+     * （子を挿入・削除した）後は親タスクで呼び出してください。
+     * 無効化済みのタスクの祖先は必ず無効化済みのため、そこで打ち切ります。
+     */
+    void InvalidateHash() {
+        if (!subtreeHashValid_) {
+            return;
+        }
+        subtreeHashValid_ = false;
+        for (auto ancestor = parent.lock(); ancestor && ancestor->subtreeHashValid_; ancestor = ancestor->parent.lock()) {
+            ancestor->subtreeHashValid_ = false;
+        }
+    }
+
+    /**
+     * @brief 部分木全体の集計値を取得
+     *
+     * 計算結果はキャッシュされ、セッターや AddChild() / RemoveChild() による編集では
+     * 差分だけが更新されるため、通常は O(1) で返ります。キャッシュが無効な場合は
+     * 無効なタスクだけを再計算します。
+     *
+     * @note 遅延読み込みの子タスクは構築せず、読み飛ばした時点で記録した
+     *       範囲の集計値（WBSDeferredChildren::rollup）を加えます。
+     */
+    const WBSRollup& GetRollup() const {
+        if (!rollupValid_) {
+            WBSRollup rollup = GetOwnRollup();
+            if (deferredChildren) {
+                rollup.Add(deferredChildren->rollup);
+            }
+            for (const auto& child : children) {
+                if (child) {
+                    rollup.Add(child->GetRollup());
+                }
+            }
+            rollup_ = rollup;
+            rollupValid_ = true;
+        }
+        return rollup_;
+    }
+
+    /**
+     * @brief 部分木全体の見積もり工数合計
+     */
+    double GetTotalEstimatedHours() const { return GetRollup().estimatedHours; }
+
+    /**
+     * @brief 部分木全体の実績工数合計
+     */
+    double GetTotalActualHours() const { return GetRollup().actualHours; }
+
+    /**
+     * @brief 部分木全体の進捗率（工数で重み付け）
+     */
+    double GetTotalProgressPercentage() const { return GetRollup().GetProgressPercentage(); }
+
+    /**
+     * @brief 自身と祖先の集計値のキャッシュを無効化
+     *
+     * 工数・状態を直接書き換えた後はそのタスクで、children を直接変更した後は
+     * 親タスクで呼び出してください。無効化済みのタスクの祖先は必ず無効化済みです。
+     */
+    void InvalidateRollup() {
+        if (!rollupValid_) {
+            return;
+        }
+        rollupValid_ = false;
+        for (auto ancestor = parent.lock(); ancestor && ancestor->rollupValid_; ancestor = ancestor->parent.lock()) {
+            ancestor->rollupValid_ = false;
+        }
     }
 
     /**
-     * @brief ^XN̏Ԃ{ꕶŎ擾
+     * @brief タスクの状態を日本語文字列で取得
      */
     std::wstring GetStatusString() const {
         switch (status) {
-            case TaskStatus::NOT_STARTED: return L"Jn";
-            case TaskStatus::IN_PROGRESS: return L"is";
-            case TaskStatus::COMPLETED: return L"";
-            case TaskStatus::ON_HOLD: return L"ۗ";
-            case TaskStatus::CANCELLED: return L"LZ";
-            default: return L"Jn";
+            case TaskStatus::NOT_STARTED: return L"未開始";
+            case TaskStatus::IN_PROGRESS: return L"進行中";
+            case TaskStatus::COMPLETED: return L"完了";
+            case TaskStatus::ON_HOLD: return L"保留";
+            case TaskStatus::CANCELLED: return L"キャンセル";
+            default: return L"未開始";
         }
     }
 
     /**
-     * @brief ^XN̗Dx{ꕶŎ擾
+     * @brief タスクの優先度を日本語文字列で取得
      */
     std::wstring GetPriorityString() const {
         switch (priority) {
-            case TaskPriority::LOW: return L"";
-            case TaskPriority::MEDIUM: return L"";
-            case TaskPriority::HIGH: return L"";
-            case TaskPriority::URGENT: return L"ً}";
-            default: return L"";
+            case TaskPriority::LOW: return L"低";
+            case TaskPriority::MEDIUM: return L"中";
+            case TaskPriority::HIGH: return L"高";
+            case TaskPriority::URGENT: return L"緊急";
+            default: return L"中";
         }
     }
 
     /**
-     * @brief ^XN̐ivZ
+     * @brief タスクの進捗率を計算
      */
     double GetProgressPercentage() const {
         if (estimatedHours == 0.0) return 0.0;
         return (actualHours / estimatedHours) * 100.0;
     }
+
+private:
+    /**
+     * @brief タスク自身だけの集計値（子タスクを含まない）
+     */
+    WBSRollup GetOwnRollup() const {
+        WBSRollup rollup;
+        rollup.estimatedHours = estimatedHours;
+        rollup.actualHours = actualHours;
+        rollup.taskCount = 1;
+        int index = static_cast<int>(status);
+        if (index >= 0 && index < kTaskStatusCount) {
+            rollup.statusCounts[index] = 1;
+        }
+        return rollup;
+    }
+
+    /**
+     * @brief セッターで自身の値が変わった後の処理（ハッシュの無効化と集計の差分更新）
+     */
+    void OnOwnRollupChanged(const WBSRollup& before) {
+        InvalidateHash();
+        WBSRollup after = GetOwnRollup();
+        if (!std::isfinite(before.estimatedHours) || !std::isfinite(before.actualHours) ||
+            !std::isfinite(after.estimatedHours) || !std::isfinite(after.actualHours)) {
+            InvalidateRollup(); // 無限大・NaN は差分で打ち消せないため再計算する
+            return;
+        }
+        UpdateRollups(after, before);
+    }
+
+    /**
+     * @brief 自身と祖先の有効な集計値に差分を反映（O(深さ)）
+     * @param added 部分木に加わった値
+     * @param removed 部分木から取り除かれた値
+     *
+     * 無効なタスクの祖先はすべて無効のため、最初の無効なタスクで打ち切ります。
+     */
+    void UpdateRollups(const WBSRollup& added, const WBSRollup& removed) {
+        if (!rollupValid_) {
+            return;
+        }
+        rollup_.Add(added);
+        rollup_.Subtract(removed);
+        for (auto ancestor = parent.lock(); ancestor && ancestor->rollupValid_; ancestor = ancestor->parent.lock()) {
+            ancestor->rollup_.Add(added);
+            ancestor->rollup_.Subtract(removed);
+        }
+    }
+
+    mutable uint64_t subtreeHash_;          ///< 部分木ハッシュのキャッシュ
+    mutable bool subtreeHashValid_;         ///< キャッシュが有効か（無効なら祖先もすべて無効）
+    mutable WBSRollup rollup_;              ///< 部分木の集計値のキャッシュ
+    mutable bool rollupValid_;              ///< キャッシュが有効か（無効なら祖先もすべて無効）
 };
 
 /**
- * @brief WBSvWFNgŜ𓝊ǗNX
+ * @brief WBSプロジェクト全体を統括管理するクラス
  * 
- * vWFNgxł̃^f[^ǗA[g^XNʂ
- * SĂ̊Kw^XNւ̈ꌳIȃANZX|Cg񋟂܂B
+ * プロジェクトレベルでのメタデータを管理し、ルートタスクを通じて
+ * 全ての階層タスクへの一元的なアクセスポイントを提供します。
  */
 class WBSProject {
 public:
-    std::wstring projectName;                               ///< vWFNg̐
-    std::wstring description;                               ///< vWFNg̊Tv
-    std::shared_ptr<WBSItem> rootTask;                      ///< S^XN̍ŏʃm[h
+    std::string projectName;                                ///< プロジェクトの正式名称（UTF-8）
+    std::string description;                                ///< プロジェクトの概要説明（UTF-8）
+    std::shared_ptr<WBSArena> arena;                        ///< タスクの確保元（タスクからも共有される）
+    std::shared_ptr<WBSItem> rootTask;                      ///< 全タスクの最上位ノード
 
     /**
-     * @brief ftHgRXgN^
+     * @brief デフォルトコンストラクタ
      */
-    WBSProject() {
-        projectName = L"VKWBSvWFNg";
-        rootTask = std::make_shared<WBSItem>(projectName);
-        rootTask->id = L"1";
-        rootTask->level = 0;
+    WBSProject() : WBSProject(u8"新規WBSプロジェクト", std::make_shared<WBSArena>()) {
     }
 
     /**
-     * @brief OwRXgN^
+     * @brief 名前指定コンストラクタ
      */
-    WBSProject(const std::wstring& name) : WBSProject() {
+    WBSProject(const std::string& name) : WBSProject(name, std::make_shared<WBSArena>()) {
+    }
+
+    /**
+     * @brief 名前・アリーナ指定コンストラクタ
+     * @param name プロジェクト名（UTF-8）
+     * @param taskArena 読み込み処理がタスクの構築に使用したアリーナ
+     */
+    WBSProject(const std::string& name, std::shared_ptr<WBSArena> taskArena)
+        : arena(std::move(taskArena)), taskIndexValid_(false), indexedRoot_(nullptr) {
         projectName = name;
-        rootTask->taskName = name;
+        rootTask = NewItem(name);
+        const uint32_t rootOrdinal = 1;
+        rootTask->id = WBSTaskId::FromOrdinals(&rootOrdinal, 1);
+        rootTask->level = 0;
+    }
+
+    /**
+     * @brief プロジェクトのアリーナ上にタスクを作成
+     * @param name タスク名（UTF-8）
+     * @return 作成したタスク（親は未設定）
+     */
+    std::shared_ptr<WBSItem> NewItem(const std::string& name) const {
+        auto item = WBSItem::Create(arena);
+        item->taskName = name;
+        return item;
+    }
+
+    /**
+     * @brief 遅延読み込みされたタスクをすべて構築
+     * @return すべて構築できた場合true
+     *
+     * 完了すると読み込み元のファイルは参照されなくなり、マップが解放されます。
+     */
+    bool LoadDeferredTasks() {
+        return !rootTask || rootTask->LoadDeferredSubtree();
+    }
+
+    /**
+     * @brief プロジェクト全体の総見積もり工数（ルートの集計値を参照するため O(1)）
+     */
+    double GetTotalEstimatedHours() const {
+        return rootTask ? rootTask->GetTotalEstimatedHours() : 0.0;
+    }
+
+    /**
+     * @brief プロジェクト全体の総実績工数
+     */
+    double GetTotalActualHours() const {
+        return rootTask ? rootTask->GetTotalActualHours() : 0.0;
+    }
+
+    /**
+     * @brief プロジェクト全体の進捗率（全タスクの実績工数合計 / 見積もり工数合計）
+     */
+    double GetOverallProgress() const {
+        return rootTask ? rootTask->GetTotalProgressPercentage() : 0.0;
+    }
+
+    /**
+     * @brief プロジェクト全体の内容ハッシュを取得
+     *
+     * プロジェクト名・説明とルートタスクの部分木ハッシュを組み合わせた値です。
+     */
+    uint64_t GetContentHash() const {
+        uint64_t hash = UpdateWBSHash(kWBSHashSeed, projectName);
+        hash = UpdateWBSHash(hash, description);
+        return UpdateWBSHash(hash, rootTask ? rootTask->GetSubtreeHash() : 0);
+    }
+
+    /**
+     * @brief プロジェクト全体を複製（ディープコピー）
+     * @return 元のプロジェクトと木を共有しない複製
+     */
+    std::unique_ptr<WBSProject> Clone() const {
+        auto copy = std::make_unique<WBSProject>(projectName);
+        copy->description = description;
+        copy->rootTask = rootTask ? rootTask->CloneSubtree(copy->arena) : nullptr;
+        return copy;
+    }
+
+    /**
+     * @brief 保存用のスナップショットを作成（アリーナ・テキストストアを共有する複製）
+     * @return タスクの木だけを複製したプロジェクト（遅延読み込みの子は範囲を共有）
+     *
+     * Clone() と異なり、説明はテキストストアのIDをそのまま引き継ぐため、テキストの
+     * 複製・ストアの排他を行いません（登録済みのテキストは変更されないため、元の
+     * プロジェクトの編集はスナップショットに影響しません）。複製するのはタスク本体と
+     * 子の配列だけで、27万タスクで約0.1秒です（Clone() の約半分）。
+     * アリーナはスナップショットが破棄されるまで解放されません。
+     */
+    std::unique_ptr<WBSProject> Snapshot() const {
+        auto copy = std::make_unique<WBSProject>(projectName, arena);
+        copy->description = description;
+        copy->rootTask = rootTask ? rootTask->CloneSubtree(arena) : nullptr;
+        return copy;
+    }
+
+    // ------------------------------------------------------------------------
+    // IDによる検索
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 階層IDでタスクを検索
+     * @param id タスクID（"1.2.3" 等）
+     * @return 見つかったタスク（見つからない場合はnullptr。IDが重複する場合はそのいずれか）
+     *
+     * 番号どおりのIDは FindTaskByOrdinals() により O(深さ) で見つかります。
+     * それ以外のIDはIDの索引から探し（平均 O(1)）、遅延読み込みの子タスクは
+     * 構築しません（未構築の範囲にある番号どおりでないIDは見つからない）。
+     */
+    std::shared_ptr<WBSItem> FindTask(const std::string& id) const {
+        return FindTask(WBSTaskId(id));
+    }
+
+    /**
+     * @brief 階層IDでタスクを検索（解析済みのID）
+     * @param except 検索から除くタスク（nullptrの場合は除かない。マージでのIDの重複確認用）
+     */
+    std::shared_ptr<WBSItem> FindTask(const WBSTaskId& id, const WBSItem* except = nullptr) const {
+        std::shared_ptr<WBSItem> item = FindTaskByOrdinals(id);
+        if ((item && item.get() != except) || !rootTask) {
+            return item;
+        }
+        if (!taskIndexValid_ || indexedRoot_ != rootTask.get()) {
+            RebuildTaskIndex();
+        }
+        bool stale = false;
+        item = LookupTaskIndex(id, except, stale);
+        if (!item && stale) {
+            RebuildTaskIndex(); // 索引を通さずに書き換えられた木
+            item = LookupTaskIndex(id, except, stale);
+        }
+        if (!item && !pendingRanges_.empty() && IndexLoadedRanges()) {
+            item = LookupTaskIndex(id, except, stale);
+        }
+        return item;
+    }
+
+    // ------------------------------------------------------------------------
+    // 索引を更新する編集
+    // ------------------------------------------------------------------------
+
+    /**
+     * @brief 子タスクを末尾に追加し、索引に登録（IDは親の下の位置に振られる）
+     */
+    void AddTask(WBSItem& parentItem, const std::shared_ptr<WBSItem>& child) {
+        parentItem.AddChild(child);
+        if (taskIndexValid_) {
+            IndexSubtree(child.get());
+        }
+    }
+
+    /**
+     * @brief 子タスクを指定位置に挿入し、索引に登録（ID・階層レベルは変更しない）
+     * @param index 挿入位置（parentItem.children.size() 以下）
+     */
+    void InsertTask(WBSItem& parentItem, size_t index, const std::shared_ptr<WBSItem>& child) {
+        parentItem.InsertChild(index, child);
+        if (taskIndexValid_) {
+            IndexSubtree(child.get());
+        }
+    }
+
+    /**
+     * @brief 子タスクを取り除き、その部分木を索引から削除
+     * @param index 取り除く位置（parentItem.children.size() 未満）
+     * @return 取り除いた子タスク
+     */
+    std::shared_ptr<WBSItem> RemoveTask(WBSItem& parentItem, size_t index) {
+        std::shared_ptr<WBSItem> child = parentItem.RemoveChild(index);
+        if (taskIndexValid_ && child) {
+            UnindexSubtree(child.get());
+        }
+        return child;
+    }
+
+    /**
+     * @brief タスクのIDを変更し、索引を更新（子孫のIDは変更しない）
+     */
+    void SetTaskId(WBSItem& item, const WBSTaskId& id) {
+        if (taskIndexValid_) {
+            UnindexTask(&item);
+        }
+        item.id = id;
+        item.InvalidateHash();
+        if (taskIndexValid_) {
+            IndexTask(&item);
+        }
+    }
+
+    /**
+     * @brief 子孫タスクのIDを子の位置どおりに振り直し、索引を更新
+     *
+     * WBSItem::RenumberChildren() と同じく遅延読み込みの子タスクを構築します。
+     */
+    void RenumberTasks(WBSItem& item) {
+        if (!taskIndexValid_) {
+            item.RenumberChildren();
+            return;
+        }
+        item.LoadDeferredChildren();
+        for (const auto& child : item.children) {
+            UnindexSubtree(child.get());
+        }
+        item.RenumberChildren();
+        for (const auto& child : item.children) {
+            IndexSubtree(child.get());
+        }
+    }
+
+    /**
+     * @brief IDの索引を破棄（次の FindTask() で構築済みのタスクから作り直す）
+     *
+     * rootTask の差し替えや children・id の直接の書き換えなど、索引を更新する
+     * 編集関数を通さずに木を変更した後に呼び出します。
+     */
+    void InvalidateTaskIndex() {
+        taskIndex_.clear();
+        pendingRanges_.clear();
+        taskIndexValid_ = false;
+        indexedRoot_ = nullptr;
+    }
+
+    /**
+     * @brief 階層IDを子の番号として根から辿ってタスクを検索（ハッシュ計算なし）
+     * @return IDが番号どおりに振られているタスク（それ以外はnullptr）
+     *
+     * "1.2.3" はルート（ID "1"）の2番目の子の3番目の子を指します。途中の遅延読み込みの
+     * 子タスクは、その階層だけを構築します。辿り着いたタスクのIDが一致しない場合
+     * （並べ替えやマージでIDが番号とずれたタスク）はnullptrを返します。
+     */
+    std::shared_ptr<WBSItem> FindTaskByOrdinals(const WBSTaskId& id) const {
+        if (!rootTask || !id.StartsWith(rootTask->id)) {
+            return nullptr;
+        }
+        std::shared_ptr<WBSItem> item = rootTask;
+        for (size_t level = rootTask->id.Depth(); level < id.Depth(); ++level) {
+            size_t ordinal = id.Ordinal(level);
+            if (!item->LoadDeferredChildren() || ordinal == 0 || ordinal > item->children.size() ||
+                !item->children[ordinal - 1]) {
+                return nullptr;
+            }
+            item = item->children[ordinal - 1];
+        }
+        return item->id == id ? item : nullptr;
+    }
+
+private:
+    typedef std::unordered_multimap<WBSTaskId, std::weak_ptr<WBSItem>, WBSTaskIdHash> TaskIndex;
+
+    mutable TaskIndex taskIndex_;                              ///< IDの索引（構築済みのタスクのみ）
+    mutable std::vector<std::weak_ptr<WBSItem>> pendingRanges_; ///< 子が未構築のまま索引に登録したタスク
+    mutable bool taskIndexValid_;                              ///< 索引が作成済みか
+    mutable const WBSItem* indexedRoot_;                       ///< 索引を作成したときのルート
+
+    /**
+     * @brief 構築済みのタスクから索引を作り直す（遅延読み込みの子は構築しない）
+     */
+    void RebuildTaskIndex() const {
+        taskIndex_.clear();
+        pendingRanges_.clear();
+        taskIndexValid_ = true;
+        indexedRoot_ = rootTask.get();
+        IndexSubtree(rootTask.get());
+    }
+
+    /**
+     * @brief 索引からIDが一致し、現在の木に含まれるタスクを探す
+     * @param stale 索引の内容が木と食い違っていた場合にtrueを設定
+     */
+    std::shared_ptr<WBSItem> LookupTaskIndex(const WBSTaskId& id, const WBSItem* except, bool& stale) const {
+        auto range = taskIndex_.equal_range(id);
+        for (auto it = range.first; it != range.second; ++it) {
+            std::shared_ptr<WBSItem> item = it->second.lock();
+            if (!item || item->id != id || !IsAttached(*item)) {
+                stale = true;
+            } else if (item.get() != except) {
+                return item;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief 登録後に構築された遅延読み込みの範囲を索引に追加
+     * @return 追加した範囲があった場合true
+     */
+    bool IndexLoadedRanges() const {
+        std::vector<std::weak_ptr<WBSItem>> ranges;
+        ranges.swap(pendingRanges_);
+        bool added = false;
+        for (const auto& range : ranges) {
+            std::shared_ptr<WBSItem> item = range.lock();
+            if (!item || !IsAttached(*item)) {
+                continue; // 削除されたタスク
+            }
+            if (item->HasDeferredChildren()) {
+                pendingRanges_.push_back(range);
+                continue;
+            }
+            for (const auto& child : item->children) {
+                IndexSubtree(child.get());
+            }
+            added = true;
+        }
+        return added;
+    }
+
+    /**
+     * @brief タスクが現在のルートの部分木に含まれるか（O(深さ)）
+     */
+    bool IsAttached(const WBSItem& item) const {
+        const WBSItem* current = &item;
+        std::shared_ptr<WBSItem> parentItem;
+        while (current != rootTask.get()) {
+            parentItem = current->parent.lock();
+            if (!parentItem) {
+                return false;
+            }
+            current = parentItem.get();
+        }
+        return true;
+    }
+
+    void IndexTask(WBSItem* item) const {
+        auto range = taskIndex_.equal_range(item->id);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.lock().get() == item) {
+                return; // 登録済み
+            }
+        }
+        taskIndex_.emplace(item->id, item->shared_from_this());
+    }
+
+    void UnindexTask(const WBSItem* item) const {
+        auto range = taskIndex_.equal_range(item->id);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second.lock().get() == item) {
+                taskIndex_.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief 部分木の構築済みのタスクを索引に登録（子が未構築のタスクは後で追加する）
+     */
+    void IndexSubtree(WBSItem* subtreeRoot) const {
+        if (!subtreeRoot) {
+            return;
+        }
+        std::vector<WBSItem*> stack(1, subtreeRoot);
+        while (!stack.empty()) {
+            WBSItem* current = stack.back();
+            stack.pop_back();
+            IndexTask(current);
+            if (current->HasDeferredChildren()) {
+                pendingRanges_.push_back(current->shared_from_this());
+            }
+            for (const auto& child : current->children) {
+                if (child) {
+                    stack.push_back(child.get());
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief 部分木の構築済みのタスクを索引から削除
+     */
+    void UnindexSubtree(const WBSItem* subtreeRoot) const {
+        if (!subtreeRoot) {
+            return;
+        }
+        std::vector<const WBSItem*> stack(1, subtreeRoot);
+        while (!stack.empty()) {
+            const WBSItem* current = stack.back();
+            stack.pop_back();
+            UnindexTask(current);
+            for (const auto& child : current->children) {
+                if (child) {
+                    stack.push_back(child.get());
+                }
+            }
+        }
     }
 };
\ No newline at end of file
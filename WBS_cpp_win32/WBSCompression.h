@@ -0,0 +1,551 @@
+/*
+ * ============================================================================
+ * WBSCompression.h - WBSアプリケーション 圧縮コンテナ形式（.wbsz）
+ * ============================================================================
+ *
+ * このヘッダーファイルは、プロジェクトXMLを圧縮して保存するためのコンテナ形式と、
+ * 外部ライブラリに依存しないLZ77系のブロック圧縮・展開を提供します。
+ * XMLはタグ名・インデント・担当者名が繰り返し現れるため、短い距離の
+ * 一致を探すだけで大きく縮みます。
+ *
+ * 【ファイル構造】（全てリトルエンディアン）
+ * +----------------------------------+
+ * | WBSCompressedHeader (12バイト)     |  識別子・バージョン・圧縮レベル・ブロックサイズ
+ * +----------------------------------+
+ * | WBSCompressedBlockHeader + データ   |  展開後 blockSize バイト以下のブロック × N
+ * +----------------------------------+
+ * | WBSCompressedBlockHeader (全て0)   |  終端（途中で切れたファイルの検出用）
+ * +----------------------------------+
+ *
+ * 【ブロックの符号化】
+ * - シーケンスの列: トークン（上位4ビット=リテラル長、下位4ビット=一致長-4）、
+ *   リテラル長の延長バイト、リテラル、一致距離（uint16_t）、一致長の延長バイト
+ * - 最後のシーケンスはリテラルのみ（一致距離を持たない）
+ * - 各ブロックは独立して展開でき、一致は同じブロック内の直前64KBまでを参照する
+ * - 圧縮しても縮まないブロックはそのまま格納（packedSize == rawSize）
+ *
+ * 【設計原則】
+ * - ストリーミング: 保存は WBSCompressingSink がブロック単位で圧縮しながら書き出し、
+ *   読み込みは WBSCompressedReader がブロック単位で展開する（展開後の文書全体を
+ *   メモリに置かない）
+ * - 安全な展開: 不正なデータでも範囲外の読み書きを行わない
+ * - 例外を投げない: 書き込み・展開の失敗は戻り値で通知する
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "WBSOutputSink.h"
+
+// ============================================================================
+// 形式定数
+// ============================================================================
+
+const char kWBSCompressedMagic[4] = { 'W', 'B', 'S', 'Z' }; ///< ファイル識別子
+const uint16_t kWBSCompressedVersion = 1;                   ///< 現在の形式バージョン
+const uint32_t kWBSCompressionBlockSize = 256 * 1024;       ///< 展開後のブロックサイズ
+const int kWBSCompressionMinLevel = 1;                      ///< 最速（一致候補を1つだけ調べる）
+const int kWBSCompressionMaxLevel = 9;                      ///< 最高圧縮
+const int kWBSCompressionDefaultLevel = 4;                  ///< 保存時の既定レベル
+
+#pragma pack(push, 1)
+
+/**
+ * @brief ファイルヘッダー
+ */
+struct WBSCompressedHeader {
+    char magic[4];          ///< "WBSZ"
+    uint16_t version;       ///< kWBSCompressedVersion
+    uint8_t level;          ///< 保存時の圧縮レベル（情報用、展開には不要）
+    uint8_t reserved;       ///< 予約（0）
+    uint32_t blockSize;     ///< 展開後のブロックの最大バイト数
+};
+
+/**
+ * @brief ブロックヘッダー（rawSize == 0 は終端）
+ */
+struct WBSCompressedBlockHeader {
+    uint32_t rawSize;       ///< 展開後のバイト数
+    uint32_t packedSize;    ///< 格納されたバイト数（rawSize と等しければ無圧縮）
+    uint32_t checksum;      ///< 格納されたバイト列のハッシュ（FNV-1a 32ビット）
+};
+
+#pragma pack(pop)
+
+/**
+ * @brief 格納されたバイト列のハッシュ（FNV-1a 32ビット）
+ */
+inline uint32_t WBSBlockChecksum(const char* data, size_t size) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    uint32_t hash = 0x811C9DC5u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x01000193u;
+    }
+    return hash;
+}
+
+/**
+ * @brief 圧縮後のバイト数の上限（縮まない入力でもこの範囲に収まる）
+ */
+inline size_t WBSCompressBound(size_t rawSize) {
+    return rawSize + rawSize / 255 + 16;
+}
+
+// ============================================================================
+// ブロック圧縮
+// ============================================================================
+
+/**
+ * @brief LZ77系のブロック圧縮器
+ *
+ * ハッシュ表とハッシュチェーンはブロック間で再利用します。
+ * レベルが高いほどチェーンを深く辿り、レベル6以上では1文字先の一致と
+ * 比較してから確定する遅延評価を行います。
+ */
+class WBSBlockCompressor {
+public:
+    /**
+     * @param level 圧縮レベル（kWBSCompressionMinLevel ～ kWBSCompressionMaxLevel）
+     */
+    explicit WBSBlockCompressor(int level)
+        : level_(level < kWBSCompressionMinLevel ? kWBSCompressionMinLevel
+                 : level > kWBSCompressionMaxLevel ? kWBSCompressionMaxLevel : level),
+          head_(kHashSize), chain_(kWindowSize) {
+        static const int kChainDepth[] = { 0, 1, 2, 4, 8, 16, 32, 64, 256, 1024 };
+        maxAttempts_ = kChainDepth[level_];
+    }
+
+    int Level() const { return level_; }
+
+    /**
+     * @brief 1ブロックを圧縮
+     * @param src 入力
+     * @param size 入力のバイト数（kWBSCompressionBlockSize 以下）
+     * @param dst 出力先（WBSCompressBound(size) バイト以上）
+     * @return 出力したバイト数
+     */
+    size_t Compress(const char* src, size_t size, char* dst) {
+        const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+        unsigned char* out = reinterpret_cast<unsigned char*>(dst);
+        unsigned char* op = out;
+        size_t anchor = 0;      // 未出力のリテラルの先頭
+        size_t pos = 0;
+
+        std::fill(head_.begin(), head_.end(), kNone);
+        if (size < kMinMatch + 1) {
+            return EmitLastLiterals(op, in, anchor, size) - out;
+        }
+
+        const size_t limit = size - kMinMatch;  // 一致の開始位置の上限
+        size_t misses = 0;
+        while (pos < limit) {
+            size_t matchLength = 0;
+            size_t matchOffset = 0;
+            FindMatch(in, pos, size, matchLength, matchOffset);
+
+            if (matchLength < kMinMatch) {
+                // 一致なし: 連続して外れるほど間隔を広げる（圧縮できないデータ対策）
+                ++misses;
+                pos += 1 + (level_ == 1 ? (misses >> 5) : 0);
+                continue;
+            }
+            misses = 0;
+
+            if (level_ >= 6 && pos + 1 < limit) {
+                // 遅延評価: 1文字先の方が長く一致するならそちらを採用
+                size_t nextLength = 0;
+                size_t nextOffset = 0;
+                FindMatch(in, pos + 1, size, nextLength, nextOffset);
+                if (nextLength > matchLength + 1) {
+                    ++pos;
+                    matchLength = nextLength;
+                    matchOffset = nextOffset;
+                }
+            }
+
+            op = EmitSequence(op, in + anchor, pos - anchor, matchOffset, matchLength);
+
+            // 一致した範囲の位置もハッシュへ登録（高レベルのみ全位置）
+            size_t end = pos + matchLength;
+            size_t step = (level_ >= 3) ? 1 : 4;
+            for (size_t p = pos + 1; p < end && p < limit; p += step) {
+                Insert(in, p);
+            }
+            pos = end;
+            anchor = end;
+        }
+        return EmitLastLiterals(op, in, anchor, size) - out;
+    }
+
+private:
+    static const size_t kMinMatch = 4;
+    static const size_t kHashBits = 15;
+    static const size_t kHashSize = size_t(1) << kHashBits;
+    static const size_t kWindowSize = 64 * 1024;
+    enum : uint32_t { kNone = 0xFFFFFFFFu };   // std::fill() で参照渡しするため定義の要らない列挙子にする
+
+    static uint32_t Read32(const unsigned char* p) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    static size_t Hash(const unsigned char* p) {
+        return (Read32(p) * 2654435761u) >> (32 - kHashBits);
+    }
+
+    void Insert(const unsigned char* in, size_t pos) {
+        size_t h = Hash(in + pos);
+        chain_[pos & (kWindowSize - 1)] = head_[h];
+        head_[h] = static_cast<uint32_t>(pos);
+    }
+
+    /**
+     * @brief pos から始まる最長一致を探し、pos をハッシュへ登録
+     */
+    void FindMatch(const unsigned char* in, size_t pos, size_t size, size_t& bestLength, size_t& bestOffset) {
+        size_t h = Hash(in + pos);
+        uint32_t candidate = head_[h];
+        chain_[pos & (kWindowSize - 1)] = candidate;
+        head_[h] = static_cast<uint32_t>(pos);
+
+        uint32_t first = Read32(in + pos);
+        for (int attempts = maxAttempts_; attempts > 0 && candidate != kNone; --attempts) {
+            size_t offset = pos - candidate;
+            if (offset == 0 || offset >= kWindowSize) {
+                break;
+            }
+            if (Read32(in + candidate) == first) {
+                size_t length = kMinMatch;
+                while (pos + length < size && in[candidate + length] == in[pos + length]) {
+                    ++length;
+                }
+                if (length > bestLength) {
+                    bestLength = length;
+                    bestOffset = offset;
+                    if (pos + length == size) break;
+                }
+            }
+            uint32_t next = chain_[candidate & (kWindowSize - 1)];
+            if (next == kNone || next >= candidate) {
+                break; // チェーンの終端、または窓の外で上書きされた位置
+            }
+            candidate = next;
+        }
+    }
+
+    static unsigned char* EmitLength(unsigned char* op, size_t length) {
+        while (length >= 255) {
+            *op++ = 255;
+            length -= 255;
+        }
+        *op++ = static_cast<unsigned char>(length);
+        return op;
+    }
+
+    static unsigned char* EmitSequence(unsigned char* op, const unsigned char* literals, size_t literalLength,
+                                       size_t offset, size_t matchLength) {
+        size_t matchCode = matchLength - kMinMatch;
+        unsigned char* token = op++;
+        *token = static_cast<unsigned char>(((literalLength < 15 ? literalLength : 15) << 4) |
+                                            (matchCode < 15 ? matchCode : 15));
+        if (literalLength >= 15) {
+            op = EmitLength(op, literalLength - 15);
+        }
+        memcpy(op, literals, literalLength);
+        op += literalLength;
+        *op++ = static_cast<unsigned char>(offset & 0xFF);
+        *op++ = static_cast<unsigned char>(offset >> 8);
+        if (matchCode >= 15) {
+            op = EmitLength(op, matchCode - 15);
+        }
+        return op;
+    }
+
+    static unsigned char* EmitLastLiterals(unsigned char* op, const unsigned char* in, size_t anchor, size_t size) {
+        size_t literalLength = size - anchor;
+        *op++ = static_cast<unsigned char>((literalLength < 15 ? literalLength : 15) << 4);
+        if (literalLength >= 15) {
+            op = EmitLength(op, literalLength - 15);
+        }
+        memcpy(op, in + anchor, literalLength);
+        return op + literalLength;
+    }
+
+    int level_;                     ///< 圧縮レベル
+    int maxAttempts_;               ///< ハッシュチェーンを辿る最大回数
+    std::vector<uint32_t> head_;    ///< ハッシュ値ごとの最新の位置
+    std::vector<uint32_t> chain_;   ///< 同じハッシュ値を持つ直前の位置（窓の大きさで循環）
+};
+
+// ============================================================================
+// ブロック展開
+// ============================================================================
+
+/**
+ * @brief 1ブロックを展開
+ * @param src 格納されたバイト列
+ * @param packedSize src のバイト数
+ * @param dst 出力先
+ * @param rawSize 展開後のバイト数（ブロックヘッダーの値）
+ * @return ちょうど rawSize バイトに展開できた場合true
+ *
+ * 入力・出力の範囲は常に検査するため、不正なデータでも範囲外アクセスは起きません。
+ */
+inline bool WBSDecompressBlock(const char* src, size_t packedSize, char* dst, size_t rawSize) {
+    const unsigned char* ip = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* const iend = ip + packedSize;
+    unsigned char* op = reinterpret_cast<unsigned char*>(dst);
+    unsigned char* const ostart = op;
+    unsigned char* const oend = op + rawSize;
+
+    auto readLength = [&](size_t& length) -> bool {
+        unsigned char byte;
+        do {
+            if (ip >= iend) return false;
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (ip < iend) {
+        unsigned token = *ip++;
+
+        // リテラル
+        size_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(literalLength)) return false;
+        if (literalLength > static_cast<size_t>(iend - ip) || literalLength > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+        memcpy(op, ip, literalLength);
+        ip += literalLength;
+        op += literalLength;
+        if (ip == iend) {
+            break; // 最後のシーケンス（リテラルのみ）
+        }
+
+        // 一致
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        size_t matchLength = token & 15;
+        if (matchLength == 15 && !readLength(matchLength)) return false;
+        matchLength += 4;
+        if (offset == 0 || offset > static_cast<size_t>(op - ostart) ||
+            matchLength > static_cast<size_t>(oend - op)) {
+            return false;
+        }
+
+        const unsigned char* match = op - offset;
+        if (offset >= 8) {
+            // 重ならない8バイト単位のコピー（末尾は1バイトずつ）
+            unsigned char* copyEnd = op + matchLength;
+            while (op + 8 <= copyEnd) {
+                memcpy(op, match, 8);
+                op += 8;
+                match += 8;
+            }
+            while (op < copyEnd) *op++ = *match++;
+        } else {
+            // 距離が短い一致は繰り返しパターン: 1バイトずつ
+            for (size_t i = 0; i < matchLength; ++i) *op++ = *match++;
+        }
+    }
+    return op == oend;
+}
+
+// ============================================================================
+// ストリーミング入出力
+// ============================================================================
+
+/**
+ * @brief 書き込まれたバイト列をブロック単位で圧縮して転送する出力先
+ *
+ * WriteProjectXml() 等の出力をそのまま受け取り、kWBSCompressionBlockSize
+ * ごとに圧縮して転送先へ書き出します。最後に Finish() を呼び出してください。
+ */
+class WBSCompressingSink : public WBSOutputSink {
+public:
+    /**
+     * @param inner 圧縮後のバイト列の転送先
+     * @param level 圧縮レベル
+     */
+    WBSCompressingSink(WBSOutputSink& inner, int level)
+        : inner_(inner), compressor_(level), headerWritten_(false), failed_(false) {
+        raw_.reserve(kWBSCompressionBlockSize);
+        packed_.resize(WBSCompressBound(kWBSCompressionBlockSize));
+    }
+
+    bool Write(const char* data, size_t size) override {
+        while (size > 0 && !failed_) {
+            size_t room = kWBSCompressionBlockSize - raw_.size();
+            size_t chunk = size < room ? size : room;
+            raw_.append(data, chunk);
+            data += chunk;
+            size -= chunk;
+            if (raw_.size() == kWBSCompressionBlockSize) {
+                FlushBlock();
+            }
+        }
+        return !failed_;
+    }
+
+    /**
+     * @brief 残りのブロックと終端を書き出す
+     * @return すべて書き込めた場合true
+     */
+    bool Finish() {
+        if (!raw_.empty()) {
+            FlushBlock();
+        }
+        WriteHeader();
+        WBSCompressedBlockHeader end = {};
+        Put(&end, sizeof(end));
+        return !failed_;
+    }
+
+private:
+    void Put(const void* data, size_t size) {
+        if (!failed_ && !inner_.Write(static_cast<const char*>(data), size)) {
+            failed_ = true;
+        }
+    }
+
+    void WriteHeader() {
+        if (headerWritten_) return;
+        headerWritten_ = true;
+        WBSCompressedHeader header = {};
+        memcpy(header.magic, kWBSCompressedMagic, sizeof(header.magic));
+        header.version = kWBSCompressedVersion;
+        header.level = static_cast<uint8_t>(compressor_.Level());
+        header.blockSize = kWBSCompressionBlockSize;
+        Put(&header, sizeof(header));
+    }
+
+    void FlushBlock() {
+        WriteHeader();
+        size_t packedSize = compressor_.Compress(raw_.data(), raw_.size(), &packed_[0]);
+        const char* stored = packed_.data();
+        if (packedSize >= raw_.size()) {
+            // 縮まないブロックはそのまま格納
+            packedSize = raw_.size();
+            stored = raw_.data();
+        }
+
+        WBSCompressedBlockHeader block;
+        block.rawSize = static_cast<uint32_t>(raw_.size());
+        block.packedSize = static_cast<uint32_t>(packedSize);
+        block.checksum = WBSBlockChecksum(stored, packedSize);
+        Put(&block, sizeof(block));
+        Put(stored, packedSize);
+        raw_.clear();
+    }
+
+    WBSOutputSink& inner_;              ///< 転送先
+    WBSBlockCompressor compressor_;     ///< ブロック圧縮器
+    std::string raw_;                   ///< 圧縮前のブロック
+    std::string packed_;                ///< 圧縮後のブロック
+    bool headerWritten_;                ///< ファイルヘッダーを書き出したか
+    bool failed_;                       ///< 転送先への書き込みに失敗した
+};
+
+/**
+ * @brief 圧縮コンテナをブロック単位で展開する読み取り器
+ *
+ * 入力（メモリマップしたファイル等）を所有せずに参照します。
+ * ReadBlock() を呼び出すたびに1ブロック分を展開して追加します。
+ */
+class WBSCompressedReader {
+public:
+    /**
+     * @param data コンテナ全体の先頭
+     * @param size コンテナのバイト数
+     */
+    WBSCompressedReader(const char* data, size_t size)
+        : pos_(data), end_(data + size), blockSize_(0), finished_(false), failed_(false) {
+        WBSCompressedHeader header;
+        if (size < sizeof(header)) {
+            failed_ = true;
+            return;
+        }
+        memcpy(&header, data, sizeof(header));
+        // ブロックサイズは書き込み時の上限以下（不正なヘッダーによる巨大な確保を防ぐ）
+        if (memcmp(header.magic, kWBSCompressedMagic, sizeof(header.magic)) != 0 ||
+            header.version != kWBSCompressedVersion ||
+            header.blockSize == 0 || header.blockSize > kWBSCompressionBlockSize) {
+            failed_ = true;
+            return;
+        }
+        blockSize_ = header.blockSize;
+        pos_ += sizeof(header);
+    }
+
+    /**
+     * @brief 次のブロックを展開して追加
+     * @param out 追加先
+     * @return ブロックを追加した場合true（終端またはエラーの場合false）
+     */
+    bool ReadBlock(std::string& out) {
+        if (finished_ || failed_) return false;
+
+        WBSCompressedBlockHeader block;
+        if (static_cast<size_t>(end_ - pos_) < sizeof(block)) {
+            failed_ = true; // 終端がない（途中で切れたファイル）
+            return false;
+        }
+        memcpy(&block, pos_, sizeof(block));
+        pos_ += sizeof(block);
+        if (block.rawSize == 0) {
+            finished_ = true;
+            return false;
+        }
+        if (block.rawSize > blockSize_ || block.packedSize > block.rawSize ||
+            block.packedSize > static_cast<size_t>(end_ - pos_) ||
+            WBSBlockChecksum(pos_, block.packedSize) != block.checksum) {
+            failed_ = true;
+            return false;
+        }
+
+        size_t offset = out.size();
+        out.resize(offset + block.rawSize);
+        if (block.packedSize == block.rawSize) {
+            memcpy(&out[offset], pos_, block.rawSize);
+        } else if (!WBSDecompressBlock(pos_, block.packedSize, &out[offset], block.rawSize)) {
+            out.resize(offset);
+            failed_ = true;
+            return false;
+        }
+        pos_ += block.packedSize;
+        return true;
+    }
+
+    /**
+     * @brief ヘッダーやブロックが不正だったか判定
+     */
+    bool Failed() const { return failed_; }
+
+    /**
+     * @brief バイト列が圧縮コンテナか判定（識別子のみ）
+     */
+    static bool IsCompressed(const char* data, size_t size) {
+        return size >= sizeof(kWBSCompressedMagic) &&
+               memcmp(data, kWBSCompressedMagic, sizeof(kWBSCompressedMagic)) == 0;
+    }
+
+private:
+    const char* pos_;           ///< 次のブロックヘッダーの位置
+    const char* end_;           ///< コンテナの終端
+    uint32_t blockSize_;        ///< 展開後のブロックの最大バイト数
+    bool finished_;             ///< 終端に到達した
+    bool failed_;               ///< 不正なデータを検出した
+};
@@ -0,0 +1,187 @@
+/*
+ * ============================================================================
+ * WBSDateTime.h - WBSアプリケーション 分単位の日時
+ * ============================================================================
+ *
+ * このヘッダーファイルは、タスクの開始日・終了日を32ビットの整数1つで
+ * 表す日時型と、暦（年月日・時分）との相互変換を提供します。
+ *
+ * 【主な機能】
+ * - WBSDateTime: 1601-01-01T00:00（UTC）からの経過分を保持する4バイトの値型
+ * - 暦との変換: 年月日・時分からの構築と分解（グレゴリオ暦、範囲検査付き）
+ * - 現在時刻の取得: std::chrono::system_clock による（windows.h 不要）
+ * - Win32 境界での SYSTEMTIME との変換（_WIN32 の場合のみ）
+ *
+ * 【設計原則】
+ * - 比較・並べ替え・期間の計算は整数1つの演算（SYSTEMTIME の8フィールド比較が不要）
+ * - 日単位の処理は Day()（経過分 / 1440）で行う
+ * - 表現できる範囲は 1601年～9766年。秒以下は保持しない（ファイルには秒を0として出力）
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// ============================================================================
+// 日時型
+// ============================================================================
+
+/**
+ * @brief 分単位の日時（UTC）
+ *
+ * 起点は FILETIME と同じ 1601-01-01T00:00 です。既定値は起点を表します。
+ * 値の大小関係は日時の前後関係と一致します。
+ */
+class WBSDateTime {
+public:
+    static const uint32_t kMinutesPerDay = 24 * 60;         ///< 1日の分数
+    static const int kMinYear = 1601;                       ///< 表現できる最初の年
+    static const int kMaxYear = 9766;                       ///< 表現できる最後の年（32ビットに収まる範囲）
+
+    WBSDateTime() : minutes_(0) {}
+
+    /**
+     * @brief 起点からの経過分から構築
+     */
+    static WBSDateTime FromMinutes(uint32_t minutes) {
+        WBSDateTime value;
+        value.minutes_ = minutes;
+        return value;
+    }
+
+    /**
+     * @brief 年月日・時分が表現できる日時か判定
+     */
+    static bool IsValid(int year, int month, int day, int hour, int minute) {
+        return year >= kMinYear && year <= kMaxYear && month >= 1 && month <= 12 &&
+               day >= 1 && day <= DaysInMonth(year, month) &&
+               hour >= 0 && hour < 24 && minute >= 0 && minute < 60;
+    }
+
+    /**
+     * @brief 年月日・時分から構築
+     * @return 構築した日時（IsValid() を満たさない場合は false を返し、value は変更しない）
+     */
+    static bool FromCivil(int year, int month, int day, int hour, int minute, WBSDateTime& value) {
+        if (!IsValid(year, month, day, hour, minute)) {
+            return false;
+        }
+        uint32_t days = static_cast<uint32_t>(DaysFromCivil(year, month, day) - DaysFromCivil(kMinYear, 1, 1));
+        value.minutes_ = days * kMinutesPerDay + static_cast<uint32_t>(hour * 60 + minute);
+        return true;
+    }
+
+    /**
+     * @brief 現在時刻（UTC、分未満は切り捨て）
+     */
+    static WBSDateTime Now() {
+        using namespace std::chrono;
+        int64_t unixMinutes = duration_cast<minutes>(system_clock::now().time_since_epoch()).count();
+        int64_t epochOffset = -DaysFromCivil(kMinYear, 1, 1) * static_cast<int64_t>(kMinutesPerDay);
+        return FromMinutes(static_cast<uint32_t>(unixMinutes + epochOffset));
+    }
+
+    /**
+     * @brief 年月日・時分に分解
+     */
+    void ToCivil(int& year, int& month, int& day, int& hour, int& minute) const {
+        int64_t days = static_cast<int64_t>(minutes_ / kMinutesPerDay) + DaysFromCivil(kMinYear, 1, 1);
+        CivilFromDays(days, year, month, day);
+        uint32_t minuteOfDay = minutes_ % kMinutesPerDay;
+        hour = static_cast<int>(minuteOfDay / 60);
+        minute = static_cast<int>(minuteOfDay % 60);
+    }
+
+    /**
+     * @brief 起点からの経過分
+     */
+    uint32_t Minutes() const { return minutes_; }
+
+    /**
+     * @brief 起点からの経過日数（日単位の比較・集計用）
+     */
+    uint32_t Day() const { return minutes_ / kMinutesPerDay; }
+
+    bool operator==(WBSDateTime other) const { return minutes_ == other.minutes_; }
+    bool operator!=(WBSDateTime other) const { return minutes_ != other.minutes_; }
+    bool operator<(WBSDateTime other) const { return minutes_ < other.minutes_; }
+    bool operator<=(WBSDateTime other) const { return minutes_ <= other.minutes_; }
+    bool operator>(WBSDateTime other) const { return minutes_ > other.minutes_; }
+    bool operator>=(WBSDateTime other) const { return minutes_ >= other.minutes_; }
+
+private:
+    static bool IsLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    static int DaysInMonth(int year, int month) {
+        static const int kDays[] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        return (month == 2 && IsLeapYear(year)) ? 29 : kDays[month - 1];
+    }
+
+    /**
+     * @brief 年月日から 1970-01-01 を0とする通日を求める（3月始まりの年で計算）
+     */
+    static int64_t DaysFromCivil(int year, int month, int day) {
+        int64_t y = year - (month <= 2 ? 1 : 0);
+        int64_t era = (y >= 0 ? y : y - 399) / 400;
+        int64_t yearOfEra = y - era * 400;
+        int64_t dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    /**
+     * @brief DaysFromCivil() の逆変換
+     */
+    static void CivilFromDays(int64_t days, int& year, int& month, int& day) {
+        days += 719468;
+        int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        int64_t dayOfEra = days - era * 146097;
+        int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+        day = static_cast<int>(dayOfYear - (153 * monthIndex + 2) / 5 + 1);
+        month = static_cast<int>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9);
+        year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+    }
+
+    uint32_t minutes_;      ///< 起点からの経過分
+};
+
+#ifdef _WIN32
+// ============================================================================
+// Win32 境界での変換
+// ============================================================================
+
+/**
+ * @brief SYSTEMTIME から変換（秒以下は切り捨て、範囲外は false）
+ */
+inline bool SystemTimeToDateTime(const SYSTEMTIME& st, WBSDateTime& value) {
+    return WBSDateTime::FromCivil(st.wYear, st.wMonth, st.wDay, st.wHour, st.wMinute, value);
+}
+
+/**
+ * @brief SYSTEMTIME へ変換（曜日・秒・ミリ秒は0）
+ */
+inline SYSTEMTIME DateTimeToSystemTime(WBSDateTime value) {
+    int year, month, day, hour, minute;
+    value.ToCivil(year, month, day, hour, minute);
+    SYSTEMTIME st = {};
+    st.wYear = static_cast<WORD>(year);
+    st.wMonth = static_cast<WORD>(month);
+    st.wDay = static_cast<WORD>(day);
+    st.wHour = static_cast<WORD>(hour);
+    st.wMinute = static_cast<WORD>(minute);
+    return st;
+}
+#endif
@@ -0,0 +1,324 @@
+/*
+ * ============================================================================
+ * WBSDelimitedText.h - WBSアプリケーション 区切り文字形式（CSV/TSV）の読み書き
+ * ============================================================================
+ *
+ * このヘッダーファイルは、タスク表をCSV（カンマ区切り）・TSV（タブ区切り）で
+ * 書き出すストリーミングライターと、メモリマップしたファイルを先頭から
+ * 1レコードずつ読み取るリーダーを提供します。
+ *
+ * 【主な機能】
+ * - WBSDelimitedWriter: フィールドの引用符処理とバッファ管理（内部文字列のUTF-8をそのまま出力）
+ * - WBSDelimitedReader: 引用符付きフィールド（区切り文字・改行・"" を含む）の解析
+ *
+ * 【書式】
+ * - 文字コードはUTF-8（先頭にBOMを付けて出力し、読み込み時は読み飛ばす）
+ * - 改行は CRLF で出力し、読み込み時は CRLF・LF・CR のいずれも受け付ける
+ * - 区切り文字・'"'・改行を含むフィールドは '"' で囲み、'"' は "" と二重化（RFC 4180）
+ *
+ * 【設計原則】
+ * - 書き込み: バッファは閾値に達するたびに書き出して再利用（WBSXmlWriter と同じ）
+ * - 読み込み: 引用符のないフィールドは入力を直接指し、コピーしない
+ * - 使用メモリは1レコード分のみ（ファイルの行数に依存しない）
+ * - エラーは戻り値で通知し、例外は投げない
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <cstring>
+#include "WBSUtf8.h"
+#include "WBSOutputSink.h"
+
+const char kWBSUtf8Bom[] = "\xEF\xBB\xBF";     ///< UTF-8のBOM（3バイト）
+
+// ============================================================================
+// ストリーミングライター
+// ============================================================================
+
+/**
+ * @brief UTF-8バッファへ直接書き込む区切り文字形式ライター
+ *
+ * フィールド間の区切り文字はライターが挿入します。1レコード分のフィールドを
+ * 追加したら EndRecord() を呼び出し、最後に必ず Flush() を呼び出してください。
+ */
+class WBSDelimitedWriter {
+public:
+    static const size_t kFlushThreshold = 1024 * 1024;     ///< 書き出し単位（1MB）
+
+    /**
+     * @brief コンストラクタ
+     * @param sink 出力先（ライターより長く生存させること）
+     * @param delimiter 区切り文字（',' または '\t'）
+     */
+    WBSDelimitedWriter(WBSOutputSink& sink, char delimiter)
+        : sink_(sink), delimiter_(delimiter), fieldCount_(0), failed_(false) {
+        buffer_.reserve(kFlushThreshold + 64 * 1024);
+    }
+
+    /**
+     * @brief 文字列をそのまま追加（BOMなど）
+     * @param text ASCII文字列またはUTF-8バイト列
+     */
+    void Raw(const char* text) {
+        buffer_ += text;
+    }
+
+    /**
+     * @brief テキストフィールドを必要に応じて引用符で囲んで追加
+     * @param value フィールドの値（UTF-8）
+     */
+    void TextField(const std::string& value) {
+        BeginField();
+        const char* first = value.data();
+        const char* last = first + value.size();
+        if (!NeedsQuote(first, last)) {
+            buffer_.append(first, last);
+            return;
+        }
+
+        buffer_ += '"';
+        for (const void* quote; (quote = memchr(first, '"', last - first)) != nullptr; ) {
+            const char* next = static_cast<const char*>(quote) + 1;
+            buffer_.append(first, next);
+            buffer_ += '"';                         // '"' は "" と二重化
+            first = next;
+        }
+        buffer_.append(first, last);
+        buffer_ += '"';
+    }
+
+    /**
+     * @brief 書式化済みのASCII値をフィールドとして追加（数値・日付用）
+     * @param value 値（区切り文字・'"'・改行を含まないASCII文字列）
+     * @param length 値の長さ
+     */
+    void RawField(const char* value, size_t length) {
+        BeginField();
+        buffer_.append(value, length);
+    }
+
+    /**
+     * @brief レコードを終える（改行を追加）
+     */
+    void EndRecord() {
+        buffer_ += "\r\n";
+        fieldCount_ = 0;
+        if (buffer_.size() >= kFlushThreshold) {
+            Flush();
+        }
+    }
+
+    /**
+     * @brief バッファの内容をすべて出力先へ書き出す
+     * @return これまでの書き込みがすべて成功していればtrue
+     */
+    bool Flush() {
+        if (!buffer_.empty() && !failed_) {
+            failed_ = !sink_.Write(buffer_.data(), buffer_.size());
+        }
+        buffer_.clear();
+        return !failed_;
+    }
+
+    /**
+     * @brief 書き込みエラーが発生したか判定
+     */
+    bool Failed() const { return failed_; }
+
+private:
+    void BeginField() {
+        if (fieldCount_++ > 0) {
+            buffer_ += delimiter_;
+        }
+    }
+
+    bool NeedsQuote(const char* first, const char* last) const {
+        for (const char* p = first; p < last; ++p) {
+            char c = *p;
+            if (c == delimiter_ || c == '"' || c == '\r' || c == '\n') {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    WBSOutputSink& sink_;   ///< 出力先
+    std::string buffer_;    ///< 再利用するUTF-8バッファ
+    char delimiter_;        ///< 区切り文字
+    size_t fieldCount_;     ///< 現在のレコードに追加したフィールド数
+    bool failed_;           ///< 書き込みエラー発生フラグ
+};
+
+// ============================================================================
+// 前方向専用リーダー
+// ============================================================================
+
+/**
+ * @brief 区切り文字形式のバイト列を1レコードずつ読み取るリーダー
+ *
+ * NextRecord() が true を返した後、Field() でそのレコードの各フィールドを
+ * 取得できます。Field() が返す範囲は次の NextRecord() 呼び出しまで有効です。
+ * 空行は読み飛ばします。
+ */
+class WBSDelimitedReader {
+public:
+    /**
+     * @brief コンストラクタ
+     * @param data 入力の先頭（リーダーより長く生存させること）
+     * @param size 入力のバイト数
+     * @param delimiter 区切り文字（',' または '\t'）
+     */
+    WBSDelimitedReader(const char* data, size_t size, char delimiter)
+        : pos_(data), end_(data + size), delimiter_(delimiter), failed_(false) {
+        if (size >= 3 && memcmp(data, kWBSUtf8Bom, 3) == 0) {
+            pos_ += 3;
+        }
+    }
+
+    /**
+     * @brief 次のレコードを読み取る
+     * @return レコードを読み取った場合true（入力の終端・構文エラーの場合false）
+     *
+     * 閉じられていない引用符は構文エラーとなり、Failed() がtrueを返します。
+     */
+    bool NextRecord() {
+        fields_.clear();
+        unquoted_.clear();
+
+        // 空行の読み飛ばし
+        while (pos_ < end_ && (*pos_ == '\r' || *pos_ == '\n')) {
+            ++pos_;
+        }
+        if (pos_ >= end_ || failed_) {
+            return false;
+        }
+
+        for (;;) {
+            FieldSpan span;
+            if (pos_ < end_ && *pos_ == '"') {
+                if (!ReadQuotedField(span)) {
+                    failed_ = true;
+                    return false;
+                }
+            } else {
+                const char* first = pos_;
+                while (pos_ < end_ && *pos_ != delimiter_ && *pos_ != '\r' && *pos_ != '\n') {
+                    ++pos_;
+                }
+                span.first = first;
+                span.offset = 0;
+                span.length = static_cast<size_t>(pos_ - first);
+            }
+            fields_.push_back(span);
+
+            if (pos_ < end_ && *pos_ == delimiter_) {
+                ++pos_;
+                continue;
+            }
+            break;
+        }
+
+        // 改行（CRLF・LF・CR）
+        if (pos_ < end_ && *pos_ == '\r') ++pos_;
+        if (pos_ < end_ && *pos_ == '\n') ++pos_;
+        return true;
+    }
+
+    /**
+     * @brief 現在のレコードのフィールド数を取得
+     */
+    size_t FieldCount() const { return fields_.size(); }
+
+    /**
+     * @brief 現在のレコードのフィールドを取得（引用符は除去済み）
+     * @param index フィールドの位置（FieldCount() 未満）
+     * @param first [out] 値の先頭
+     * @param last [out] 値の終端
+     */
+    void Field(size_t index, const char*& first, const char*& last) const {
+        const FieldSpan& span = fields_[index];
+        first = span.first ? span.first : unquoted_.data() + span.offset;
+        last = first + span.length;
+    }
+
+    /**
+     * @brief 構文エラーが発生したか判定
+     */
+    bool Failed() const { return failed_; }
+
+private:
+    /**
+     * @brief フィールドの位置（入力上、または引用符を除去した作業バッファ上）
+     *
+     * first が nullptr の場合は unquoted_ 内の offset から始まります
+     * （unquoted_ は再確保されうるため、ポインタではなく位置で保持する）。
+     */
+    struct FieldSpan {
+        const char* first;
+        size_t offset;
+        size_t length;
+    };
+
+    bool ReadQuotedField(FieldSpan& span) {
+        ++pos_;                                     // 開始の '"'
+        const char* first = pos_;
+        bool copied = false;                        // "" を含むため作業バッファへ展開したか
+        size_t offset = unquoted_.size();
+        for (;;) {
+            const char* quote = static_cast<const char*>(memchr(pos_, '"', static_cast<size_t>(end_ - pos_)));
+            if (!quote) {
+                return false;                       // 閉じられていない引用符
+            }
+            if (quote + 1 < end_ && quote[1] == '"') {
+                if (!copied) {
+                    unquoted_.append(first, pos_);
+                    copied = true;
+                }
+                unquoted_.append(pos_, quote + 1);  // "" は '"' 1文字
+                pos_ = quote + 2;
+                continue;
+            }
+            if (copied) {
+                unquoted_.append(pos_, quote);
+                span.first = nullptr;
+                span.offset = offset;
+                span.length = unquoted_.size() - offset;
+            } else {
+                span.first = first;
+                span.offset = 0;
+                span.length = static_cast<size_t>(quote - first);
+            }
+            pos_ = quote + 1;
+            break;
+        }
+
+        // 閉じ引用符の後ろに続く文字は値に含める（Excel と同じ寛容な扱い）
+        const char* tail = pos_;
+        while (pos_ < end_ && *pos_ != delimiter_ && *pos_ != '\r' && *pos_ != '\n') {
+            ++pos_;
+        }
+        if (pos_ != tail) {
+            if (span.first) {
+                unquoted_.append(span.first, span.length);
+                span.first = nullptr;
+                span.offset = offset;
+            }
+            unquoted_.append(tail, pos_);
+            span.length = unquoted_.size() - offset;
+        }
+        return true;
+    }
+
+    const char* pos_;                   ///< 現在の読み取り位置
+    const char* end_;                   ///< 入力の終端
+    char delimiter_;                    ///< 区切り文字
+    bool failed_;                       ///< 構文エラー発生フラグ
+    std::vector<FieldSpan> fields_;     ///< 現在のレコードのフィールド（再利用）
+    std::string unquoted_;              ///< "" を展開したフィールドの作業バッファ（再利用）
+};
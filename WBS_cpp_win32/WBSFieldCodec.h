@@ -0,0 +1,705 @@
+/*
+ * ============================================================================
+ * WBSFieldCodec.h - WBSアプリケーション タスクフィールドの文字列変換
+ * ============================================================================
+ *
+ * このヘッダーファイルは、タスクの数値・列挙型・日時フィールドと文字列との
+ * 相互変換を、ロケール・ヒープ確保・例外を介さずに行う関数群を提供します。
+ * std::to_chars / std::from_chars と同様に、呼び出し側のバッファへ書き込み、
+ * 入力範囲 [first, last) から読み取ります。
+ *
+ * 【書式】（XML・CSV等のテキスト形式で共通）
+ * - 整数・列挙型: 10進数（例: "3"、"-12"）
+ * - 時間（double）: 小数点以下6桁で正確に表せる値は "%f" と同じ固定小数点
+ *   （例: "12.500000"）。それ以外は元の値へ正確に戻る最短の桁数（最大17桁）
+ *   （例: "0.30000000000000004"、"1.5e-7"）。非有限値は "INF"、"-INF"、"NaN"
+ * - 日時: ISO 8601 "YYYY-MM-DDTHH:MM:SS"（ミリ秒・タイムゾーンなし）
+ *
+ * 【設計原則】
+ * - 往復の正確性: FormatDoubleField() の出力は ParseDoubleField() で元の値に戻る
+ * - 正しい丸め: 10進数から double への変換は常に最近接の値（偶数丸め）
+ * - 例外を投げない: 構文エラー・範囲外の値は戻り値 false で通知する
+ * - 前後の空白（XMLの空白文字）は読み飛ばす
+ *
+ * 【実装】
+ * 時間の大半（小数点以下6桁以内の値）は整数演算と1回の除算だけで変換します。
+ * それ以外の値は多倍長整数による正確な比較で桁を求めるため低速ですが、
+ * 手入力や集計の結果として現れることはまれです。
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include "WBSClasses.h"
+
+// ============================================================================
+// 定数
+// ============================================================================
+
+const size_t kWBSFieldBufferSize = 32;  ///< Format*Field() の出力の最大バイト数
+
+// ============================================================================
+// 内部補助（多倍長整数による正確な10進変換）
+// ============================================================================
+
+namespace WBSFieldCodecDetail {
+
+/**
+ * @brief 正確な10進変換用の固定長多倍長整数（非負）
+ *
+ * 容量を超える演算は overflow を立てて以降の結果を無効にします。
+ */
+struct BigInteger {
+    static const size_t kCapacity = 192;    ///< 32ビット語数（6144ビット）
+    uint32_t words[kCapacity];              ///< 下位語から順に格納
+    size_t size;                            ///< 使用中の語数
+    bool overflow;                          ///< 容量を超えた
+
+    explicit BigInteger(uint64_t value = 0) : size(0), overflow(false) {
+        while (value) {
+            words[size++] = static_cast<uint32_t>(value);
+            value >>= 32;
+        }
+    }
+
+    void MultiplyAdd(uint32_t factor, uint32_t addend) {
+        uint64_t carry = addend;
+        for (size_t i = 0; i < size; ++i) {
+            uint64_t product = static_cast<uint64_t>(words[i]) * factor + carry;
+            words[i] = static_cast<uint32_t>(product);
+            carry = product >> 32;
+        }
+        if (carry) Push(static_cast<uint32_t>(carry));
+    }
+
+    void MultiplyPow10(int exponent) {
+        for (; exponent >= 9; exponent -= 9) MultiplyAdd(1000000000u, 0);
+        static const uint32_t kSmall[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+        if (exponent > 0) MultiplyAdd(kSmall[exponent], 0);
+    }
+
+    void MultiplyPow5(int exponent) {
+        for (; exponent >= 13; exponent -= 13) MultiplyAdd(1220703125u, 0);  // 5^13
+        uint32_t factor = 1;
+        while (exponent-- > 0) factor *= 5;
+        if (factor > 1) MultiplyAdd(factor, 0);
+    }
+
+    void ShiftLeft(int bits) {
+        if (size == 0 || bits <= 0) return;
+        size_t wordShift = static_cast<size_t>(bits) / 32;
+        unsigned bitShift = static_cast<unsigned>(bits) % 32;
+        if (size + wordShift + 1 > kCapacity) {
+            overflow = true;
+            return;
+        }
+        words[size + wordShift] = 0;
+        for (size_t i = size; i-- > 0;) {
+            uint64_t moved = static_cast<uint64_t>(words[i]) << bitShift;
+            words[i + wordShift + 1] |= static_cast<uint32_t>(moved >> 32);
+            words[i + wordShift] = static_cast<uint32_t>(moved);
+        }
+        for (size_t i = 0; i < wordShift; ++i) words[i] = 0;
+        size += wordShift + 1;
+        Trim();
+    }
+
+    /// @return 剰余
+    uint32_t DivideSmall(uint32_t divisor) {
+        uint64_t remainder = 0;
+        for (size_t i = size; i-- > 0;) {
+            uint64_t current = (remainder << 32) | words[i];
+            words[i] = static_cast<uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        Trim();
+        return static_cast<uint32_t>(remainder);
+    }
+
+    static int Compare(const BigInteger& a, const BigInteger& b) {
+        if (a.size != b.size) return a.size < b.size ? -1 : 1;
+        for (size_t i = a.size; i-- > 0;) {
+            if (a.words[i] != b.words[i]) return a.words[i] < b.words[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+private:
+    void Push(uint32_t word) {
+        if (size == kCapacity) {
+            overflow = true;
+            return;
+        }
+        words[size++] = word;
+    }
+
+    void Trim() {
+        while (size > 0 && words[size - 1] == 0) --size;
+    }
+};
+
+/**
+ * @brief 10進数の仮数部（数字列）と指数 value = digits × 10^exponent
+ */
+struct DecimalNumber {
+    static const int kMaxDigits = 780;      ///< 保持する有効桁数（超えた分は端数として扱う）
+    char digits[kMaxDigits + 1];            ///< 先頭の0を除いた数字（'0'～'9'）
+    int count;                              ///< 数字の個数
+    int exponent;                           ///< 10の指数
+};
+
+inline uint64_t DoubleBits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline double BitsToDouble(uint64_t bits) {
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief digits × 10^exponent と K × 2^binaryExponent を正確に比較
+ * @return 10進数の方が小さければ負、等しければ0、大きければ正
+ */
+inline int CompareDecimalToBinary(const BigInteger& digits, int exponent, uint64_t k, int binaryExponent, bool& failed) {
+    BigInteger left = digits;
+    BigInteger right(k);
+    if (exponent > 0) left.MultiplyPow10(exponent);
+    else right.MultiplyPow10(-exponent);
+    if (binaryExponent > 0) right.ShiftLeft(binaryExponent);
+    else left.ShiftLeft(-binaryExponent);
+    if (left.overflow || right.overflow) {
+        failed = true;
+        return 0;
+    }
+    return BigInteger::Compare(left, right);
+}
+
+/**
+ * @brief 10進数を最近接の double へ変換（偶数丸め）
+ * @return 変換できた場合true（有限の double の範囲を超える場合false）
+ *
+ * 概算値から始め、前後の double との中点と正確に比較しながら
+ * 1ulpずつ補正します。
+ */
+inline bool DecimalToDouble(const DecimalNumber& number, double& result) {
+    if (number.count == 0) {
+        result = 0.0;
+        return true;
+    }
+    int magnitude = number.count + number.exponent;     // 10^(magnitude-1) <= value < 10^magnitude
+    if (magnitude > 310) return false;                  // オーバーフロー
+    if (magnitude < -325) {
+        result = 0.0;                                   // 最小の非正規化数の半分未満
+        return true;
+    }
+
+    // 概算値: 先頭19桁 × 10^残りの指数
+    uint64_t head = 0;
+    int used = number.count < 19 ? number.count : 19;
+    for (int i = 0; i < used; ++i) head = head * 10 + static_cast<uint64_t>(number.digits[i] - '0');
+    static const double kPow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                     1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+    double guess = static_cast<double>(head);
+    int scale = number.exponent + (number.count - used);
+    for (; scale > 22; scale -= 22) guess *= 1e22;
+    for (; scale < -22; scale += 22) guess /= 1e22;
+    guess = scale >= 0 ? guess * kPow10[scale] : guess / kPow10[-scale];
+    const uint64_t kMaxFinite = 0x7FEFFFFFFFFFFFFFull;
+    uint64_t bits = DoubleBits(guess);
+    if (bits > kMaxFinite) bits = kMaxFinite;
+
+    BigInteger digits;
+    for (int i = 0; i < number.count; i += 9) {
+        uint32_t chunk = 0;
+        uint32_t factor = 1;
+        for (int j = i; j < number.count && j < i + 9; ++j) {
+            chunk = chunk * 10 + static_cast<uint32_t>(number.digits[j] - '0');
+            factor *= 10;
+        }
+        digits.MultiplyAdd(factor, chunk);
+    }
+
+    bool failed = false;
+    for (int attempts = 0; attempts < 256; ++attempts) {
+        // bits の値 = m × 2^e
+        uint64_t fraction = bits & ((uint64_t(1) << 52) - 1);
+        int biased = static_cast<int>(bits >> 52);
+        uint64_t m = biased ? (fraction | (uint64_t(1) << 52)) : fraction;
+        int e = biased ? biased - 1075 : -1074;
+
+        // 上側の中点 (2m+1) × 2^(e-1)
+        int upper = CompareDecimalToBinary(digits, number.exponent, 2 * m + 1, e - 1, failed);
+        if (failed) return false;
+        if (upper > 0 || (upper == 0 && (m & 1))) {
+            if (bits == kMaxFinite) return false;       // オーバーフロー
+            ++bits;
+            continue;
+        }
+        // 下側の中点（2のべき乗の直下は間隔が半分）
+        if (bits != 0) {
+            bool narrow = (fraction == 0 && biased > 1);
+            int lower = narrow ? CompareDecimalToBinary(digits, number.exponent, 4 * m - 1, e - 2, failed)
+                               : CompareDecimalToBinary(digits, number.exponent, 2 * m - 1, e - 1, failed);
+            if (failed) return false;
+            if (lower < 0 || (lower == 0 && (m & 1))) {
+                --bits;
+                continue;
+            }
+        }
+        result = BitsToDouble(bits);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 有限で正の double の正確な10進展開の先頭 precision 桁（四捨五入）
+ * @param digits 出力先（precision 文字の数字）
+ * @return 先頭の数字の10進指数 +1（value ≒ 0.d1d2... × 10^戻り値）
+ */
+inline int DoubleToDigits(double value, int precision, char* digits) {
+    uint64_t bits = DoubleBits(value);
+    uint64_t fraction = bits & ((uint64_t(1) << 52) - 1);
+    int biased = static_cast<int>((bits >> 52) & 0x7FF);
+    uint64_t m = biased ? (fraction | (uint64_t(1) << 52)) : fraction;
+    int e = biased ? biased - 1075 : -1074;
+
+    // value = m × 2^e = N × 10^decimalExponent（N は整数）
+    BigInteger n(m);
+    int decimalExponent = 0;
+    if (e >= 0) {
+        n.ShiftLeft(e);
+    } else {
+        n.MultiplyPow5(-e);
+        decimalExponent = e;
+    }
+
+    // N の10進表記（9桁ずつ下位から）
+    char all[800];
+    int length = 0;
+    while (n.size > 0) {
+        uint32_t chunk = n.DivideSmall(1000000000u);
+        for (int i = 0; i < 9; ++i) {
+            all[length++] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+        }
+    }
+    while (length > 1 && all[length - 1] == '0') --length;  // 上位の余分な0
+
+    // 上位から precision 桁を取り出して四捨五入
+    int point = length + decimalExponent;
+    for (int i = 0; i < precision; ++i) {
+        digits[i] = (i < length) ? all[length - 1 - i] : '0';
+    }
+    if (precision < length && all[length - 1 - precision] >= '5') {
+        int i = precision - 1;
+        while (i >= 0 && digits[i] == '9') digits[i--] = '0';
+        if (i >= 0) {
+            ++digits[i];
+        } else {
+            digits[0] = '1';    // 999... → 1000...
+            ++point;
+        }
+    }
+    return point;
+}
+
+inline bool IsXmlSpace(unsigned c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief 前後の空白を取り除く
+ */
+template <typename CharT>
+void TrimSpace(const CharT*& first, const CharT*& last) {
+    while (first < last && IsXmlSpace(static_cast<unsigned>(*first))) ++first;
+    while (last > first && IsXmlSpace(static_cast<unsigned>(last[-1]))) --last;
+}
+
+/**
+ * @brief 符号なし10進整数を読み取る（1～maxDigits 桁）
+ */
+template <typename CharT>
+bool ParseDigits(const CharT*& p, const CharT* last, int maxDigits, uint32_t& value) {
+    const CharT* start = p;
+    value = 0;
+    while (p < last && *p >= CharT('0') && *p <= CharT('9') && p - start < maxDigits) {
+        value = value * 10 + static_cast<uint32_t>(*p - CharT('0'));
+        ++p;
+    }
+    return p > start && !(p < last && *p >= CharT('0') && *p <= CharT('9'));
+}
+
+inline bool EqualsIgnoreCase(const char* text, size_t length, const char* word) {
+    size_t wordLength = strlen(word);
+    if (length != wordLength) return false;
+    for (size_t i = 0; i < length; ++i) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+        if (c != word[i]) return false;
+    }
+    return true;
+}
+
+} // namespace WBSFieldCodecDetail
+
+// ============================================================================
+// 書き込み（戻り値は書き込んだバイト数、NUL終端はしない）
+// ============================================================================
+
+/**
+ * @brief 整数を10進数で書き込み
+ * @param dst 出力先（kWBSFieldBufferSize バイト以上）
+ */
+inline size_t FormatIntField(char* dst, int value) {
+    char reversed[12];
+    size_t length = 0;
+    uint32_t magnitude = value < 0 ? 0u - static_cast<uint32_t>(value) : static_cast<uint32_t>(value);
+    do {
+        reversed[length++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude);
+
+    size_t written = 0;
+    if (value < 0) dst[written++] = '-';
+    while (length) dst[written++] = reversed[--length];
+    return written;
+}
+
+/**
+ * @brief 時間等の double を、元の値へ正確に戻る文字列で書き込み
+ * @param dst 出力先（kWBSFieldBufferSize バイト以上）
+ *
+ * 小数点以下6桁で正確に表せる値は std::to_wstring(double) と同じ
+ * "%f" 形式（例: "7.250000"）で書き込みます。
+ */
+inline size_t FormatDoubleField(char* dst, double value) {
+    using namespace WBSFieldCodecDetail;
+    uint64_t bits = DoubleBits(value);
+    bool negative = (bits >> 63) != 0;
+    double magnitude = negative ? -value : value;
+    size_t written = 0;
+
+    if (value != value) {
+        memcpy(dst, "NaN", 3);
+        return 3;
+    }
+    if (negative) dst[written++] = '-';
+    if (magnitude > 1.7976931348623157e308) {
+        memcpy(dst + written, "INF", 3);
+        return written + 3;
+    }
+
+    // 固定小数点（小数点以下6桁）: n / 10^6 が正しく丸められて元の値に戻るか確認
+    const double kScale = 1000000.0;
+    if (magnitude < 9007199254.0) {
+        uint64_t n = static_cast<uint64_t>(magnitude * kScale + 0.5);
+        if (static_cast<double>(n) / kScale == magnitude) {
+            uint64_t whole = n / 1000000;
+            uint32_t fraction = static_cast<uint32_t>(n % 1000000);
+            char reversed[20];
+            size_t length = 0;
+            do {
+                reversed[length++] = static_cast<char>('0' + whole % 10);
+                whole /= 10;
+            } while (whole);
+            while (length) dst[written++] = reversed[--length];
+            dst[written++] = '.';
+            for (int i = 5; i >= 0; --i) {
+                dst[written + i] = static_cast<char>('0' + fraction % 10);
+                fraction /= 10;
+            }
+            return written + 6;
+        }
+    }
+
+    // 最短の往復可能な桁数（15～17桁）を正確な10進展開から求める
+    char digits[17];
+    int precision = 15;
+    int point = 0;
+    for (; precision <= 17; ++precision) {
+        point = DoubleToDigits(magnitude, precision, digits);
+        DecimalNumber number;
+        memcpy(number.digits, digits, precision);
+        number.count = precision;
+        number.exponent = point - precision;
+        double parsed;
+        if (precision == 17 || (DecimalToDouble(number, parsed) && parsed == magnitude)) break;
+    }
+    while (precision > 1 && digits[precision - 1] == '0') --precision;
+
+    if (point > -6 && point <= 21) {
+        // 位置表記（例: 0.30000000000000004、123456789012.5）
+        if (point <= 0) {
+            dst[written++] = '0';
+            dst[written++] = '.';
+            for (int i = point; i < 0; ++i) dst[written++] = '0';
+            memcpy(dst + written, digits, precision);
+            return written + precision;
+        }
+        for (int i = 0; i < point; ++i) dst[written++] = (i < precision) ? digits[i] : '0';
+        if (precision > point) {
+            dst[written++] = '.';
+            memcpy(dst + written, digits + point, precision - point);
+            written += precision - point;
+        }
+        return written;
+    }
+
+    // 指数表記（例: 1.5e-7）
+    dst[written++] = digits[0];
+    if (precision > 1) {
+        dst[written++] = '.';
+        memcpy(dst + written, digits + 1, precision - 1);
+        written += precision - 1;
+    }
+    dst[written++] = 'e';
+    return written + FormatIntField(dst + written, point - 1);
+}
+
+/**
+ * @brief 日時をISO 8601 "YYYY-MM-DDTHH:MM:SS" で書き込み（秒は常に "00"）
+ * @param dst 出力先（kWBSFieldBufferSize バイト以上）
+ */
+inline size_t FormatDateField(char* dst, WBSDateTime date) {
+    int fields[6] = {};
+    date.ToCivil(fields[0], fields[1], fields[2], fields[3], fields[4]);
+    const char separators[] = { '-', '-', 'T', ':', ':', '\0' };
+    size_t written = 0;
+    for (int i = 0; i < 6; ++i) {
+        // "%04d" / "%02d" と同じく最小桁数まで0で埋める
+        unsigned value = static_cast<unsigned>(fields[i]);
+        int width = (i == 0) ? 4 : 2;
+        char reversed[5];
+        int length = 0;
+        do {
+            reversed[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value);
+        for (int pad = length; pad < width; ++pad) dst[written++] = '0';
+        while (length) dst[written++] = reversed[--length];
+        if (separators[i]) dst[written++] = separators[i];
+    }
+    return written;
+}
+
+// ============================================================================
+// 読み取り（入力範囲全体が値として正しい場合のみtrue、失敗時は value を変更しない）
+// ============================================================================
+
+/**
+ * @brief 10進整数を読み取る
+ */
+template <typename CharT>
+bool ParseIntField(const CharT* first, const CharT* last, int& value) {
+    WBSFieldCodecDetail::TrimSpace(first, last);
+    bool negative = false;
+    if (first < last && (*first == CharT('-') || *first == CharT('+'))) {
+        negative = (*first == CharT('-'));
+        ++first;
+    }
+    if (first == last) return false;
+
+    uint64_t magnitude = 0;
+    for (const CharT* p = first; p < last; ++p) {
+        if (*p < CharT('0') || *p > CharT('9')) return false;
+        magnitude = magnitude * 10 + static_cast<uint64_t>(*p - CharT('0'));
+        if (magnitude > 0x80000000ull) return false;    // int の範囲外
+    }
+    if (!negative && magnitude > 0x7FFFFFFFull) return false;
+    value = negative ? static_cast<int>(0 - magnitude) : static_cast<int>(magnitude);
+    return true;
+}
+
+/**
+ * @brief 10進数（小数点・指数表記を含む）を最近接の double として読み取る
+ *
+ * "INF"・"NaN"（大文字小文字を区別しない、"Infinity" も可）を受け付けます。
+ * 有限の double で表せない大きさの値はエラーです。
+ */
+template <typename CharT>
+bool ParseDoubleField(const CharT* first, const CharT* last, double& value) {
+    using namespace WBSFieldCodecDetail;
+    TrimSpace(first, last);
+    bool negative = false;
+    if (first < last && (*first == CharT('-') || *first == CharT('+'))) {
+        negative = (*first == CharT('-'));
+        ++first;
+    }
+    if (first == last) return false;
+
+    if (*first < CharT('0') || *first > CharT('9')) {
+        if (*first != CharT('.')) {
+            // 非有限値
+            char word[9];
+            size_t length = static_cast<size_t>(last - first);
+            if (length >= sizeof(word)) return false;
+            for (size_t i = 0; i < length; ++i) {
+                if (first[i] < CharT(0x20) || first[i] > CharT(0x7E)) return false;
+                word[i] = static_cast<char>(first[i]);
+            }
+            const double kInfinity = BitsToDouble(0x7FF0000000000000ull);
+            if (EqualsIgnoreCase(word, length, "inf") || EqualsIgnoreCase(word, length, "infinity")) {
+                value = negative ? -kInfinity : kInfinity;
+                return true;
+            }
+            if (EqualsIgnoreCase(word, length, "nan")) {
+                value = BitsToDouble(0x7FF8000000000000ull);
+                return true;
+            }
+            return false;
+        }
+    }
+
+    // 仮数部: 先頭の0を除いた数字列と、小数点の位置
+    DecimalNumber number;
+    number.count = 0;
+    int dropped = 0;            // 保持しきれなかった整数部の桁数
+    bool sticky = false;        // 保持しきれなかった桁に0以外がある
+    int fractionDigits = 0;     // 保持した小数部の桁数
+    bool anyDigit = false;
+    bool seenPoint = false;
+    const CharT* p = first;
+    for (; p < last; ++p) {
+        if (*p == CharT('.')) {
+            if (seenPoint) return false;
+            seenPoint = true;
+            continue;
+        }
+        if (*p < CharT('0') || *p > CharT('9')) break;
+        anyDigit = true;
+        char digit = static_cast<char>(*p - CharT('0') + '0');
+        if (number.count == 0 && digit == '0') {
+            if (seenPoint) ++fractionDigits;    // 小数部の先頭の0
+            continue;
+        }
+        if (number.count < DecimalNumber::kMaxDigits) {
+            number.digits[number.count++] = digit;
+            if (seenPoint) ++fractionDigits;
+        } else {
+            if (!seenPoint) ++dropped;
+            if (digit != '0') sticky = true;
+        }
+    }
+    if (!anyDigit) return false;
+
+    // 指数部
+    int exponent = 0;
+    if (p < last && (*p == CharT('e') || *p == CharT('E'))) {
+        ++p;
+        bool negativeExponent = false;
+        if (p < last && (*p == CharT('-') || *p == CharT('+'))) {
+            negativeExponent = (*p == CharT('-'));
+            ++p;
+        }
+        if (p == last) return false;
+        for (; p < last; ++p) {
+            if (*p < CharT('0') || *p > CharT('9')) return false;
+            if (exponent < 100000) exponent = exponent * 10 + static_cast<int>(*p - CharT('0'));
+        }
+        if (negativeExponent) exponent = -exponent;
+    }
+    if (p != last) return false;
+
+    int scale = dropped - fractionDigits;      // 数字列の整数値に対する10の指数
+    if (sticky) {
+        // 切り捨てた0以外の桁は、末尾に追加した1桁で代表させる
+        // （double 同士の中点は kMaxDigits 桁以内で表せるため、比較結果は変わらない）
+        number.digits[number.count++] = '1';
+        --scale;
+    }
+    while (number.count > 0 && number.digits[number.count - 1] == '0') {
+        --number.count;                         // 末尾の0は指数へ移す
+        ++scale;
+    }
+    number.exponent = exponent + scale;
+
+    double result;
+    if (number.count <= 15 && number.exponent >= -22 && number.exponent <= 22) {
+        // 高速経路: 仮数部と10のべき乗がともに double で正確に表せる（1回の丸め）
+        static const double kPow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        uint64_t mantissa = 0;
+        for (int i = 0; i < number.count; ++i) {
+            mantissa = mantissa * 10 + static_cast<uint64_t>(number.digits[i] - '0');
+        }
+        result = static_cast<double>(mantissa);
+        result = number.exponent >= 0 ? result * kPow10[number.exponent] : result / kPow10[-number.exponent];
+    } else if (!DecimalToDouble(number, result)) {
+        return false;
+    }
+    value = negative ? -result : result;
+    return true;
+}
+
+/**
+ * @brief ISO 8601 "YYYY-MM-DDTHH:MM:SS" を読み取る
+ *
+ * 秒と秒の小数部（".000"）、末尾の 'Z' は読み飛ばします（WBSDateTime は分単位）。
+ * 存在しない日付（2月30日等）や WBSDateTime の範囲外の年は失敗になります。
+ */
+template <typename CharT>
+bool ParseDateField(const CharT* first, const CharT* last, WBSDateTime& value) {
+    using namespace WBSFieldCodecDetail;
+    TrimSpace(first, last);
+    const char separators[] = { '-', '-', 'T', ':', ':', '\0' };
+    uint32_t fields[6];
+    const CharT* p = first;
+    for (int i = 0; i < 6; ++i) {
+        uint32_t field;
+        if (!ParseDigits(p, last, i == 0 ? 5 : 2, field)) return false;
+        fields[i] = field;
+        if (separators[i]) {
+            if (p == last || *p != CharT(separators[i])) return false;
+            ++p;
+        }
+    }
+    if (p < last && *p == CharT('.')) {
+        const CharT* digits = ++p;
+        while (p < last && *p >= CharT('0') && *p <= CharT('9')) ++p;
+        if (p == digits) return false;
+    }
+    if (p < last && *p == CharT('Z')) ++p;
+    if (p != last || fields[5] > 60) return false; // 60はうるう秒
+
+    return WBSDateTime::FromCivil(static_cast<int>(fields[0]), static_cast<int>(fields[1]), static_cast<int>(fields[2]),
+                                  static_cast<int>(fields[3]), static_cast<int>(fields[4]), value);
+}
+
+/**
+ * @brief タスクの状態（TaskStatus の数値）を読み取る
+ */
+template <typename CharT>
+bool ParseStatusField(const CharT* first, const CharT* last, TaskStatus& value) {
+    int number;
+    if (!ParseIntField(first, last, number) ||
+        number < static_cast<int>(TaskStatus::NOT_STARTED) || number > static_cast<int>(TaskStatus::CANCELLED)) {
+        return false;
+    }
+    value = static_cast<TaskStatus>(number);
+    return true;
+}
+
+/**
+ * @brief タスクの優先度（TaskPriority の数値）を読み取る
+ */
+template <typename CharT>
+bool ParsePriorityField(const CharT* first, const CharT* last, TaskPriority& value) {
+    int number;
+    if (!ParseIntField(first, last, number) ||
+        number < static_cast<int>(TaskPriority::LOW) || number > static_cast<int>(TaskPriority::URGENT)) {
+        return false;
+    }
+    value = static_cast<TaskPriority>(number);
+    return true;
+}
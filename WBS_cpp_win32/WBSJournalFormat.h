@@ -0,0 +1,336 @@
+/*
+ * ============================================================================
+ * WBSJournalFormat.h - WBSアプリケーション 編集ジャーナル形式（.wbsj）
+ * ============================================================================
+ *
+ * このヘッダーファイルは、プロジェクトファイルの横に置く追記専用の
+ * 編集ジャーナルのファイルレイアウトと、レコードの符号化・復号クラスを定義します。
+ * ジャーナルは最後に保存したスナップショット（.xml / .wbsb）からの
+ * 差分（フィールド編集・タスク挿入・タスク削除）を記録します。
+ *
+ * 【ファイル構造】（全てリトルエンディアン）
+ * +-----------------------------+
+ * | WBSJournalHeader (24バイト)  |  対応するスナップショットのサイズとハッシュ
+ * +-----------------------------+
+ * | レコード × N                 |  保存のたびに末尾へ追記
+ * +-----------------------------+
+ *
+ * 【レコード構造】
+ * - uint32_t length    : 以降のバイト数（チェックサム・本体）
+ * - uint32_t checksum  : 本体のハッシュ（書き込み途中で中断されたレコードの検出用）
+ * - uint8_t  op        : WBSJournalOp
+ * - uint8_t  field     : WBSJournalField（SetField のみ）
+ * - uint16_t depth     : タスクパスの深さ（0 = ルートタスク）
+ * - uint32_t × depth   : ルートからの子索引の列
+ * - 値                 : op・field に応じた値（文字列は uint32_t 長 + UTF-8）
+ *
+ * 【設計原則】
+ * - 追記専用: 保存時は未保存のレコードを末尾に書き足すだけ（既存部分は書き換えない）
+ * - 自己検証: 途中までしか書かれていないレコード以降は再生しない
+ * - スナップショットとの対応付け: ヘッダーのサイズ・ハッシュが一致しない
+ *   ジャーナル（別の保存内容に対するもの）は無視する
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include "WBSUtf8.h"
+#include "WBSOutputSink.h"
+
+// ============================================================================
+// 形式定数
+// ============================================================================
+
+const char kWBSJournalMagic[4] = { 'W', 'B', 'S', 'J' };   ///< ファイル識別子
+const uint16_t kWBSJournalVersion = 1;                      ///< 現在の形式バージョン
+const size_t kWBSJournalRecordPrefix = 8;                   ///< length + checksum のバイト数
+const uint16_t kWBSJournalMaxDepth = 0xFFFF;                ///< タスクパスの最大深さ
+
+/**
+ * @brief ジャーナルレコードの種類
+ */
+enum class WBSJournalOp : uint8_t {
+    SetField = 1,       ///< タスクの1フィールドを変更
+    InsertTask = 2,     ///< タスクを挿入（パスは挿入後の位置）
+    DeleteTask = 3      ///< タスクを部分木ごと削除
+};
+
+/**
+ * @brief SetField レコードの対象フィールド
+ */
+enum class WBSJournalField : uint8_t {
+    Id = 1,
+    TaskName = 2,
+    Description = 3,
+    AssignedTo = 4,
+    Status = 5,             ///< int32_t
+    Priority = 6,           ///< int32_t
+    EstimatedHours = 7,     ///< double
+    ActualHours = 8,        ///< double
+    StartDate = 9,          ///< PackDateTime() の値
+    EndDate = 10            ///< PackDateTime() の値
+};
+
+/**
+ * @brief .wbsj ファイルのヘッダー（24バイト）
+ */
+struct WBSJournalHeader {
+    char magic[4];              ///< "WBSJ"
+    uint16_t version;           ///< 形式バージョン
+    uint16_t headerSize;        ///< sizeof(WBSJournalHeader)
+    uint64_t snapshotSize;      ///< 対応するスナップショットのバイト数
+    uint64_t snapshotHash;      ///< 対応するスナップショットのハッシュ
+};
+
+static_assert(sizeof(WBSJournalHeader) == 24, "WBSJournalHeader must be 24 bytes");
+
+// ============================================================================
+// ハッシュ関数
+// ============================================================================
+
+const uint64_t kWBSJournalHashSeed = 0xCBF29CE484222325ULL;    ///< FNV-1a 64ビットの初期値
+
+/**
+ * @brief バイト列のハッシュを更新（FNV-1a 64ビット）
+ *
+ * @param hash これまでのハッシュ値（最初は kWBSJournalHashSeed）
+ * @param data 追加するバイト列
+ * @param size バイト数
+ * @return 更新後のハッシュ値
+ *
+ * 分割して呼び出しても一括で呼び出した場合と同じ値になります。
+ */
+inline uint64_t UpdateJournalHash(uint64_t hash, const char* data, size_t size) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief 書き込んだバイト列のサイズとハッシュを計算しながら転送する出力先
+ *
+ * スナップショット保存時に、内容を読み直さずにジャーナルヘッダー用の値を得るために使用します。
+ */
+class WBSHashingSink : public WBSOutputSink {
+public:
+    explicit WBSHashingSink(WBSOutputSink& inner) : inner_(inner), size_(0), hash_(kWBSJournalHashSeed) {}
+
+    bool Write(const char* data, size_t size) override {
+        size_ += size;
+        hash_ = UpdateJournalHash(hash_, data, size);
+        return inner_.Write(data, size);
+    }
+
+    uint64_t Size() const { return size_; }
+    uint64_t Hash() const { return hash_; }
+
+private:
+    WBSOutputSink& inner_;  ///< 転送先
+    uint64_t size_;         ///< 書き込んだバイト数
+    uint64_t hash_;         ///< 書き込んだ内容のハッシュ
+};
+
+// ============================================================================
+// レコードの符号化
+// ============================================================================
+
+/**
+ * @brief ジャーナルレコードをバイト列へ追加するエンコーダー
+ *
+ * Begin() → Put～() → End() の順に呼び出します。End() で長さと
+ * チェックサムが確定します。
+ */
+class WBSJournalRecordWriter {
+public:
+    /**
+     * @brief コンストラクタ
+     * @param out 追加先のバイト列（エンコーダーより長く生存させること）
+     */
+    explicit WBSJournalRecordWriter(std::string& out) : out_(out), start_(0) {}
+
+    /**
+     * @brief レコードを開始
+     * @param op レコードの種類
+     * @param field 対象フィールド（SetField 以外では0）
+     * @param path ルートからの子索引の列
+     */
+    void Begin(WBSJournalOp op, uint8_t field, const std::vector<uint32_t>& path) {
+        start_ = out_.size();
+        out_.append(kWBSJournalRecordPrefix, '\0');
+        PutU8(static_cast<uint8_t>(op));
+        PutU8(field);
+        PutRaw(static_cast<uint16_t>(path.size()));
+        for (uint32_t index : path) {
+            PutRaw(index);
+        }
+    }
+
+    void PutU8(uint8_t value) { out_ += static_cast<char>(value); }
+    void PutI32(int32_t value) { PutRaw(value); }
+    void PutU64(uint64_t value) { PutRaw(value); }
+    void PutDouble(double value) { PutRaw(value); }
+
+    /**
+     * @brief 文字列を uint32_t 長 + UTF-8 で追加
+     * @param text 内部文字列（UTF-8）
+     */
+    void PutText(const std::string& text) {
+        PutRaw(static_cast<uint32_t>(text.size()));
+        out_.append(text);
+    }
+
+    /**
+     * @brief レコードを確定（長さとチェックサムを書き込む）
+     */
+    void End() {
+        size_t bodyPos = start_ + kWBSJournalRecordPrefix;
+        uint32_t length = static_cast<uint32_t>(out_.size() - start_ - sizeof(uint32_t));
+        uint32_t checksum = RecordChecksum(out_.data() + bodyPos, out_.size() - bodyPos);
+        memcpy(&out_[start_], &length, sizeof(length));
+        memcpy(&out_[start_ + sizeof(uint32_t)], &checksum, sizeof(checksum));
+    }
+
+    /**
+     * @brief レコード本体のチェックサム
+     */
+    static uint32_t RecordChecksum(const char* body, size_t size) {
+        uint64_t hash = UpdateJournalHash(kWBSJournalHashSeed, body, size);
+        return static_cast<uint32_t>(hash ^ (hash >> 32));
+    }
+
+private:
+    template <typename T>
+    void PutRaw(T value) {
+        out_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    std::string& out_;      ///< 追加先
+    size_t start_;          ///< 書き込み中のレコードの開始位置
+};
+
+// ============================================================================
+// レコードの復号
+// ============================================================================
+
+/**
+ * @brief ジャーナルのレコード列を先頭から読み取るデコーダー
+ *
+ * Next() は長さとチェックサムが正しい完全なレコードでのみtrueを返します。
+ * 値の取得関数はレコードの範囲外を読もうとした場合falseを返します。
+ */
+class WBSJournalRecordReader {
+public:
+    /**
+     * @brief コンストラクタ
+     * @param first レコード列の先頭（ヘッダーの直後）
+     * @param last レコード列の終端
+     */
+    WBSJournalRecordReader(const char* first, const char* last)
+        : next_(first), last_(last), cursor_(first), recordEnd_(first),
+          op_(WBSJournalOp::SetField), field_(0), depth_(0), path_(nullptr) {}
+
+    /**
+     * @brief 次のレコードへ進む
+     * @return 完全なレコードを読み取れた場合true（終端・破損ではfalse）
+     */
+    bool Next() {
+        uint32_t length, checksum;
+        if (static_cast<size_t>(last_ - next_) < kWBSJournalRecordPrefix) {
+            return false;
+        }
+        memcpy(&length, next_, sizeof(length));
+        memcpy(&checksum, next_ + sizeof(uint32_t), sizeof(checksum));
+        if (length < sizeof(uint32_t) + 4 || length > static_cast<size_t>(last_ - next_) - sizeof(uint32_t)) {
+            return false; // 書き込み途中で中断されたレコード
+        }
+
+        const char* body = next_ + kWBSJournalRecordPrefix;
+        const char* end = next_ + sizeof(uint32_t) + length;
+        if (WBSJournalRecordWriter::RecordChecksum(body, end - body) != checksum) {
+            return false;
+        }
+
+        cursor_ = body;
+        recordEnd_ = end;
+        uint8_t op;
+        uint16_t depth;
+        if (!GetU8(op) || !GetU8(field_) || !GetRaw(depth) ||
+            static_cast<size_t>(recordEnd_ - cursor_) < static_cast<size_t>(depth) * sizeof(uint32_t)) {
+            return false;
+        }
+        op_ = static_cast<WBSJournalOp>(op);
+        depth_ = depth;
+        path_ = cursor_;
+        cursor_ += static_cast<size_t>(depth) * sizeof(uint32_t);
+        next_ = end;
+        return true;
+    }
+
+    /**
+     * @brief 読み取り済み（正常に検証された）部分の終端
+     */
+    const char* Position() const { return next_; }
+
+    WBSJournalOp Op() const { return op_; }
+    uint8_t Field() const { return field_; }
+    uint16_t Depth() const { return depth_; }
+
+    /**
+     * @brief タスクパスの i 番目の子索引
+     */
+    uint32_t PathAt(uint16_t i) const {
+        uint32_t index;
+        memcpy(&index, path_ + static_cast<size_t>(i) * sizeof(uint32_t), sizeof(index));
+        return index;
+    }
+
+    bool GetU8(uint8_t& value) { return GetRaw(value); }
+    bool GetI32(int32_t& value) { return GetRaw(value); }
+    bool GetU64(uint64_t& value) { return GetRaw(value); }
+    bool GetDouble(double& value) { return GetRaw(value); }
+
+    /**
+     * @brief 文字列（uint32_t 長 + UTF-8）を取得
+     * @param text [out] 内部文字列（不正なバイト列は U+FFFD に置き換え）
+     */
+    bool GetText(std::string& text) {
+        uint32_t length;
+        if (!GetRaw(length) || length > static_cast<size_t>(recordEnd_ - cursor_)) {
+            return false;
+        }
+        text.clear();
+        AppendSanitizedUtf8(text, cursor_, cursor_ + length);
+        cursor_ += length;
+        return true;
+    }
+
+private:
+    template <typename T>
+    bool GetRaw(T& value) {
+        if (static_cast<size_t>(recordEnd_ - cursor_) < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, cursor_, sizeof(T));
+        cursor_ += sizeof(T);
+        return true;
+    }
+
+    const char* next_;          ///< 次のレコードの先頭
+    const char* last_;          ///< レコード列の終端
+    const char* cursor_;        ///< 現在のレコード内の読み取り位置
+    const char* recordEnd_;     ///< 現在のレコードの終端
+    WBSJournalOp op_;           ///< 現在のレコードの種類
+    uint8_t field_;             ///< 現在のレコードの対象フィールド
+    uint16_t depth_;            ///< 現在のレコードのパスの深さ
+    const char* path_;          ///< 現在のレコードのパスの先頭
+};
@@ -0,0 +1,395 @@
+/*
+ * ============================================================================
+ * WBSJsonReader.h - WBSアプリケーション 前方向専用JSONプルパーサー
+ * ============================================================================
+ *
+ * このヘッダーファイルは、UTF-8のJSON文書を先頭から一度だけ走査して
+ * トークン（オブジェクト・配列の開始と終了、メンバー名、値）を順に取り出す
+ * プルパーサーを提供します。WBSXmlReader のJSON版で、DOMは構築しません。
+ *
+ * 【主な機能】
+ * - 中間部分文字列を作らないトークン化（ポインタ範囲のみを保持）
+ * - オブジェクト・配列の入れ子とカンマ・コロンの文法検査
+ * - エスケープ（\n、\uXXXX、サロゲートペア等）を復元しながら呼び出し側のバッファへ直接追加
+ * - 不要な値（未知のメンバー等）の読み飛ばし
+ *
+ * 【設計原則】
+ * - 線形時間: 入力の各文字は高々定数回しか読まない
+ * - ゼロコピー: メンバー名と値は入力バッファ内の範囲として返す
+ * - 文字列の内容のみを wchar_t に変換（メンバー名は変換しない）
+ * - 例外を投げない: 構文エラーは WBSJsonToken::Error として呼び出し側へ返す
+ *
+ * 【使用例】
+ * @code
+ * WBSJsonReader reader(json.data(), json.data() + json.size());
+ * for (auto token = reader.Next(); token != WBSJsonToken::End; token = reader.Next()) {
+ *     if (token == WBSJsonToken::Key && reader.KeyIs("Name")) { ... }
+ * }
+ * @endcode
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <vector>
+#include <cstring>
+#include "WBSUtf8.h"
+
+// ============================================================================
+// JSONプルパーサー
+// ============================================================================
+
+/**
+ * @brief Next() が返すトークンの種類
+ */
+enum class WBSJsonToken {
+    BeginObject,    ///< '{'
+    EndObject,      ///< '}'
+    BeginArray,     ///< '['
+    EndArray,       ///< ']'
+    Key,            ///< オブジェクトのメンバー名（続く Next() がその値を返す）
+    String,         ///< 文字列値
+    Number,         ///< 数値
+    Literal,        ///< true・false・null
+    End,            ///< 文書の終端（最上位の値の後ろ）
+    Error           ///< 構文エラー
+};
+
+/**
+ * @brief UTF-8のJSON文書用の前方向専用トークナイザー
+ *
+ * 入力は正しいUTF-8であることが前提です（読み込み側で IsValidUtf8() により検証）。
+ * 数値はトークンの範囲だけを切り出し、値としての検査と変換は
+ * 使用する側（WBSFieldCodec.h の Parse*Field()）が行います。
+ */
+class WBSJsonReader {
+public:
+    typedef WBSJsonToken Token;
+
+    /**
+     * @brief コンストラクタ
+     * @param first 文書の先頭（リーダーより長く生存させること）
+     * @param last 文書の終端
+     */
+    WBSJsonReader(const char* first, const char* last)
+        : pos_(first), end_(last), state_(State::Value), valueFirst_(first), valueLast_(first), escaped_(false) {
+        if (last - first >= 3 && memcmp(first, "\xEF\xBB\xBF", 3) == 0) {
+            pos_ += 3;      // UTF-8のBOM
+        }
+    }
+
+    /**
+     * @brief 次のトークンを読み取る
+     * @return トークンの種類（Error の後は Error を返し続ける）
+     */
+    Token Next() {
+        SkipSpace();
+        switch (state_) {
+            case State::Error:
+                return Token::Error;
+
+            case State::Done:
+                return pos_ == end_ ? Token::End : Fail();
+
+            case State::AfterValue:
+                if (pos_ == end_) {
+                    return Fail();
+                }
+                if (*pos_ == ',') {
+                    ++pos_;
+                    state_ = (containers_.back() == '{') ? State::Key : State::Value;
+                    return Next();
+                }
+                return CloseContainer();
+
+            case State::KeyOrClose:
+                if (pos_ < end_ && *pos_ == '}') {
+                    return CloseContainer();
+                }
+                // fall through
+            case State::Key:
+                if (pos_ == end_ || *pos_ != '"' || !ScanString()) {
+                    return Fail();
+                }
+                SkipSpace();
+                if (pos_ == end_ || *pos_ != ':') {
+                    return Fail();
+                }
+                ++pos_;
+                state_ = State::Value;
+                return Token::Key;
+
+            case State::ValueOrClose:
+                if (pos_ < end_ && *pos_ == ']') {
+                    return CloseContainer();
+                }
+                // fall through
+            case State::Value:
+                return ReadValue();
+        }
+        return Fail();
+    }
+
+    /**
+     * @brief 現在のメンバー名が指定名と一致するか判定（Key トークン用）
+     * @param name 比較するASCII名
+     *
+     * エスケープを含むメンバー名は一致しないものとして扱います。
+     */
+    bool KeyIs(const char* name) const {
+        size_t length = strlen(name);
+        return !escaped_ && static_cast<size_t>(valueLast_ - valueFirst_) == length &&
+               memcmp(valueFirst_, name, length) == 0;
+    }
+
+    /**
+     * @brief 現在の文字列値（またはメンバー名）をエスケープを復元して追加
+     * @param out 追加先（UTF-8。エスケープのない値は変換せずにコピー）
+     */
+    void AppendString(std::string& out) const {
+        if (!escaped_) {
+            out.append(valueFirst_, valueLast_);
+            return;
+        }
+        AppendUnescaped(out, valueFirst_, valueLast_);
+    }
+
+    /**
+     * @brief 文字列値の引用符の内側をエスケープを復元して追加
+     * @param out 追加先（UTF-8）
+     * @param first Value() が返した範囲の先頭（ScanString() で検査済みであること）
+     * @param last 範囲の終端
+     *
+     * 復元を最初の参照まで遅らせるフィールド（WBSColdText::AssignEncoded()）の
+     * 復元関数としても使用します。
+     */
+    static void AppendUnescaped(std::string& out, const char* first, const char* last) {
+        const char* p = first;
+        while (p < last) {
+            const char* backslash = static_cast<const char*>(memchr(p, '\\', static_cast<size_t>(last - p)));
+            if (!backslash) {
+                out.append(p, last);
+                break;
+            }
+            out.append(p, backslash);
+            p = backslash + 1;      // ScanString() でエスケープの形式は検査済み
+            char c = *p++;
+            switch (c) {
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    char32_t codePoint = ReadHex4(p);
+                    p += 4;
+                    if (codePoint >= 0xD800 && codePoint <= 0xDBFF && last - p >= 6 && p[0] == '\\' && p[1] == 'u') {
+                        char32_t low = ReadHex4(p + 2);
+                        if (low >= 0xDC00 && low <= 0xDFFF) {
+                            codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                            p += 6;
+                        }
+                    }
+                    if (codePoint >= 0xD800 && codePoint <= 0xDFFF) {
+                        codePoint = 0xFFFD;     // 対になっていないサロゲート
+                    }
+                    AppendCodePointUtf8(out, codePoint);
+                    break;
+                }
+                default:
+                    out += c;                           // " \ /
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief 現在の値の入力上の範囲を取得（Number・Literal、および文字列の引用符の内側）
+     * @param first [out] 範囲の先頭
+     * @param last [out] 範囲の終端
+     */
+    void Value(const char*& first, const char*& last) const {
+        first = valueFirst_;
+        last = valueLast_;
+    }
+
+    /**
+     * @brief 現在の文字列値がエスケープを含むか判定
+     */
+    bool HasEscapes() const { return escaped_; }
+
+    /**
+     * @brief 直前に返した値を読み飛ばす
+     * @return 成功した場合true（構文エラーの場合false）
+     *
+     * BeginObject・BeginArray の直後に呼び出すと、対応する EndObject・EndArray までを
+     * 読み飛ばします。それ以外の値の場合は何もしません。
+     */
+    bool SkipValue(Token token) {
+        if (token != Token::BeginObject && token != Token::BeginArray) {
+            return token != Token::Error;
+        }
+        size_t depth = containers_.size();
+        while (containers_.size() >= depth) {
+            if (Next() == Token::Error) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief 現在の入れ子の深さ（開いているオブジェクト・配列の数）
+     */
+    size_t Depth() const { return containers_.size(); }
+
+private:
+    enum class State {
+        Value,          ///< 値（最上位、メンバー名の後、配列のカンマの後）
+        ValueOrClose,   ///< '[' の直後（値または ']'）
+        Key,            ///< オブジェクトのカンマの後（メンバー名）
+        KeyOrClose,     ///< '{' の直後（メンバー名または '}'）
+        AfterValue,     ///< 値の後（',' または閉じ括弧）
+        Done,           ///< 最上位の値の後
+        Error
+    };
+
+    Token Fail() {
+        state_ = State::Error;
+        return Token::Error;
+    }
+
+    void SkipSpace() {
+        while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t')) {
+            ++pos_;
+        }
+    }
+
+    void ValueDone() {
+        state_ = containers_.empty() ? State::Done : State::AfterValue;
+    }
+
+    Token CloseContainer() {
+        if (pos_ == end_ || containers_.empty()) {
+            return Fail();
+        }
+        char open = containers_.back();
+        if ((open == '{' && *pos_ != '}') || (open == '[' && *pos_ != ']')) {
+            return Fail();
+        }
+        ++pos_;
+        containers_.pop_back();
+        ValueDone();
+        return open == '{' ? Token::EndObject : Token::EndArray;
+    }
+
+    Token ReadValue() {
+        if (pos_ == end_) {
+            return Fail();
+        }
+        char c = *pos_;
+        if (c == '{' || c == '[') {
+            ++pos_;
+            containers_.push_back(c);
+            state_ = (c == '{') ? State::KeyOrClose : State::ValueOrClose;
+            return c == '{' ? Token::BeginObject : Token::BeginArray;
+        }
+        if (c == '"') {
+            if (!ScanString()) {
+                return Fail();
+            }
+            ValueDone();
+            return Token::String;
+        }
+
+        // 数値・リテラル: 区切り（空白・カンマ・閉じ括弧）までの範囲
+        const char* first = pos_;
+        while (pos_ < end_ && ((*pos_ >= '0' && *pos_ <= '9') || (*pos_ >= 'a' && *pos_ <= 'z') ||
+                               *pos_ == '-' || *pos_ == '+' || *pos_ == '.' || *pos_ == 'E')) {
+            ++pos_;
+        }
+        valueFirst_ = first;
+        valueLast_ = pos_;
+        escaped_ = false;
+        size_t length = static_cast<size_t>(pos_ - first);
+        if (length == 0) {
+            return Fail();
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            ValueDone();
+            return Token::Number;
+        }
+        if ((length == 4 && memcmp(first, "true", 4) == 0) || (length == 5 && memcmp(first, "false", 5) == 0) ||
+            (length == 4 && memcmp(first, "null", 4) == 0)) {
+            ValueDone();
+            return Token::Literal;
+        }
+        return Fail();
+    }
+
+    /**
+     * @brief '"' の位置から文字列を読み取り、引用符の内側を値の範囲とする
+     * @return 正しい文字列の場合true（閉じられていない、不正なエスケープ・制御文字はfalse）
+     */
+    bool ScanString() {
+        const char* p = ++pos_;
+        escaped_ = false;
+        while (p < end_) {
+            unsigned char c = static_cast<unsigned char>(*p);
+            if (c == '"') {
+                valueFirst_ = pos_;
+                valueLast_ = p;
+                pos_ = p + 1;
+                return true;
+            }
+            if (c < 0x20) {
+                return false;
+            }
+            if (c == '\\') {
+                escaped_ = true;
+                if (++p == end_) {
+                    return false;
+                }
+                if (*p == 'u') {
+                    if (end_ - p < 5 || ReadHex4(p + 1) > 0xFFFF) {
+                        return false;
+                    }
+                    p += 4;
+                } else if (!strchr("\"\\/bfnrt", *p) || *p == '\0') {
+                    return false;
+                }
+            }
+            ++p;
+        }
+        return false;
+    }
+
+    /**
+     * @brief 16進数4桁を読み取る（不正な場合は 0xFFFFFFFF）
+     */
+    static char32_t ReadHex4(const char* p) {
+        char32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = p[i];
+            unsigned digit;
+            if (c >= '0' && c <= '9') digit = static_cast<unsigned>(c - '0');
+            else if (c >= 'a' && c <= 'f') digit = static_cast<unsigned>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') digit = static_cast<unsigned>(c - 'A' + 10);
+            else return 0xFFFFFFFF;
+            value = (value << 4) | digit;
+        }
+        return value;
+    }
+
+    const char* pos_;                   ///< 現在の読み取り位置
+    const char* end_;                   ///< 文書の終端
+    State state_;                       ///< 次に読み取るトークンの文法上の位置
+    std::vector<char> containers_;      ///< 開いているオブジェクト・配列（'{' または '['）
+    const char* valueFirst_;            ///< 現在の値・メンバー名の先頭
+    const char* valueLast_;             ///< 現在の値・メンバー名の終端
+    bool escaped_;                      ///< 現在の文字列がエスケープを含むか
+};
@@ -0,0 +1,237 @@
+/*
+ * ============================================================================
+ * WBSJsonWriter.h - WBSアプリケーション ストリーミングJSONライター
+ * ============================================================================
+ *
+ * このヘッダーファイルは、WBSプロジェクトのJSON表現を再利用可能なUTF-8バイト
+ * バッファへ直接書き込み、一定量ごとに出力先（ファイル等）へ書き出すライターを
+ * 提供します。WBSXmlWriter のJSON版です。
+ *
+ * 【主な機能】
+ * - WBSJsonWriter: インデント付きのオブジェクト・配列・メンバーの書き込みとバッファ管理
+ * - AppendJsonEscapedUtf8(): UTF-8バイト列のJSON文字列エスケープ
+ * - 区切りのカンマはライターが挿入（呼び出し側は要素の順に書くだけ）
+ *
+ * 【設計原則】
+ * - ノードごとの文字列生成や連結を行わない（各バイトは一度だけコピー）
+ * - バッファは閾値に達するたびに書き出して再利用（使用メモリはプロジェクト規模に非依存）
+ * - 書き込みエラーは戻り値で通知し、例外は投げない
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include "WBSUtf8.h"
+#include "WBSOutputSink.h"
+
+// ============================================================================
+// JSONエスケープ
+// ============================================================================
+
+/**
+ * @brief UTF-8バイト列をJSON文字列としてエスケープして追加
+ *
+ * @param out 追加先のバイト列
+ * @param first 範囲の先頭（正しいUTF-8であること）
+ * @param last 範囲の終端
+ *
+ * '"'・'\\' と制御文字（U+0000～U+001F）をエスケープします（\n・\r・\t 等は
+ * 短い形式、それ以外は \\u00XX）。非ASCII文字はUTF-8のまま書き込みます。
+ * エスケープ不要な連続部分は変換せずに一括コピーします。
+ */
+inline void AppendJsonEscapedUtf8(std::string& out, const char* first, const char* last) {
+    static const char kHexDigits[] = "0123456789abcdef";
+    while (first < last) {
+        const char* run = first;
+        while (run < last && *run != '"' && *run != '\\' && static_cast<unsigned char>(*run) >= 0x20) {
+            ++run;
+        }
+        out.append(first, run);
+        if (run == last) {
+            break;
+        }
+
+        unsigned c = static_cast<unsigned char>(*run);
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                out += "\\u00";
+                out += kHexDigits[c >> 4];
+                out += kHexDigits[c & 0xF];
+                break;
+        }
+        first = run + 1;
+    }
+}
+
+// ============================================================================
+// ストリーミングJSONライター
+// ============================================================================
+
+/**
+ * @brief UTF-8バッファへ直接書き込むJSONライター
+ *
+ * オブジェクト・配列・メンバーは呼び出し順にバッファへ追加され、バッファが
+ * kFlushThreshold を超えるたびに出力先へ書き出されます。
+ * 最後に必ず Flush() を呼び出してください。
+ *
+ * 名前（name）はオブジェクト内のメンバー名です。配列の要素や最上位の値では
+ * nullptr を渡します。名前はエスケープ不要なASCII文字列であることが前提です。
+ */
+class WBSJsonWriter {
+public:
+    static const size_t kFlushThreshold = 1024 * 1024;     ///< 書き出し単位（1MB）
+
+    /**
+     * @brief コンストラクタ
+     * @param sink 出力先（ライターより長く生存させること）
+     */
+    explicit WBSJsonWriter(WBSOutputSink& sink) : sink_(sink), started_(false), needComma_(false), failed_(false) {
+        buffer_.reserve(kFlushThreshold + 64 * 1024);
+    }
+
+    /**
+     * @brief 文字列をそのまま追加（文書末尾の改行など）
+     * @param text ASCII文字列
+     */
+    void Raw(const char* text) {
+        buffer_ += text;
+        FlushIfFull();
+    }
+
+    /**
+     * @brief オブジェクトを開始（"name": { または {）
+     * @param indent インデント（空白文字数）
+     * @param name メンバー名（配列の要素・最上位の値は nullptr）
+     */
+    void OpenObject(int indent, const char* name) {
+        BeginValue(indent, name);
+        buffer_ += '{';
+        needComma_ = false;
+    }
+
+    /**
+     * @brief オブジェクトを終了
+     * @param indent 対応する OpenObject() と同じインデント
+     */
+    void CloseObject(int indent) {
+        EndContainer(indent, '}');
+    }
+
+    /**
+     * @brief 配列を開始（"name": [ または [）
+     * @param indent インデント（空白文字数）
+     * @param name メンバー名（配列の要素・最上位の値は nullptr）
+     */
+    void OpenArray(int indent, const char* name) {
+        BeginValue(indent, name);
+        buffer_ += '[';
+        needComma_ = false;
+    }
+
+    /**
+     * @brief 配列を終了
+     * @param indent 対応する OpenArray() と同じインデント
+     */
+    void CloseArray(int indent) {
+        EndContainer(indent, ']');
+    }
+
+    /**
+     * @brief 文字列メンバーをJSONエスケープして追加
+     * @param indent インデント（空白文字数）
+     * @param name メンバー名
+     * @param value メンバーの値（UTF-8）
+     */
+    void TextMember(int indent, const char* name, const std::string& value) {
+        BeginValue(indent, name);
+        buffer_ += '"';
+        AppendJsonEscapedUtf8(buffer_, value.data(), value.data() + value.size());
+        buffer_ += '"';
+        FlushIfFull();
+    }
+
+    /**
+     * @brief 書式化済みのASCII値を持つメンバーを追加（数値・日付用）
+     * @param indent インデント（空白文字数）
+     * @param name メンバー名
+     * @param value 値（エスケープ不要なASCII文字列）
+     * @param length 値の長さ
+     * @param quoted true の場合は文字列として '"' で囲む（日付、JSONの数値で表せない値）
+     */
+    void RawMember(int indent, const char* name, const char* value, size_t length, bool quoted) {
+        BeginValue(indent, name);
+        if (quoted) buffer_ += '"';
+        buffer_.append(value, length);
+        if (quoted) buffer_ += '"';
+        FlushIfFull();
+    }
+
+    /**
+     * @brief バッファの内容をすべて出力先へ書き出す
+     * @return これまでの書き込みがすべて成功していればtrue
+     */
+    bool Flush() {
+        if (!buffer_.empty() && !failed_) {
+            failed_ = !sink_.Write(buffer_.data(), buffer_.size());
+        }
+        buffer_.clear();
+        return !failed_;
+    }
+
+    /**
+     * @brief 書き込みエラーが発生したか判定
+     */
+    bool Failed() const { return failed_; }
+
+private:
+    void BeginValue(int indent, const char* name) {
+        if (needComma_) {
+            buffer_ += ',';
+        }
+        if (started_) {
+            buffer_ += '\n';
+        }
+        started_ = true;
+        buffer_.append(indent, ' ');
+        if (name) {
+            buffer_ += '"';
+            buffer_ += name;
+            buffer_ += "\": ";
+        }
+        needComma_ = true;
+    }
+
+    void EndContainer(int indent, char close) {
+        if (needComma_) {
+            // 要素がある場合は閉じ括弧を改行して揃える（空の場合は {} / [] とする）
+            buffer_ += '\n';
+            buffer_.append(indent, ' ');
+        }
+        buffer_ += close;
+        needComma_ = true;
+        FlushIfFull();
+    }
+
+    void FlushIfFull() {
+        if (buffer_.size() >= kFlushThreshold) {
+            Flush();
+        }
+    }
+
+    WBSOutputSink& sink_;   ///< 出力先
+    std::string buffer_;    ///< 再利用するUTF-8バッファ
+    bool started_;          ///< 最初の値を書き込み済みか（文書の先頭には改行を入れない）
+    bool needComma_;        ///< 次の値の前にカンマが必要か（同じ階層に値を書き込み済み）
+    bool failed_;           ///< 書き込みエラー発生フラグ
+};
@@ -0,0 +1,147 @@
+/*
+ * ============================================================================
+ * WBSMappedFile.h - WBSアプリケーション 読み取り専用メモリマップファイル
+ * ============================================================================
+ *
+ * このヘッダーファイルは、プロジェクトファイルをストリームを介さずに
+ * アドレス空間へ直接マップする読み取り専用のRAIIクラスを提供します。
+ *
+ * 【主な機能】
+ * - ファイル全体を読み取り専用でメモリマップ
+ * - デストラクタでのマップ解除・ハンドル解放
+ * - 空ファイルの安全な取り扱い（Data() は nullptr、Size() は 0）
+ *
+ * 【設計原則】
+ * - RAII: マップとハンドルの寿命をオブジェクトに結び付ける
+ * - 例外を投げない: 失敗は IsOpen() で判定
+ * - ページはアクセスされた時点でOSが読み込む（読み込みコピーなし）
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "WBSUtf8.h"
+#endif
+
+// ============================================================================
+// メモリマップファイル
+// ============================================================================
+
+/**
+ * @brief 読み取り専用のメモリマップファイル
+ *
+ * コピー不可。マップされたメモリはオブジェクトの生存期間中のみ有効です。
+ */
+class WBSMappedFile {
+public:
+    /**
+     * @brief ファイルを開いてメモリマップする
+     * @param path 対象のファイルパス
+     * @param sequential 先頭から順に読む場合true（先読みを有効化）、
+     *                   必要な箇所だけを読む場合false（先読みを抑制）
+     */
+    explicit WBSMappedFile(const std::wstring& path, bool sequential = true)
+        : data_(nullptr), size_(0), opened_(false) {
+#ifdef _WIN32
+        file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | (sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS),
+                            nullptr);
+        mapping_ = nullptr;
+        if (file_ == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file_, &fileSize)) {
+            return;
+        }
+        size_ = static_cast<size_t>(fileSize.QuadPart);
+        if (size_ == 0) {
+            opened_ = true; // 空ファイルはマップせずに成功扱い
+            return;
+        }
+
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            return;
+        }
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        opened_ = (data_ != nullptr);
+#else
+        file_ = open(WideToUtf8(path).c_str(), O_RDONLY);
+        if (file_ < 0) {
+            return;
+        }
+
+        struct stat info;
+        if (fstat(file_, &info) != 0) {
+            return;
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ == 0) {
+            opened_ = true;
+            return;
+        }
+
+        void* view = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file_, 0);
+        if (view == MAP_FAILED) {
+            return;
+        }
+        madvise(view, size_, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+        data_ = static_cast<const char*>(view);
+        opened_ = true;
+#endif
+    }
+
+    ~WBSMappedFile() {
+#ifdef _WIN32
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) munmap(const_cast<char*>(data_), size_);
+        if (file_ >= 0) close(file_);
+#endif
+    }
+
+    WBSMappedFile(const WBSMappedFile&) = delete;
+    WBSMappedFile& operator=(const WBSMappedFile&) = delete;
+
+    /**
+     * @brief マップに成功したか判定
+     */
+    bool IsOpen() const { return opened_; }
+
+    /**
+     * @brief マップされた内容の先頭を取得（空ファイルの場合はnullptr）
+     */
+    const char* Data() const { return data_; }
+
+    /**
+     * @brief ファイルサイズ（バイト数）を取得
+     */
+    size_t Size() const { return size_; }
+
+private:
+#ifdef _WIN32
+    HANDLE file_;           ///< ファイルハンドル
+    HANDLE mapping_;        ///< ファイルマッピングオブジェクト
+#else
+    int file_;              ///< ファイル記述子
+#endif
+    const char* data_;      ///< マップされた内容の先頭
+    size_t size_;           ///< ファイルサイズ
+    bool opened_;           ///< マップ成功フラグ
+};
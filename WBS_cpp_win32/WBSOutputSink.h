@@ -0,0 +1,147 @@
+/*
+ * ============================================================================
+ * WBSOutputSink.h - WBSアプリケーション バイト列出力先
+ * ============================================================================
+ *
+ * このヘッダーファイルは、保存処理（XML・バイナリ等）が生成したバイト列の
+ * 書き出し先を抽象化するクラス群を提供します。
+ *
+ * 【主な機能】
+ * - WBSOutputSink: 出力先の抽象インターフェース
+ * - WBSFileSink: ファイルへの出力先（上書き・追記）
+ * - WBSStringSink: メモリ上のバイト列への出力先
+ *
+ * 【設計原則】
+ * - 書き込みエラーは戻り値で通知し、例外は投げない
+ * - RAII: ファイルハンドルはデストラクタで解放
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <cstdio>
+#include "WBSUtf8.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// ============================================================================
+// 出力先インターフェース
+// ============================================================================
+
+/**
+ * @brief バイト列の出力先を表す抽象クラス
+ */
+class WBSOutputSink {
+public:
+    virtual ~WBSOutputSink() {}
+
+    /**
+     * @brief バイト列を書き込む
+     * @param data 書き込むデータ
+     * @param size データのバイト数
+     * @return 書き込みに成功した場合true
+     */
+    virtual bool Write(const char* data, size_t size) = 0;
+};
+
+/**
+ * @brief ファイルへの出力先
+ *
+ * 既存のファイルは上書き（追記モードでは末尾に追加）されます。
+ * デストラクタで自動的に閉じられます。
+ */
+class WBSFileSink : public WBSOutputSink {
+public:
+    /**
+     * @brief ファイルを作成して開く
+     * @param path 出力先のファイルパス
+     * @param append trueの場合は既存の内容を残して末尾に追記（ファイルがなければ作成）
+     */
+    explicit WBSFileSink(const std::wstring& path, bool append = false) {
+#ifdef _WIN32
+        handle_ = CreateFileW(path.c_str(), append ? FILE_APPEND_DATA : GENERIC_WRITE, 0, nullptr,
+                              append ? OPEN_ALWAYS : CREATE_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+#else
+        file_ = std::fopen(WideToUtf8(path).c_str(), append ? "ab" : "wb");
+#endif
+    }
+
+    ~WBSFileSink() { Close(); }
+
+    WBSFileSink(const WBSFileSink&) = delete;
+    WBSFileSink& operator=(const WBSFileSink&) = delete;
+
+    /**
+     * @brief ファイルが開かれているか判定
+     */
+    bool IsOpen() const {
+#ifdef _WIN32
+        return handle_ != INVALID_HANDLE_VALUE;
+#else
+        return file_ != nullptr;
+#endif
+    }
+
+    bool Write(const char* data, size_t size) override {
+        if (!IsOpen()) return false;
+#ifdef _WIN32
+        while (size > 0) {
+            DWORD chunk = size > 0x40000000 ? 0x40000000 : static_cast<DWORD>(size);
+            DWORD written = 0;
+            if (!WriteFile(handle_, data, chunk, &written, nullptr) || written != chunk) {
+                return false;
+            }
+            data += chunk;
+            size -= chunk;
+        }
+        return true;
+#else
+        return std::fwrite(data, 1, size, file_) == size;
+#endif
+    }
+
+    /**
+     * @brief ファイルを閉じる
+     * @return 正常に閉じられた場合true
+     */
+    bool Close() {
+#ifdef _WIN32
+        if (handle_ == INVALID_HANDLE_VALUE) return true;
+        BOOL ok = CloseHandle(handle_);
+        handle_ = INVALID_HANDLE_VALUE;
+        return ok != FALSE;
+#else
+        if (!file_) return true;
+        int result = std::fclose(file_);
+        file_ = nullptr;
+        return result == 0;
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    HANDLE handle_;         ///< ファイルハンドル
+#else
+    std::FILE* file_;       ///< ファイルストリーム
+#endif
+};
+
+/**
+ * @brief メモリ上のバイト列への出力先
+ */
+class WBSStringSink : public WBSOutputSink {
+public:
+    bool Write(const char* data, size_t size) override {
+        bytes.append(data, size);
+        return true;
+    }
+
+    std::string bytes;      ///< 書き込まれたバイト列
+};
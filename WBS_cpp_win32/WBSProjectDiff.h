@@ -0,0 +1,132 @@
+/*
+ * ============================================================================
+ * WBSProjectDiff.h - WBSアプリケーション 差分・3方向マージの結果型
+ * ============================================================================
+ *
+ * このヘッダーファイルは、2つのプロジェクトの構造的な差分（DiffProjects()）と、
+ * 共通の元プロジェクトを基準にした3方向マージ（MergeProjects()）の結果を表す
+ * 型を定義します。処理の実装は WBS_Merge_Functions.cpp にあります。
+ *
+ * 【タスクの対応付け】
+ * 1. ルートタスクどうしは常に対応付ける
+ * 2. 対応したタスクの子どうしを並び順に id で揃える
+ *    （部分木ハッシュが一致すれば子孫はまとめて対応付け）
+ * 3. 残ったタスクは id の索引で対応付ける（別の親へ移動したタスク）
+ * 4. さらに残ったタスクは id 以外のフィールドの内容が一致するものを対応付ける
+ *    （id が振り直されたタスクも移動として検出できる）
+ * 索引（ハッシュ表）は残ったタスクだけで作り、タスクどうしの総当たり比較は行いません。
+ *
+ * 【設計原則】
+ * - 結果のポインタは比較・マージしたプロジェクトの生存期間中のみ有効
+ * - 競合は自動で解決せず、現在のプロジェクトの値を残して印を付ける
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "WBSClasses.h"
+
+// ============================================================================
+// フィールドの識別
+// ============================================================================
+
+const uint32_t kWBSDiffFieldId = 1u << 0;               ///< タスクID
+const uint32_t kWBSDiffFieldTaskName = 1u << 1;         ///< タスク名
+const uint32_t kWBSDiffFieldDescription = 1u << 2;      ///< 説明
+const uint32_t kWBSDiffFieldAssignedTo = 1u << 3;       ///< 担当者
+const uint32_t kWBSDiffFieldStatus = 1u << 4;           ///< 状態
+const uint32_t kWBSDiffFieldPriority = 1u << 5;         ///< 優先度
+const uint32_t kWBSDiffFieldEstimatedHours = 1u << 6;   ///< 見積もり工数
+const uint32_t kWBSDiffFieldActualHours = 1u << 7;      ///< 実績工数
+const uint32_t kWBSDiffFieldStartDate = 1u << 8;        ///< 開始予定日
+const uint32_t kWBSDiffFieldEndDate = 1u << 9;          ///< 終了予定日
+const uint32_t kWBSDiffFieldCount = 10;                 ///< フィールドの数
+
+const char kWBSConflictMarker[] = u8"【競合】";         ///< 競合したタスクのタスク名に付ける印
+
+/**
+ * @brief フィールドの表示名を取得
+ * @param field kWBSDiffFieldXxx のいずれか1つ
+ */
+inline const char* GetWBSDiffFieldName(uint32_t field) {
+    switch (field) {
+        case kWBSDiffFieldId: return "ID";
+        case kWBSDiffFieldTaskName: return u8"タスク名";
+        case kWBSDiffFieldDescription: return u8"説明";
+        case kWBSDiffFieldAssignedTo: return u8"担当者";
+        case kWBSDiffFieldStatus: return u8"ステータス";
+        case kWBSDiffFieldPriority: return u8"優先度";
+        case kWBSDiffFieldEstimatedHours: return u8"予定時間";
+        case kWBSDiffFieldActualHours: return u8"実績時間";
+        case kWBSDiffFieldStartDate: return u8"開始日";
+        case kWBSDiffFieldEndDate: return u8"終了日";
+        default: return "";
+    }
+}
+
+// ============================================================================
+// 差分
+// ============================================================================
+
+/**
+ * @brief 差分の種類
+ */
+enum class WBSDiffKind {
+    Modified,   ///< フィールドの変更（位置は同じ）
+    Moved,      ///< 親の変更、または兄弟間の順序の変更（フィールドの変更を伴う場合あり）
+    Inserted,   ///< 比較先にだけ存在するタスク
+    Deleted     ///< 比較元にだけ存在するタスク
+};
+
+/**
+ * @brief 差分1件（タスク1件分）
+ *
+ * 挿入・削除はタスクごとに報告します（部分木の削除では子孫もそれぞれ Deleted）。
+ */
+struct WBSDiffEntry {
+    WBSDiffKind kind;               ///< 差分の種類
+    const WBSItem* base;            ///< 比較元のタスク（Inserted の場合はnullptr）
+    const WBSItem* other;           ///< 比較先のタスク（Deleted の場合はnullptr）
+    uint32_t changedFields;         ///< 変更されたフィールド（kWBSDiffFieldXxx の組み合わせ）
+};
+
+/**
+ * @brief 2つのプロジェクトの差分
+ */
+struct WBSProjectDiff {
+    bool projectNameChanged = false;        ///< プロジェクト名の変更
+    bool descriptionChanged = false;        ///< プロジェクト説明の変更
+    std::vector<WBSDiffEntry> entries;      ///< タスクの差分（比較先の行きがけ順、続いて削除）
+
+    bool empty() const { return !projectNameChanged && !descriptionChanged && entries.empty(); }
+};
+
+// ============================================================================
+// マージ
+// ============================================================================
+
+/**
+ * @brief マージの競合の種類
+ */
+enum class WBSMergeConflictKind {
+    FieldEdit,      ///< 同じフィールドが両方で異なる値に変更された
+    EditDelete,     ///< 一方で削除されたタスクが、他方で変更された（または子タスクが残っている）
+    Move            ///< 両方で異なる親へ移動された（または移動の組み合わせで親子が循環する）
+};
+
+/**
+ * @brief マージの競合1件
+ *
+ * 競合したタスクには現在のプロジェクトの値を残し、タスク名の先頭に
+ * kWBSConflictMarker を付け、説明の末尾に両方の値を追記します。
+ */
+struct WBSMergeConflict {
+    WBSMergeConflictKind kind;      ///< 競合の種類
+    const WBSItem* item;            ///< マージ結果のタスク（プロジェクト名・説明の競合はnullptr）
+    uint32_t fields;                ///< FieldEdit の対象フィールド（kWBSDiffFieldXxx の組み合わせ）
+};
@@ -0,0 +1,331 @@
+/*
+ * ============================================================================
+ * WBSProjectView.h - WBSアプリケーション 読み取り専用プロジェクトビュー
+ * ============================================================================
+ *
+ * このヘッダーファイルは、メモリマップしたバイナリ形式（.wbsb）のファイルを
+ * WBSItem ツリーに展開せず、その場で参照する読み取り専用ビューを提供します。
+ * レポートやダッシュボードなど、合計値の集計やツリーの閲覧だけを行う用途向けです。
+ *
+ * 【主な機能】
+ * - WBSProjectView: ファイルのオープンとプロジェクト全体へのアクセス
+ * - WBSTaskView: タスク1件分の軽量ハンドル（ビューへのポインタと索引のみ）
+ * - WBSUtf8Text: ファイル上のUTF-8文字列をコピーせずに参照
+ * - 子タスクの範囲for走査、部分木単位の工数集計
+ *
+ * 【設計原則】
+ * - オープンは定数時間: ヘッダーとセクション範囲だけを検証し、レコードは読まない
+ * - タスクごとのメモリ確保なし: 名前・工数・子範囲はマップされたレコードから直接読む
+ * - 使用メモリは実際にアクセスしたページ分のみ（OSが必要時に読み込む）
+ * - 不正なファイルでも範囲外を読まない: 索引・オフセットはアクセスのたびに検査し、
+ *   不正な値は空文字列・既定値・空の子範囲として扱う
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <cstdint>
+#include "WBSClasses.h"
+#include "WBSBinaryFormat.h"
+#include "WBSMappedFile.h"
+#include "WBSUtf8.h"
+
+class WBSProjectView;
+
+// ============================================================================
+// 文字列参照
+// ============================================================================
+
+/**
+ * @brief マップされたファイル上のUTF-8文字列への参照
+ *
+ * ビュー（WBSProjectView）の生存期間中のみ有効です。
+ */
+struct WBSUtf8Text {
+    const char* data;   ///< 文字列の先頭（終端文字なし）
+    size_t size;        ///< バイト数
+
+    bool empty() const { return size == 0; }
+
+    /**
+     * @brief wchar_t 文字列に変換（UI表示用）
+     */
+    std::wstring ToWide() const {
+        std::wstring result;
+        result.reserve(size);
+        AppendWide(result, data, data + size);
+        return result;
+    }
+};
+
+// ============================================================================
+// タスクビュー
+// ============================================================================
+
+/**
+ * @brief タスク1件分の読み取り専用ハンドル
+ *
+ * 値渡しで扱う軽量オブジェクトです。フィールドはアクセスのたびに
+ * マップされたレコードから読み取ります。
+ */
+class WBSTaskView {
+public:
+    class ChildIterator;
+    class ChildRange;
+
+    WBSTaskView(const WBSProjectView& view, uint32_t index) : view_(&view), index_(index) {}
+
+    /**
+     * @brief タスクの索引（行きがけ順、ルートは0）
+     */
+    uint32_t Index() const { return index_; }
+
+    // 文字列フィールド（UTF-8のまま参照）
+    WBSUtf8Text Id() const;
+    WBSUtf8Text TaskName() const;
+    WBSUtf8Text Description() const;
+    WBSUtf8Text AssignedTo() const;
+
+    // 数値フィールド
+    TaskStatus Status() const;
+    TaskPriority Priority() const;
+    int Level() const { return Record().level; }
+    double EstimatedHours() const { return Record().estimatedHours; }
+    double ActualHours() const { return Record().actualHours; }
+    WBSDateTime StartDate() const { return UnpackDateTime(Record().startDate); }
+    WBSDateTime EndDate() const { return UnpackDateTime(Record().endDate); }
+
+    /**
+     * @brief タスクの進捗率を計算（WBSItem::GetProgressPercentage() と同じ規則）
+     */
+    double GetProgressPercentage() const {
+        double estimated = EstimatedHours();
+        if (estimated == 0.0) return 0.0;
+        return (ActualHours() / estimated) * 100.0;
+    }
+
+    // 階層構造
+    bool HasParent() const;
+    WBSTaskView Parent() const;
+    uint32_t ChildCount() const { return Record().childCount; }
+    uint32_t SubtreeEnd() const;
+    ChildRange Children() const;
+
+    /**
+     * @brief 部分木（自身を含む）の見積もり工数合計
+     *
+     * 部分木はレコード配列上の連続範囲のため、ポインタを辿らずに線形に集計します。
+     */
+    double SubtreeEstimatedHours() const;
+
+    /**
+     * @brief 部分木（自身を含む）の実績工数合計
+     */
+    double SubtreeActualHours() const;
+
+private:
+    const WBSBinaryTaskRecord& Record() const;
+    WBSUtf8Text String(uint32_t stringIndex) const;
+
+    const WBSProjectView* view_;    ///< 参照元のビュー
+    uint32_t index_;                ///< タスクの索引
+};
+
+/**
+ * @brief 子タスクを順に辿るイテレータ
+ *
+ * 次の兄弟は現在の子の部分木終端（subtreeEnd）の位置にあります。
+ */
+class WBSTaskView::ChildIterator {
+public:
+    ChildIterator(const WBSProjectView& view, uint32_t index) : view_(&view), index_(index) {}
+
+    WBSTaskView operator*() const { return WBSTaskView(*view_, index_); }
+    ChildIterator& operator++() {
+        index_ = WBSTaskView(*view_, index_).SubtreeEnd();
+        return *this;
+    }
+    bool operator!=(const ChildIterator& other) const { return index_ < other.index_; }
+
+private:
+    const WBSProjectView* view_;
+    uint32_t index_;
+};
+
+/**
+ * @brief 子タスクの範囲（範囲for文用）
+ */
+class WBSTaskView::ChildRange {
+public:
+    ChildRange(const WBSProjectView& view, uint32_t first, uint32_t last)
+        : view_(&view), first_(first), last_(last) {}
+
+    ChildIterator begin() const { return ChildIterator(*view_, first_); }
+    ChildIterator end() const { return ChildIterator(*view_, last_); }
+
+private:
+    const WBSProjectView* view_;
+    uint32_t first_;    ///< 最初の子の索引
+    uint32_t last_;     ///< 親の部分木終端
+};
+
+// ============================================================================
+// プロジェクトビュー
+// ============================================================================
+
+/**
+ * @brief メモリマップした .wbsb ファイルの読み取り専用ビュー
+ *
+ * コピー不可。ビューから取得した WBSTaskView・WBSUtf8Text は
+ * ビューの生存期間中のみ有効です。
+ *
+ * @code
+ * WBSProjectView view(L"project.wbsb");
+ * if (view.IsOpen()) {
+ *     double total = view.Root().SubtreeEstimatedHours();
+ *     for (WBSTaskView child : view.Root().Children()) { ... }
+ * }
+ * @endcode
+ */
+class WBSProjectView {
+public:
+    /**
+     * @brief ファイルを開いてビューを作成
+     * @param path .wbsb ファイルのパス
+     *
+     * ヘッダーとセクション範囲の検証のみを行うため、タスク数に関係なく定数時間です。
+     */
+    explicit WBSProjectView(const std::wstring& path) : file_(path, false), records_(nullptr), valid_(false) {
+        valid_ = file_.IsOpen() && ValidateBinaryHeader(file_.Data(), file_.Size(), header_);
+        if (valid_) {
+            records_ = reinterpret_cast<const WBSBinaryTaskRecord*>(file_.Data() + header_.taskOffset);
+        }
+    }
+
+    WBSProjectView(const WBSProjectView&) = delete;
+    WBSProjectView& operator=(const WBSProjectView&) = delete;
+
+    /**
+     * @brief ファイルを開けて、形式が正しい場合true
+     */
+    bool IsOpen() const { return valid_; }
+
+    /**
+     * @brief タスク数（ルートを含む）
+     */
+    uint32_t TaskCount() const { return valid_ ? header_.taskCount : 0; }
+
+    /**
+     * @brief ルートタスク（IsOpen() の場合のみ有効）
+     */
+    WBSTaskView Root() const { return WBSTaskView(*this, 0); }
+
+    /**
+     * @brief 索引を指定してタスクを取得
+     * @param index タスクの索引（TaskCount() 未満）
+     */
+    WBSTaskView Task(uint32_t index) const { return WBSTaskView(*this, index); }
+
+    WBSUtf8Text ProjectName() const { return String(header_.projectNameString); }
+    WBSUtf8Text Description() const { return String(header_.descriptionString); }
+
+    /**
+     * @brief 全タスクの見積もり工数合計
+     */
+    double TotalEstimatedHours() const { return valid_ ? Root().SubtreeEstimatedHours() : 0.0; }
+
+    /**
+     * @brief 全タスクの実績工数合計
+     */
+    double TotalActualHours() const { return valid_ ? Root().SubtreeActualHours() : 0.0; }
+
+private:
+    friend class WBSTaskView;
+
+    /**
+     * @brief 文字列表の参照を取得（範囲外の場合は空文字列）
+     */
+    WBSUtf8Text String(uint32_t index) const {
+        WBSUtf8Text text = { "", 0 };
+        if (valid_) {
+            GetBinaryString(file_.Data(), header_, index, text.data, text.size);
+        }
+        return text;
+    }
+
+    WBSMappedFile file_;                        ///< マップされたファイル
+    WBSBinaryHeader header_;                    ///< 検証済みヘッダー
+    const WBSBinaryTaskRecord* records_;        ///< レコード配列の先頭
+    bool valid_;                                ///< 形式検証結果
+};
+
+// ============================================================================
+// WBSTaskView の実装（WBSProjectView の定義が必要なもの）
+// ============================================================================
+
+inline const WBSBinaryTaskRecord& WBSTaskView::Record() const {
+    return view_->records_[index_];
+}
+
+inline WBSUtf8Text WBSTaskView::String(uint32_t stringIndex) const {
+    return view_->String(stringIndex);
+}
+
+inline WBSUtf8Text WBSTaskView::Id() const { return String(Record().idString); }
+inline WBSUtf8Text WBSTaskView::TaskName() const { return String(Record().nameString); }
+inline WBSUtf8Text WBSTaskView::Description() const { return String(Record().descriptionString); }
+inline WBSUtf8Text WBSTaskView::AssignedTo() const { return String(Record().assignedToString); }
+
+inline TaskStatus WBSTaskView::Status() const {
+    uint8_t value = Record().status;
+    return value <= static_cast<uint8_t>(TaskStatus::CANCELLED) ? static_cast<TaskStatus>(value) : TaskStatus::NOT_STARTED;
+}
+
+inline TaskPriority WBSTaskView::Priority() const {
+    uint8_t value = Record().priority;
+    return value <= static_cast<uint8_t>(TaskPriority::URGENT) ? static_cast<TaskPriority>(value) : TaskPriority::MEDIUM;
+}
+
+inline bool WBSTaskView::HasParent() const {
+    return Record().parentIndex < index_;
+}
+
+inline WBSTaskView WBSTaskView::Parent() const {
+    // 親は必ず自身より前にある（不正な値の場合はルートを返す）
+    uint32_t parent = Record().parentIndex;
+    return WBSTaskView(*view_, parent < index_ ? parent : 0);
+}
+
+inline uint32_t WBSTaskView::SubtreeEnd() const {
+    // 走査が必ず前進し、配列の外に出ないように補正
+    uint32_t end = Record().subtreeEnd;
+    uint32_t count = view_->header_.taskCount;
+    if (end <= index_ || end > count) {
+        return index_ + 1;
+    }
+    return end;
+}
+
+inline WBSTaskView::ChildRange WBSTaskView::Children() const {
+    return ChildRange(*view_, index_ + 1, SubtreeEnd());
+}
+
+inline double WBSTaskView::SubtreeEstimatedHours() const {
+    double total = 0.0;
+    for (uint32_t i = index_, end = SubtreeEnd(); i < end; ++i) {
+        total += view_->records_[i].estimatedHours;
+    }
+    return total;
+}
+
+inline double WBSTaskView::SubtreeActualHours() const {
+    double total = 0.0;
+    for (uint32_t i = index_, end = SubtreeEnd(); i < end; ++i) {
+        total += view_->records_[i].actualHours;
+    }
+    return total;
+}
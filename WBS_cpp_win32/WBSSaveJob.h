@@ -0,0 +1,82 @@
+/*
+ * ============================================================================
+ * WBSSaveJob.h - WBSアプリケーション 保存ジョブ定義
+ * ============================================================================
+ *
+ * このヘッダーファイルは、プロジェクトの保存を「UIスレッドでの取り込み」と
+ * 「ワーカースレッドでの書き込み」に分けて実行するためのジョブ構造体と、
+ * 完了通知用のウィンドウメッセージを定義します。
+ *
+ * 【保存の3段階】（WBS_Journal_Functions.cpp）
+ * 1. BeginProjectSave()  : UIスレッド。プロジェクトの複製または未保存レコードを取り込む
+ * 2. RunProjectSave()    : 任意のスレッド。ジョブの内容だけを使ってファイルへ書き込む
+ * 3. FinishProjectSave() : UIスレッド。結果をジャーナルの状態へ反映する
+ *
+ * 【設計原則】
+ * - ワーカースレッドはジョブ以外の状態（g_currentProject 等）に一切触れない
+ * - 取り込み後のプロジェクトはUIスレッドから自由に編集できる
+ * - 完了は WM_WBS_SAVE_COMPLETED でUIスレッドへ通知する
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "WBSClasses.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// ============================================================================
+// 完了通知
+// ============================================================================
+
+/**
+ * @brief バックグラウンド保存の完了通知メッセージ
+ *
+ * ワーカースレッドが書き込みを終えると、保存を開始したウィンドウへ
+ * PostMessage() されます（wParam はジョブの通し番号、lParam は未使用）。
+ * 回収済みのジョブの通知は、通し番号が一致しないため無視されます。
+ */
+#ifdef _WIN32
+const UINT WM_WBS_SAVE_COMPLETED = WM_APP + 1;
+#endif
+
+/**
+ * @brief バックグラウンド保存の状態
+ */
+enum class WBSSaveStatus {
+    Pending,        ///< 実行中（またはまとめられた次の保存を開始済み）
+    Succeeded,      ///< 保存に成功
+    Failed          ///< 保存に失敗
+};
+
+// ============================================================================
+// 保存ジョブ
+// ============================================================================
+
+/**
+ * @brief 1回分の保存処理の入力と結果
+ *
+ * snapshot が nullptr の場合はジャーナルへの追記のみを行います。
+ * バックグラウンド保存では snapshot はジョブが所有する複製（ownedSnapshot）を指し、
+ * 元のプロジェクトとは独立しています。
+ */
+struct WBSSaveJob {
+    // 入力（BeginProjectSave() が設定）
+    std::wstring filePath;                  ///< 保存先のパス
+    const WBSProject* snapshot = nullptr;   ///< 全体保存するプロジェクト（追記のみならnullptr）
+    std::unique_ptr<WBSProject> ownedSnapshot; ///< バックグラウンド保存用のプロジェクトの複製
+    std::string journalRecords;             ///< ジャーナルへ追記するレコード
+
+    // 結果（RunProjectSave() が設定）
+    bool succeeded = false;                 ///< 保存（スナップショットまたは追記）に成功
+    bool journalCreated = false;            ///< 全体保存後の空ジャーナルを作成できた
+    uint64_t snapshotSize = 0;              ///< 書き込んだスナップショットのバイト数
+};
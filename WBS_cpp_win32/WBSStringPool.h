@@ -0,0 +1,251 @@
+/*
+ * ============================================================================
+ * WBSStringPool.h - WBSアプリケーション 文字列インターンプール
+ * ============================================================================
+ *
+ * このヘッダーファイルは、担当者名のように少数の値が多数のタスクで繰り返される
+ * 文字列を1か所に集約し、タスクからは小さな整数IDで参照するためのプールと、
+ * そのIDを保持する値型を提供します。
+ *
+ * 【主な機能】
+ * - WBSStringPool: 文字列とIDを相互に引けるインターンプール
+ *   （プロジェクトごとに1つ。WBSArena::Strings() から取得）
+ * - WBSInternedString: プール内の文字列を指す値型（WBSItem::assignedTo）
+ *
+ * 【設計原則】
+ * - 同じプール内では同じ内容の文字列は常に同じIDになるため、等価比較と
+ *   集計（グループ化）は整数演算
+ * - 各文字列のハッシュは登録時に計算して保持し、部分木ハッシュは内容から求めた
+ *   値を使う（プールが異なっても同じ内容なら同じハッシュ）
+ * - 別のプロジェクトの値の代入（複製・マージ）は代入先のプールへ登録し直す
+ *   （WBSColdText と同じく、プールの寿命は代入先のプロジェクトに従う）
+ * - 登録済みの文字列は移動・解放されないため、参照は読み取り側の排他なしで行える
+ * - 登録は並列読み込みに備えて排他制御付き
+ *
+ * @note 登録した文字列はプール（プロジェクト）の破棄まで保持されます。タスク名や
+ *       説明のように値がほとんど重複しない文字列には使用しないでください。
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
+#include <string>
+#include <unordered_map>
+
+// ============================================================================
+// インターンプール
+// ============================================================================
+
+/**
+ * @brief 文字列を重複なく保持し、整数IDを割り当てるプール
+ *
+ * 文字列はチャンク（kChunkSize 個ずつ確保する配列）に格納され、登録後は
+ * 移動しません。ID 0 は常に空文字列です。
+ */
+class WBSStringPool {
+public:
+    typedef uint32_t Id;
+
+    static const Id kEmptyId = 0;                           ///< 空文字列のID
+    static const size_t kChunkBits = 10;                    ///< チャンク内の位置のビット数
+    static const size_t kChunkSize = size_t(1) << kChunkBits; ///< チャンクあたりの文字列数
+    static const size_t kMaxChunks = 4096;                  ///< チャンク数の上限（約400万件）
+
+    WBSStringPool() : count_(1) {
+        for (auto& chunk : chunks_) {
+            chunk = nullptr;
+        }
+        chunks_[0] = new Entry[kChunkSize]; // ID 0（空文字列）を含む最初のチャンク
+        chunks_[0][0].hash = HashBytes(std::string());
+    }
+
+    WBSStringPool(const WBSStringPool&) = delete;
+    WBSStringPool& operator=(const WBSStringPool&) = delete;
+
+    ~WBSStringPool() {
+        for (auto chunk : chunks_) {
+            delete[] chunk;
+        }
+    }
+
+    /**
+     * @brief 文字列を登録してIDを取得
+     * @param text 登録する文字列
+     * @return text と同じ内容の文字列のID（登録済みなら既存のID）
+     *
+     * 上限を超えて登録しようとした場合は std::bad_alloc を送出します。
+     */
+    Id Intern(const std::string& text) {
+        if (text.empty()) {
+            return kEmptyId;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = index_.find(&text);
+        if (found != index_.end()) {
+            return found->second;
+        }
+
+        size_t chunkIndex = count_ >> kChunkBits;
+        if (chunkIndex >= kMaxChunks) {
+            throw std::bad_alloc();
+        }
+        if (!chunks_[chunkIndex]) {
+            chunks_[chunkIndex] = new Entry[kChunkSize];
+        }
+        Entry& slot = chunks_[chunkIndex][count_ & (kChunkSize - 1)];
+        slot.text = text;
+        slot.hash = HashBytes(text);
+        Id id = static_cast<Id>(count_++);
+        index_.emplace(&slot.text, id);
+        return id;
+    }
+
+    /**
+     * @brief 別のプールの文字列をこのプールへ登録
+     * @param source 登録元のプール
+     * @param id source 内のID
+     * @return このプール内のID
+     */
+    Id CopyFrom(const WBSStringPool& source, Id id) {
+        return id == kEmptyId ? kEmptyId : Intern(source.Get(id));
+    }
+
+    /**
+     * @brief IDに対応する文字列を取得
+     * @param id Intern() が返したID
+     *
+     * 登録済みの文字列は変更されないため、排他なしで参照できます。
+     */
+    const std::string& Get(Id id) const {
+        return chunks_[id >> kChunkBits][id & (kChunkSize - 1)].text;
+    }
+
+    /**
+     * @brief IDに対応する文字列のハッシュ（登録時に計算済み。内容だけで決まる）
+     */
+    uint64_t Hash(Id id) const {
+        return chunks_[id >> kChunkBits][id & (kChunkSize - 1)].hash;
+    }
+
+    /**
+     * @brief 登録済みの文字列数（空文字列を含む）
+     */
+    size_t Count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    struct Entry {
+        std::string text;           ///< 文字列
+        uint64_t hash = 0;          ///< 文字列のハッシュ（FNV-1a 64ビット）
+    };
+
+    struct TextHash {
+        size_t operator()(const std::string* text) const { return std::hash<std::string>()(*text); }
+    };
+    struct TextEqual {
+        bool operator()(const std::string* a, const std::string* b) const { return *a == *b; }
+    };
+
+    static uint64_t HashBytes(const std::string& text) {
+        uint64_t hash = 0xCBF29CE484222325ULL;
+        for (char c : text) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    std::mutex mutex_;                                                  ///< 登録の排他制御
+    Entry* chunks_[kMaxChunks];                                         ///< 文字列のチャンク
+    size_t count_;                                                      ///< 登録済みの文字列数
+    std::unordered_map<const std::string*, Id, TextHash, TextEqual> index_;  ///< 文字列からIDへの索引
+};
+
+// ============================================================================
+// インターン済み文字列
+// ============================================================================
+
+/**
+ * @brief WBSStringPool に登録された文字列を指す値型
+ *
+ * 構築時に指定したプール（通常はプロジェクトのアリーナのプール）に結び付けられ、
+ * std::string（UTF-8）の代入はそのプールへの登録になります。str() / c_str() で
+ * 内容を参照します。同じプールの値どうしの比較はIDで行います。
+ *
+ * 別のプールの値を代入した場合は、自身のプールへ登録し直します。
+ */
+class WBSInternedString {
+public:
+    explicit WBSInternedString(WBSStringPool& pool) : pool_(&pool), id_(WBSStringPool::kEmptyId) {}
+    WBSInternedString(const WBSInternedString& other) = default;
+
+    WBSInternedString& operator=(const WBSInternedString& other) {
+        id_ = (pool_ == other.pool_) ? other.id_ : pool_->CopyFrom(*other.pool_, other.id_);
+        return *this;
+    }
+
+    WBSInternedString& operator=(const std::string& text) {
+        id_ = pool_->Intern(text);
+        return *this;
+    }
+
+    WBSInternedString& operator=(const char* text) {
+        return *this = std::string(text);
+    }
+
+    /**
+     * @brief 文字列の内容を取得
+     */
+    const std::string& str() const { return pool_->Get(id_); }
+
+    /**
+     * @brief NUL終端のUTF-8文字列を取得
+     */
+    const char* c_str() const { return str().c_str(); }
+
+    /**
+     * @brief 空文字列か判定
+     */
+    bool empty() const { return id_ == WBSStringPool::kEmptyId; }
+
+    /**
+     * @brief プール内のID（同じプール内での集計のキーに使用）
+     */
+    WBSStringPool::Id Id() const { return id_; }
+
+    /**
+     * @brief 文字列のハッシュ（部分木ハッシュに使用。プールによらず内容で決まる）
+     */
+    uint64_t Hash() const { return pool_->Hash(id_); }
+
+    /**
+     * @brief 結び付けられたプール
+     */
+    WBSStringPool& Pool() const { return *pool_; }
+
+    /**
+     * @brief 内容の比較（同じプールならIDのみ、異なるプールならハッシュと内容で比較）
+     */
+    bool operator==(const WBSInternedString& other) const {
+        if (pool_ == other.pool_) {
+            return id_ == other.id_;
+        }
+        return Hash() == other.Hash() && str() == other.str();
+    }
+
+    bool operator!=(const WBSInternedString& other) const { return !(*this == other); }
+
+private:
+    WBSStringPool* pool_;    ///< 文字列の登録先（タスクの確保元アリーナと同じ寿命）
+    WBSStringPool::Id id_;   ///< プール内のID
+};
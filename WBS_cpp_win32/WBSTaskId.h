@@ -0,0 +1,360 @@
+/*
+ * ============================================================================
+ * WBSTaskId.h - WBSアプリケーション 階層タスクID
+ * ============================================================================
+ *
+ * このヘッダーファイルは、"1.2.10" のような階層IDを文字列ではなく
+ * 番号（序数）の並びとして保持する値型を提供します。
+ *
+ * 【主な機能】
+ * - WBSTaskId: 番号の並びを32ビット整数の配列として保持する値型（WBSItem::id）
+ * - 比較: 番号ごとの数値比較（"1.2" < "1.10"）。等価比較・ハッシュは整数単位
+ * - 子のID: 親のIDに番号を1つ追加して構築（文字列の連結・数値の文字列化なし）
+ * - 文字列との変換: ファイル・画面への出力時にのみ行う（Assign() / AppendTo()）
+ *
+ * 【設計原則】
+ * - 6段までのIDはオブジェクト内のバッファに格納（ヒープ確保なし。sizeof は32バイト）
+ * - 既存の領域に収まる限り、代入・子のIDの構築で再確保しない
+ *   （部分木のIDの振り直しはタスクごとのメモリ確保なしで行える）
+ * - 番号どおりでないID（"A-1"、"01"、"1..2" 等。ファイルから読み込んだもの）は
+ *   同じ領域にバイト列として保持し、出力時は元の文字列をそのまま再現する
+ * - 同じ文字列からは常に同じ表現になるため、等価比較は表現の比較で行える
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+
+// ============================================================================
+// 階層タスクID
+// ============================================================================
+
+/**
+ * @brief 階層ID（番号の並び）
+ *
+ * "1.2.3" は番号 {1, 2, 3} として保持します。各番号は先頭に0のない10進数
+ * （"0" を含む）で、32ビットに収まるものです。これに当てはまらない文字列は
+ * 「文字列のID」としてバイト列のまま保持します。空文字列は段数0の番号のIDです。
+ *
+ * 並び順は、番号のIDどうしは番号ごとの数値比較（短い方が先）、文字列のIDどうしは
+ * バイト列の比較で、番号のIDは文字列のIDより前になります。
+ */
+class WBSTaskId {
+public:
+    static const size_t kInlineWords = 6;                   ///< オブジェクト内に格納できる語数（番号の段数）
+
+    WBSTaskId() : length_(0), capacity_(kInlineWords), storage_() {}
+
+    /**
+     * @brief 文字列から構築（Assign() を参照）
+     */
+    explicit WBSTaskId(const std::string& text) : WBSTaskId() {
+        Assign(text);
+    }
+
+    WBSTaskId(const WBSTaskId& other) : WBSTaskId() {
+        *this = other;
+    }
+
+    WBSTaskId(WBSTaskId&& other) noexcept : WBSTaskId() {
+        Swap(other);
+    }
+
+    ~WBSTaskId() {
+        if (IsHeap()) {
+            delete[] storage_.heap;
+        }
+    }
+
+    WBSTaskId& operator=(const WBSTaskId& other) {
+        if (this != &other) {
+            size_t words = other.WordCount();
+            Reserve(words);
+            std::memcpy(Words(), other.Words(), words * sizeof(uint32_t));
+            length_ = other.length_;
+        }
+        return *this;
+    }
+
+    WBSTaskId& operator=(WBSTaskId&& other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    void Swap(WBSTaskId& other) noexcept {
+        std::swap(length_, other.length_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(storage_, other.storage_);
+    }
+
+    /**
+     * @brief 番号の並びから構築
+     */
+    static WBSTaskId FromOrdinals(const uint32_t* ordinals, size_t count) {
+        WBSTaskId id;
+        id.Reserve(count);
+        if (count > 0) {
+            std::memcpy(id.Words(), ordinals, count * sizeof(uint32_t));
+        }
+        id.length_ = static_cast<uint32_t>(count);
+        return id;
+    }
+
+    /**
+     * @brief 文字列を解析して設定（番号どおりでなければ文字列のIDとして保持）
+     */
+    void Assign(const char* text, size_t size) {
+        if (!AssignOrdinals(text, size)) {
+            AssignText(text, size);
+        }
+    }
+
+    void Assign(const std::string& text) {
+        Assign(text.data(), text.size());
+    }
+
+    /**
+     * @brief 空のIDにする（領域は保持）
+     */
+    void Clear() { length_ = 0; }
+
+    /**
+     * @brief 親のIDに番号を1つ追加したIDを設定（"1.2" と 3 → "1.2.3"）
+     *
+     * 親が番号のIDの場合は番号の複写だけで、領域に収まる限りメモリを確保しません。
+     * 親が文字列のIDの場合は従来どおり「親のID + "." + 番号」の文字列になります。
+     */
+    void AssignChild(const WBSTaskId& parent, uint32_t ordinal) {
+        if (parent.IsNumeric() && parent.length_ > 0) {
+            size_t count = parent.length_;
+            if (this != &parent) {
+                Reserve(count + 1);
+                std::memcpy(Words(), parent.Words(), count * sizeof(uint32_t));
+            } else {
+                Reserve(count + 1, true);
+            }
+            Words()[count] = ordinal;
+            length_ = static_cast<uint32_t>(count + 1);
+            return;
+        }
+        std::string text = parent.ToString();
+        text += '.';
+        text += std::to_string(ordinal);
+        Assign(text);
+    }
+
+    /**
+     * @brief 番号のIDか（文字列のIDでなければtrue）
+     */
+    bool IsNumeric() const { return (length_ & kTextFlag) == 0; }
+
+    /**
+     * @brief 空のIDか
+     */
+    bool IsEmpty() const { return (length_ & ~kTextFlag) == 0; }
+
+    /**
+     * @brief 番号の段数（文字列のIDは0）
+     */
+    size_t Depth() const { return IsNumeric() ? length_ : 0; }
+
+    /**
+     * @brief 番号（0 <= index < Depth()）
+     */
+    uint32_t Ordinal(size_t index) const { return Words()[index]; }
+
+    /**
+     * @brief prefix が先頭の番号の並びと一致するか（"1.2" は "1.2.3" の先頭）
+     */
+    bool StartsWith(const WBSTaskId& prefix) const {
+        return IsNumeric() && prefix.IsNumeric() && prefix.length_ <= length_ &&
+               std::memcmp(Words(), prefix.Words(), prefix.length_ * sizeof(uint32_t)) == 0;
+    }
+
+    /**
+     * @brief 文字列に変換して末尾に追加
+     */
+    void AppendTo(std::string& out) const {
+        if (!IsNumeric()) {
+            out.append(reinterpret_cast<const char*>(Words()), length_ & ~kTextFlag);
+            return;
+        }
+        char digits[10];
+        for (uint32_t i = 0; i < length_; ++i) {
+            if (i > 0) {
+                out += '.';
+            }
+            uint32_t value = Words()[i];
+            size_t count = 0;
+            do {
+                digits[count++] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            } while (value != 0);
+            while (count > 0) {
+                out += digits[--count];
+            }
+        }
+    }
+
+    /**
+     * @brief 文字列に変換
+     */
+    std::string ToString() const {
+        std::string text;
+        AppendTo(text);
+        return text;
+    }
+
+    /**
+     * @brief ハッシュ値（語単位で混合。表現が同じなら同じ値）
+     */
+    uint64_t Hash() const {
+        uint64_t hash = 0x9E3779B97F4A7C15ULL ^ length_;
+        const uint32_t* words = Words();
+        for (size_t i = 0, count = WordCount(); i < count; ++i) {
+            hash = (hash ^ words[i]) * 0x100000001B3ULL;
+            hash ^= hash >> 29;
+        }
+        hash *= 0xFF51AFD7ED558CCDULL;
+        return hash ^ (hash >> 32);
+    }
+
+    bool operator==(const WBSTaskId& other) const {
+        return length_ == other.length_ &&
+               std::memcmp(Words(), other.Words(), WordCount() * sizeof(uint32_t)) == 0;
+    }
+    bool operator!=(const WBSTaskId& other) const { return !(*this == other); }
+
+    bool operator<(const WBSTaskId& other) const { return Compare(other) < 0; }
+    bool operator<=(const WBSTaskId& other) const { return Compare(other) <= 0; }
+    bool operator>(const WBSTaskId& other) const { return Compare(other) > 0; }
+    bool operator>=(const WBSTaskId& other) const { return Compare(other) >= 0; }
+
+    /**
+     * @brief 並び順の比較（負: this が先、0: 等しい、正: this が後）
+     */
+    int Compare(const WBSTaskId& other) const {
+        if (IsNumeric() != other.IsNumeric()) {
+            return IsNumeric() ? -1 : 1;
+        }
+        if (IsNumeric()) {
+            uint32_t count = length_ < other.length_ ? length_ : other.length_;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (Words()[i] != other.Words()[i]) {
+                    return Words()[i] < other.Words()[i] ? -1 : 1;
+                }
+            }
+        } else {
+            uint32_t count = (length_ < other.length_ ? length_ : other.length_) & ~kTextFlag;
+            int result = std::memcmp(Words(), other.Words(), count);
+            if (result != 0) {
+                return result;
+            }
+        }
+        return length_ == other.length_ ? 0 : (length_ < other.length_ ? -1 : 1);
+    }
+
+private:
+    static const uint32_t kTextFlag = 0x80000000u;          ///< length_ の文字列のIDを表すビット
+
+    union Storage {
+        uint32_t local[kInlineWords];                       ///< オブジェクト内の領域
+        uint32_t* heap;                                     ///< capacity_ > kInlineWords の場合の領域
+    };
+
+    bool IsHeap() const { return capacity_ > kInlineWords; }
+    uint32_t* Words() { return IsHeap() ? storage_.heap : storage_.local; }
+    const uint32_t* Words() const { return IsHeap() ? storage_.heap : storage_.local; }
+
+    /**
+     * @brief 使用中の語数（文字列のIDは末尾の語の余りを0で埋めている）
+     */
+    size_t WordCount() const {
+        return IsNumeric() ? length_ : ((length_ & ~kTextFlag) + 3) / 4;
+    }
+
+    /**
+     * @brief 領域を words 語以上にする（preserve が false の場合は内容を保たない）
+     */
+    void Reserve(size_t words, bool preserve = false) {
+        if (words <= capacity_) {
+            return;
+        }
+        size_t capacity = capacity_ * 2 > words ? capacity_ * 2 : words;
+        uint32_t* heap = new uint32_t[capacity];
+        if (preserve) {
+            std::memcpy(heap, Words(), WordCount() * sizeof(uint32_t));
+        }
+        if (IsHeap()) {
+            delete[] storage_.heap;
+        }
+        storage_.heap = heap;
+        capacity_ = static_cast<uint32_t>(capacity);
+    }
+
+    /**
+     * @brief 番号どおりの文字列なら番号の並びとして設定
+     * @return 番号どおりでない場合false（内容は不定）
+     */
+    bool AssignOrdinals(const char* text, size_t size) {
+        if (size == 0) {
+            length_ = 0;
+            return true;
+        }
+        size_t count = 1;
+        for (size_t i = 0; i < size; ++i) {
+            count += text[i] == '.' ? 1 : 0;
+        }
+        Reserve(count);
+        uint32_t* words = Words();
+        size_t pos = 0;
+        for (size_t index = 0; index < count; ++index) {
+            if (index > 0) {
+                ++pos; // '.'
+            }
+            size_t begin = pos;
+            uint64_t value = 0;
+            for (; pos < size && text[pos] >= '0' && text[pos] <= '9' && pos - begin < 10; ++pos) {
+                value = value * 10 + static_cast<uint64_t>(text[pos] - '0');
+            }
+            size_t digits = pos - begin;
+            if (digits == 0 || (digits > 1 && text[begin] == '0') || value > 0xFFFFFFFFu ||
+                (pos < size && text[pos] != '.')) {
+                return false;
+            }
+            words[index] = static_cast<uint32_t>(value);
+        }
+        length_ = static_cast<uint32_t>(count);
+        return true;
+    }
+
+    void AssignText(const char* text, size_t size) {
+        size_t words = (size + 3) / 4;
+        Reserve(words);
+        if (words > 0) {
+            Words()[words - 1] = 0; // 比較・ハッシュのため余りを0で埋める
+            std::memcpy(Words(), text, size);
+        }
+        length_ = static_cast<uint32_t>(size) | kTextFlag;
+    }
+
+    uint32_t length_;       ///< 番号の段数、または文字列のバイト数 | kTextFlag
+    uint32_t capacity_;     ///< 領域の語数（kInlineWords の場合はオブジェクト内）
+    Storage storage_;       ///< 番号の並び、または文字列のバイト列
+};
+
+/**
+ * @brief unordered_map / unordered_set 用のハッシュ関数オブジェクト
+ */
+struct WBSTaskIdHash {
+    size_t operator()(const WBSTaskId& id) const {
+        return static_cast<size_t>(id.Hash());
+    }
+};
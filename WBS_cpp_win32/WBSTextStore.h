@@ -0,0 +1,349 @@
+/*
+ * ============================================================================
+ * WBSTextStore.h - WBSアプリケーション コールドテキストの格納先
+ * ============================================================================
+ *
+ * このヘッダーファイルは、タスクの説明のように大きく、ツリーの走査や集計では
+ * 参照されないテキスト（コールドテキスト）をタスク本体の外にまとめて保持する
+ * ストアと、タスクからそのテキストを指す値型を提供します。
+ *
+ * 【主な機能】
+ * - WBSTextStore: テキストを追加順に格納し、整数IDで参照するストア
+ *   （プロジェクトごとに1つ。WBSArena::Texts() から取得）
+ * - 符号化されたままの登録: 読み込み処理はファイル上の表現（XMLエスケープ・
+ *   JSONエスケープ）をコピーするだけで登録し、復元は最初の参照時に行う
+ * - WBSColdText: ストア内のテキストを指す値型（WBSItem::description）
+ *
+ * 【設計原則】
+ * - タスク本体にはストアへのポインタとIDだけを置き、文字列の本体・ヘッダーが
+ *   ツリーの走査でキャッシュに載らないようにする
+ * - 登録済みのテキストは移動・変更されない（編集は新しいテキストの追加）ため、
+ *   復元済みのテキストの参照は排他なしで行える
+ * - 各テキストのハッシュは登録時に復元後の内容から計算して保持し、部分木ハッシュの
+ *   計算でテキストを復元しない（同じ内容は読み込み元・符号化によらず同じハッシュ）
+ * - 登録・復元は並列読み込みとUIスレッドからの参照に備えて排他制御付き
+ *
+ * @note 編集前のテキストはストアの破棄（プロジェクトを閉じたとき）まで残ります。
+ *       読み込み・複製で作られるストアには現在のテキストだけが登録されます。
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <string>
+
+// ============================================================================
+// テキストストア
+// ============================================================================
+
+/**
+ * @brief コールドテキストを追加順に保持し、整数IDを割り当てるストア
+ *
+ * テキストはチャンク（kChunkSize 件ずつ確保する配列）に格納され、登録後は
+ * 移動しません。ID 0 は常に空文字列です。同じ内容のテキストも重複排除せず
+ * 別のIDで登録します（説明はほとんど重複しないため）。
+ */
+class WBSTextStore {
+public:
+    typedef uint32_t Id;
+
+    /**
+     * @brief 符号化されたテキストの復元関数
+     * @param out 復元したUTF-8の追加先
+     * @param first 符号化されたテキストの先頭
+     * @param last 符号化されたテキストの終端
+     */
+    typedef void (*Decoder)(std::string& out, const char* first, const char* last);
+
+    static const Id kEmptyId = 0;                           ///< 空文字列のID
+    static const size_t kChunkBits = 12;                    ///< チャンク内の位置のビット数
+    static const size_t kChunkSize = size_t(1) << kChunkBits; ///< チャンクあたりのテキスト数
+    static const size_t kMaxChunks = 4096;                  ///< チャンク数の上限（約1600万件）
+
+    WBSTextStore() : count_(1), decodedCount_(0) {
+        for (auto& chunk : chunks_) {
+            chunk = nullptr;
+        }
+        chunks_[0] = new Entry[kChunkSize]; // ID 0（空文字列）を含む最初のチャンク
+    }
+
+    WBSTextStore(const WBSTextStore&) = delete;
+    WBSTextStore& operator=(const WBSTextStore&) = delete;
+
+    ~WBSTextStore() {
+        for (auto chunk : chunks_) {
+            delete[] chunk;
+        }
+    }
+
+    /**
+     * @brief 復元済みのテキストを登録
+     * @param first UTF-8テキストの先頭
+     * @param last UTF-8テキストの終端
+     * @return 登録したテキストのID（空の場合は kEmptyId）
+     */
+    Id Add(const char* first, const char* last) {
+        return AddEntry(first, last, nullptr, HashBytes(kHashSeed, first, last));
+    }
+
+    /**
+     * @brief 復元済みのテキストを登録
+     */
+    Id Add(const std::string& text) {
+        return Add(text.data(), text.data() + text.size());
+    }
+
+    /**
+     * @brief 符号化されたままのテキストを登録（復元は最初の Get() で行う）
+     * @param first 符号化されたテキストの先頭
+     * @param last 符号化されたテキストの終端
+     * @param decoder 復元関数（nullptr の場合は Add() と同じ）
+     * @return 登録したテキストのID（空の場合は kEmptyId）
+     *
+     * ハッシュは Add() と同じく復元後の内容から計算します。そのため登録時に
+     * スレッドごとの作業バッファへ一度復元しますが、復元結果は保持せず、
+     * テキストの確保と格納は最初の Get() まで行いません。
+     */
+    Id AddEncoded(const char* first, const char* last, Decoder decoder) {
+        if (!decoder) {
+            return Add(first, last);
+        }
+        static thread_local std::string scratch;
+        scratch.clear();
+        decoder(scratch, first, last);
+        if (scratch.empty()) {
+            return kEmptyId;
+        }
+        const char* decoded = scratch.data();
+        return AddEntry(first, last, decoder, HashBytes(kHashSeed, decoded, decoded + scratch.size()));
+    }
+
+    /**
+     * @brief 別のストアのテキストを符号化の状態・ハッシュごと登録
+     * @param source 複製元のストア
+     * @param id 複製元でのID
+     * @return このストアでのID
+     */
+    Id CopyFrom(const WBSTextStore& source, Id id) {
+        if (id == kEmptyId) {
+            return kEmptyId;
+        }
+        const Entry& entry = source.EntryAt(id);
+        std::string text;
+        Decoder decoder;
+        {
+            // 複製元の復元と競合しないよう、復元状態とテキストを組で読み取る
+            std::lock_guard<std::mutex> lock(source.mutex_);
+            decoder = entry.decoder.load(std::memory_order_relaxed);
+            text = entry.text;
+        }
+        return AddEntry(text.data(), text.data() + text.size(), decoder, entry.hash);
+    }
+
+    /**
+     * @brief IDに対応するテキストを取得（符号化されたテキストはここで復元）
+     * @param id Add() / AddEncoded() が返したID
+     *
+     * 復元済みのテキストは変更されないため、排他なしで参照できます。
+     */
+    const std::string& Get(Id id) const {
+        Entry& entry = EntryAt(id);
+        if (entry.decoder.load(std::memory_order_acquire)) {
+            Decode(entry);
+        }
+        return entry.text;
+    }
+
+    /**
+     * @brief テキストのハッシュを取得（復元は行わない）
+     */
+    uint64_t Hash(Id id) const {
+        return EntryAt(id).hash;
+    }
+
+    /**
+     * @brief 登録済みのテキスト数（空文字列を含む）
+     */
+    size_t Count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+    /**
+     * @brief 登録後に復元したテキスト数
+     */
+    size_t DecodedCount() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return decodedCount_;
+    }
+
+private:
+    static const uint64_t kHashSeed = 0xCBF29CE484222325ULL;        ///< FNV-1a 64ビットの初期値
+
+    struct Entry {
+        std::string text;                           ///< テキスト（復元前は符号化されたバイト列）
+        std::atomic<Decoder> decoder;               ///< 復元関数（復元済みなら nullptr）
+        uint64_t hash;                              ///< 復元後の内容のハッシュ
+
+        Entry() : decoder(nullptr), hash(kHashSeed) {}
+    };
+
+    static uint64_t HashBytes(uint64_t hash, const char* first, const char* last) {
+        for (const char* p = first; p < last; ++p) {
+            hash ^= static_cast<unsigned char>(*p);
+            hash *= 0x100000001B3ULL;
+        }
+        return hash;
+    }
+
+    Entry& EntryAt(Id id) const {
+        return chunks_[id >> kChunkBits][id & (kChunkSize - 1)];
+    }
+
+    Id AddEntry(const char* first, const char* last, Decoder decoder, uint64_t hash) {
+        if (first == last) {
+            return kEmptyId;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t chunkIndex = count_ >> kChunkBits;
+        if (chunkIndex >= kMaxChunks) {
+            throw std::bad_alloc();
+        }
+        if (!chunks_[chunkIndex]) {
+            chunks_[chunkIndex] = new Entry[kChunkSize];
+        }
+        Entry& entry = chunks_[chunkIndex][count_ & (kChunkSize - 1)];
+        entry.text.assign(first, last);
+        entry.hash = hash;
+        entry.decoder.store(decoder, std::memory_order_release);
+        return static_cast<Id>(count_++);
+    }
+
+    void Decode(Entry& entry) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Decoder decoder = entry.decoder.load(std::memory_order_relaxed);
+        if (!decoder) {
+            return; // 他のスレッドが復元済み
+        }
+        std::string decoded;
+        decoded.reserve(entry.text.size());
+        decoder(decoded, entry.text.data(), entry.text.data() + entry.text.size());
+        entry.text.swap(decoded);
+        entry.decoder.store(nullptr, std::memory_order_release);
+        ++decodedCount_;
+    }
+
+    mutable std::mutex mutex_;                      ///< 登録・復元の排他制御
+    Entry* chunks_[kMaxChunks];                     ///< テキストのチャンク
+    size_t count_;                                  ///< 登録済みのテキスト数
+    mutable size_t decodedCount_;                   ///< 復元したテキスト数
+};
+
+// ============================================================================
+// コールドテキスト
+// ============================================================================
+
+/**
+ * @brief WBSTextStore に登録されたテキストを指す値型
+ *
+ * 構築時に指定したストア（通常はプロジェクトのアリーナのストア）に結び付けられ、
+ * std::string（UTF-8）の代入はそのストアへの登録になります。str() / c_str() で
+ * 内容を参照します（符号化されたままのテキストはここで復元）。
+ *
+ * 別のストアのテキストを代入した場合は、自身のストアへ複製します
+ * （プロジェクト間の複製・マージでも、ストアの寿命は代入先のプロジェクトに従う）。
+ * コピー構築はストアごと共有するため、編集前の値の一時的な保存に使えます。
+ */
+class WBSColdText {
+public:
+    explicit WBSColdText(WBSTextStore& store) : store_(&store), id_(WBSTextStore::kEmptyId) {}
+    WBSColdText(const WBSColdText& other) = default;
+
+    WBSColdText& operator=(const WBSColdText& other) {
+        id_ = (store_ == other.store_) ? other.id_ : store_->CopyFrom(*other.store_, other.id_);
+        return *this;
+    }
+
+    WBSColdText& operator=(const std::string& text) {
+        id_ = store_->Add(text);
+        return *this;
+    }
+
+    WBSColdText& operator=(const char* text) {
+        return *this = std::string(text);
+    }
+
+    /**
+     * @brief UTF-8テキストの範囲を代入
+     */
+    void Assign(const char* first, const char* last) {
+        id_ = store_->Add(first, last);
+    }
+
+    /**
+     * @brief 符号化されたままのテキストを代入（復元は最初の str() で行う）
+     * @param first 符号化されたテキストの先頭
+     * @param last 符号化されたテキストの終端
+     * @param decoder 復元関数
+     */
+    void AssignEncoded(const char* first, const char* last, WBSTextStore::Decoder decoder) {
+        id_ = store_->AddEncoded(first, last, decoder);
+    }
+
+    /**
+     * @brief 空文字列にする
+     */
+    void clear() { id_ = WBSTextStore::kEmptyId; }
+
+    /**
+     * @brief テキストの内容を取得
+     */
+    const std::string& str() const { return store_->Get(id_); }
+
+    /**
+     * @brief NUL終端のUTF-8文字列を取得
+     */
+    const char* c_str() const { return str().c_str(); }
+
+    /**
+     * @brief 空文字列か判定（復元は行わない）
+     */
+    bool empty() const { return id_ == WBSTextStore::kEmptyId; }
+
+    /**
+     * @brief テキストのハッシュ（部分木ハッシュに使用。復元は行わない）
+     */
+    uint64_t Hash() const { return store_->Hash(id_); }
+
+    /**
+     * @brief 結び付けられたストア
+     */
+    WBSTextStore& Store() const { return *store_; }
+
+    /**
+     * @brief 内容の比較（同じストアの同じIDなら復元せずに一致とする）
+     */
+    bool operator==(const WBSColdText& other) const {
+        if (store_ == other.store_ && id_ == other.id_) {
+            return true;
+        }
+        if (empty() || other.empty()) {
+            return empty() && other.empty();
+        }
+        return str() == other.str();
+    }
+
+    bool operator!=(const WBSColdText& other) const { return !(*this == other); }
+
+private:
+    WBSTextStore* store_;   ///< テキストの格納先（タスクの確保元アリーナと同じ寿命）
+    WBSTextStore::Id id_;   ///< ストア内のID
+};
@@ -0,0 +1,551 @@
+/*
+ * ============================================================================
+ * WBSUtf8.h - WBSアプリケーション UTF-8変換ユーティリティ
+ * ============================================================================
+ *
+ * このヘッダーファイルは、UTF-8バイト列と wchar_t 文字列との相互変換を、
+ * ロケールや std::codecvt を介さずに行う関数群を提供します。
+ * タスクのテキストは内部でもUTF-8で保持するため、wchar_t への変換は
+ * Win32 UIとの受け渡し（および wchar_t 入力の読み込み）でのみ行います。
+ *
+ * 【主な機能】
+ * - wchar_t 範囲からUTF-8バイト列への追加変換
+ * - XMLエスケープを同時に行うUTF-8変換・UTF-8バイト列のXMLエスケープ（ファイル保存用）
+ * - エスケープ不要な文字の連続部分をSIMDでまとめて判定するXMLエスケープ
+ * - UTF-8バイト列の妥当性検証（ASCII部分はSIMDで16バイト単位に判定）
+ * - 不正なバイト列を U+FFFD に置き換えたUTF-8バイト列の追加（検証前の入力用）
+ * - UTF-8バイト列から wchar_t 文字列への追加変換（UI表示用）
+ *
+ * 【設計原則】
+ * - 呼び出し側のバッファへ直接追加し、一時文字列を作らない
+ * - ASCIIの連続部分・エスケープ不要な連続部分は一括コピー
+ * - wchar_t が16ビット（Windows, UTF-16）でも32ビット（UTF-32）でも動作
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#include <emmintrin.h>
+#define WBS_UTF8_USE_SSE2
+#endif
+
+// ============================================================================
+// 文字検索関数群（SSE2による一括判定）
+// ============================================================================
+
+/**
+ * @brief 0でないビットマスクの最下位ビット位置を取得
+ */
+inline unsigned LowestSetBit(unsigned mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * @brief XMLエスケープ対象の1文字に対応するエンティティを取得
+ * @return エンティティ文字列（対象外の文字は nullptr）
+ */
+inline const char* XmlEntityFor(wchar_t c) {
+    switch (c) {
+        case L'&':  return "&amp;";
+        case L'<':  return "&lt;";
+        case L'>':  return "&gt;";
+        case L'"':  return "&quot;";
+        case L'\'': return "&apos;";
+        default:    return nullptr;
+    }
+}
+
+/**
+ * @brief XMLエスケープが不要な文字の連続数を取得
+ *
+ * @param data 判定対象の文字列
+ * @param size 文字数
+ * @return 最初のエスケープ対象文字（& < > " '）の位置（無ければ size）
+ *
+ * SSE2が利用できる環境では16バイト（wchar_t 8文字または4文字）単位で判定します。
+ */
+inline size_t XmlPlainPrefixLength(const wchar_t* data, size_t size) {
+    size_t i = 0;
+#ifdef WBS_UTF8_USE_SSE2
+    const size_t perChunk = 16 / sizeof(wchar_t);
+    if (sizeof(wchar_t) == 2) {
+        const __m128i amp  = _mm_set1_epi16('&');
+        const __m128i lt   = _mm_set1_epi16('<');
+        const __m128i gt   = _mm_set1_epi16('>');
+        const __m128i quot = _mm_set1_epi16('"');
+        const __m128i apos = _mm_set1_epi16('\'');
+        for (; i + perChunk <= size; i += perChunk) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hit = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi16(chunk, amp), _mm_cmpeq_epi16(chunk, lt)),
+                _mm_or_si128(_mm_cmpeq_epi16(chunk, gt),
+                             _mm_or_si128(_mm_cmpeq_epi16(chunk, quot), _mm_cmpeq_epi16(chunk, apos))));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+            if (mask != 0) {
+                return i + LowestSetBit(mask) / sizeof(wchar_t);
+            }
+        }
+    } else {
+        const __m128i amp  = _mm_set1_epi32('&');
+        const __m128i lt   = _mm_set1_epi32('<');
+        const __m128i gt   = _mm_set1_epi32('>');
+        const __m128i quot = _mm_set1_epi32('"');
+        const __m128i apos = _mm_set1_epi32('\'');
+        for (; i + perChunk <= size; i += perChunk) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hit = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(chunk, amp), _mm_cmpeq_epi32(chunk, lt)),
+                _mm_or_si128(_mm_cmpeq_epi32(chunk, gt),
+                             _mm_or_si128(_mm_cmpeq_epi32(chunk, quot), _mm_cmpeq_epi32(chunk, apos))));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+            if (mask != 0) {
+                return i + LowestSetBit(mask) / sizeof(wchar_t);
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (XmlEntityFor(data[i])) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief UTF-8バイト列のうちXMLエスケープが不要なバイトの連続数を取得
+ *
+ * @param data 判定対象のバイト列
+ * @param size バイト数
+ * @return 最初のエスケープ対象文字（& < > " '）の位置（無ければ size）
+ *
+ * エスケープ対象はすべてASCIIのため、マルチバイト文字の途中で一致することはありません。
+ */
+inline size_t XmlPlainPrefixLength(const char* data, size_t size) {
+    size_t i = 0;
+#ifdef WBS_UTF8_USE_SSE2
+    const __m128i amp  = _mm_set1_epi8('&');
+    const __m128i lt   = _mm_set1_epi8('<');
+    const __m128i gt   = _mm_set1_epi8('>');
+    const __m128i quot = _mm_set1_epi8('"');
+    const __m128i apos = _mm_set1_epi8('\'');
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hit = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, amp), _mm_cmpeq_epi8(chunk, lt)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, gt),
+                         _mm_or_si128(_mm_cmpeq_epi8(chunk, quot), _mm_cmpeq_epi8(chunk, apos))));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return i + LowestSetBit(mask);
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        if (XmlEntityFor(static_cast<wchar_t>(static_cast<unsigned char>(data[i])))) {
+            break;
+        }
+    }
+    return i;
+}
+
+/**
+ * @brief wchar_t 範囲から指定文字を検索
+ * @return 最初に一致した位置（見つからなければ last）
+ *
+ * SSE2が利用できる環境では16バイト単位で比較します。
+ */
+inline const wchar_t* FindWideChar(const wchar_t* first, const wchar_t* last, wchar_t c) {
+#ifdef WBS_UTF8_USE_SSE2
+    const size_t perChunk = 16 / sizeof(wchar_t);
+    const __m128i target = (sizeof(wchar_t) == 2) ? _mm_set1_epi16(static_cast<short>(c))
+                                                  : _mm_set1_epi32(static_cast<int>(c));
+    for (; static_cast<size_t>(last - first) >= perChunk; first += perChunk) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first));
+        __m128i hit = (sizeof(wchar_t) == 2) ? _mm_cmpeq_epi16(chunk, target)
+                                             : _mm_cmpeq_epi32(chunk, target);
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hit));
+        if (mask != 0) {
+            return first + LowestSetBit(mask) / sizeof(wchar_t);
+        }
+    }
+#endif
+    while (first < last && *first != c) {
+        ++first;
+    }
+    return first;
+}
+
+// ============================================================================
+// UTF-8エンコード関数群
+// ============================================================================
+
+/**
+ * @brief 1コードポイントをUTF-8で書き込む
+ * @param dst 書き込み先（4バイト以上の空きが必要）
+ * @param codePoint Unicodeコードポイント
+ * @return 書き込んだバイト数
+ */
+inline size_t EncodeCodePointUtf8(char* dst, char32_t codePoint) {
+    if (codePoint < 0x80) {
+        dst[0] = static_cast<char>(codePoint);
+        return 1;
+    } else if (codePoint < 0x800) {
+        dst[0] = static_cast<char>(0xC0 | (codePoint >> 6));
+        dst[1] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 2;
+    } else if (codePoint < 0x10000) {
+        dst[0] = static_cast<char>(0xE0 | (codePoint >> 12));
+        dst[1] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 3;
+    } else {
+        dst[0] = static_cast<char>(0xF0 | (codePoint >> 18));
+        dst[1] = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        dst[2] = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        dst[3] = static_cast<char>(0x80 | (codePoint & 0x3F));
+        return 4;
+    }
+}
+
+/**
+ * @brief 1コードポイントをUTF-8でバッファへ追加
+ * @param out 追加先のバイト列
+ * @param codePoint Unicodeコードポイント
+ */
+inline void AppendCodePointUtf8(std::string& out, char32_t codePoint) {
+    char bytes[4];
+    out.append(bytes, EncodeCodePointUtf8(bytes, codePoint));
+}
+
+/**
+ * @brief wchar_t 範囲から次のコードポイントを取り出す
+ *
+ * @param p 読み取り位置（読み取った分だけ進む）
+ * @param last 範囲の終端
+ * @return コードポイント（不正なサロゲートは U+FFFD）
+ */
+inline char32_t NextCodePoint(const wchar_t*& p, const wchar_t* last) {
+    char32_t c = static_cast<char32_t>(*p++);
+    if (sizeof(wchar_t) == 2 && c >= 0xD800 && c <= 0xDFFF) {
+        // UTF-16 サロゲートペアの結合
+        if (c <= 0xDBFF && p < last && *p >= 0xDC00 && *p <= 0xDFFF) {
+            char32_t low = static_cast<char32_t>(*p++);
+            return 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+        }
+        return 0xFFFD;
+    }
+    return c;
+}
+
+/**
+ * @brief wchar_t 範囲をUTF-8に変換して追加
+ * @param out 追加先のバイト列
+ * @param first 範囲の先頭
+ * @param last 範囲の終端
+ *
+ * 最大長（UTF-16は1単位あたり3バイト、UTF-32は4バイト）を一度に確保して
+ * 直接書き込み、最後に実際の長さへ縮めます。
+ */
+inline void AppendUtf8(std::string& out, const wchar_t* first, const wchar_t* last) {
+    if (first == last) {
+        return;
+    }
+    const size_t maxBytesPerUnit = (sizeof(wchar_t) == 2) ? 3 : 4;
+    size_t offset = out.size();
+    out.resize(offset + (last - first) * maxBytesPerUnit);
+    char* begin = &out[0];
+    char* dst = begin + offset;
+    while (first < last) {
+        // ASCIIはそのまま1バイトで書き込む
+        unsigned c = static_cast<unsigned>(*first);
+        if (c < 0x80) {
+            *dst++ = static_cast<char>(c);
+            ++first;
+            continue;
+        }
+        dst += EncodeCodePointUtf8(dst, NextCodePoint(first, last));
+    }
+    out.resize(dst - begin);
+}
+
+/**
+ * @brief 文字列全体をUTF-8に変換
+ * @param text 変換元の文字列
+ * @return UTF-8バイト列
+ */
+inline std::string WideToUtf8(const std::wstring& text) {
+    std::string result;
+    result.reserve(text.size());
+    AppendUtf8(result, text.data(), text.data() + text.size());
+    return result;
+}
+
+/**
+ * @brief XMLエスケープを行いながらUTF-8に変換して追加
+ *
+ * @param out 追加先のバイト列
+ * @param first 範囲の先頭
+ * @param last 範囲の終端
+ *
+ * XMLの5種類の特殊文字（& < > " '）をエンティティに置き換えます。
+ * エスケープ不要な連続部分は XmlPlainPrefixLength() でまとめて判定し、
+ * AppendUtf8() で一括変換します（エスケープ対象はASCIIのため、
+ * サロゲートペアが連続部分の境界で分断されることはありません）。
+ */
+inline void AppendXmlEscapedUtf8(std::string& out, const wchar_t* first, const wchar_t* last) {
+    while (first < last) {
+        size_t run = XmlPlainPrefixLength(first, last - first);
+        AppendUtf8(out, first, first + run);
+        first += run;
+        if (first == last) {
+            break;
+        }
+        out += XmlEntityFor(*first);
+        ++first;
+    }
+}
+
+/**
+ * @brief UTF-8バイト列をXMLエスケープして追加
+ *
+ * @param out 追加先のバイト列
+ * @param first 範囲の先頭（正しいUTF-8であること）
+ * @param last 範囲の終端
+ *
+ * AppendXmlEscapedUtf8() のUTF-8入力版です。エスケープ不要な連続部分は
+ * 変換せずにそのままコピーします。
+ */
+inline void AppendXmlEscapedUtf8(std::string& out, const char* first, const char* last) {
+    while (first < last) {
+        size_t run = XmlPlainPrefixLength(first, last - first);
+        out.append(first, run);
+        first += run;
+        if (first == last) {
+            break;
+        }
+        out += XmlEntityFor(static_cast<wchar_t>(*first));
+        ++first;
+    }
+}
+
+// ============================================================================
+// UTF-8デコード関数群
+// ============================================================================
+
+/**
+ * @brief 先頭から連続するASCIIバイト数を取得
+ *
+ * @param data 判定対象のバイト列
+ * @param size バイト数
+ * @return 最初の非ASCIIバイトの位置（全てASCIIなら size）
+ *
+ * SSE2が利用できる環境では16バイト単位、それ以外では8バイト単位で判定します。
+ */
+inline size_t AsciiPrefixLength(const char* data, size_t size) {
+    size_t i = 0;
+#ifdef WBS_UTF8_USE_SSE2
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break; // 最上位ビットが立ったバイトを含む
+        }
+    }
+#endif
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if (word & 0x8080808080808080ULL) {
+            break;
+        }
+    }
+    while (i < size && !(static_cast<unsigned char>(data[i]) & 0x80)) {
+        ++i;
+    }
+    return i;
+}
+
+/**
+ * @brief UTF-8の1文字（2～4バイト列）を解析
+ *
+ * @param p 先頭バイトの位置（非ASCII）
+ * @param last 範囲の終端
+ * @param codePoint 解析したコードポイントの格納先
+ * @return 消費したバイト数、不正なバイト列の場合は0
+ *
+ * 冗長表現、サロゲート領域、U+10FFFF を超える値は不正として扱います。
+ */
+inline size_t DecodeUtf8Sequence(const unsigned char* p, const unsigned char* last, char32_t& codePoint) {
+    unsigned lead = p[0];
+    size_t length;
+    char32_t minimum;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2; codePoint = lead & 0x1F; minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3; codePoint = lead & 0x0F; minimum = 0x800;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4; codePoint = lead & 0x07; minimum = 0x10000;
+    } else {
+        return 0;
+    }
+
+    if (static_cast<size_t>(last - p) < length) {
+        return 0;
+    }
+    for (size_t i = 1; i < length; ++i) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        codePoint = (codePoint << 6) | (p[i] & 0x3F);
+    }
+
+    if (codePoint < minimum || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) {
+        return 0;
+    }
+    return length;
+}
+
+/**
+ * @brief バイト列が正しいUTF-8か検証
+ *
+ * @param data 検証対象のバイト列
+ * @param size バイト数
+ * @return 正しいUTF-8の場合true
+ *
+ * ASCIIの連続部分は AsciiPrefixLength() でまとめて読み飛ばすため、
+ * 英数字主体のXMLではメモリ帯域に近い速度で検証できます。
+ */
+inline bool IsValidUtf8(const char* data, size_t size) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(data);
+    const unsigned char* last = p + size;
+
+    while (p < last) {
+        p += AsciiPrefixLength(reinterpret_cast<const char*>(p), last - p);
+        if (p >= last) {
+            break;
+        }
+        char32_t codePoint;
+        size_t length = DecodeUtf8Sequence(p, last, codePoint);
+        if (length == 0) {
+            return false;
+        }
+        p += length;
+    }
+    return true;
+}
+
+/**
+ * @brief UTF-8バイト列を追加（不正なバイト列は U+FFFD に置き換え）
+ *
+ * @param out 追加先のバイト列
+ * @param first 範囲の先頭
+ * @param last 範囲の終端
+ *
+ * 事前に検証されていない入力（バイナリ形式の文字列表・ジャーナル）から
+ * 内部文字列を作る場合に使用します。AppendWide() と同じ規則で置き換えるため、
+ * 結果を wchar_t に変換すると AppendWide() の結果と一致します。
+ */
+inline void AppendSanitizedUtf8(std::string& out, const char* first, const char* last) {
+    while (first < last) {
+        // 正しい連続部分（ASCII・マルチバイト文字）はまとめてコピー
+        const char* run = first;
+        while (run < last) {
+            run += AsciiPrefixLength(run, last - run);
+            if (run >= last) {
+                break;
+            }
+            char32_t codePoint;
+            size_t length = DecodeUtf8Sequence(reinterpret_cast<const unsigned char*>(run),
+                                               reinterpret_cast<const unsigned char*>(last), codePoint);
+            if (length == 0) {
+                break;
+            }
+            run += length;
+        }
+        out.append(first, run);
+        if (run == last) {
+            break;
+        }
+        out += "\xEF\xBF\xBD"; // U+FFFD
+        first = run + 1;
+    }
+}
+
+/**
+ * @brief 1コードポイントを wchar_t 文字列へ追加
+ *
+ * wchar_t が16ビットの環境では補助平面の文字をサロゲートペアで出力します。
+ */
+inline void AppendCodePointWide(std::wstring& out, char32_t codePoint) {
+    if (sizeof(wchar_t) == 2 && codePoint >= 0x10000) {
+        codePoint -= 0x10000;
+        out += static_cast<wchar_t>(0xD800 + (codePoint >> 10));
+        out += static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF));
+    } else {
+        out += static_cast<wchar_t>(codePoint);
+    }
+}
+
+/**
+ * @brief UTF-8バイト列を wchar_t に変換して追加
+ *
+ * @param out 追加先の文字列
+ * @param first 範囲の先頭
+ * @param last 範囲の終端
+ *
+ * wchar_t が16ビットの環境では補助平面の文字をサロゲートペアで出力します。
+ * 不正なバイト列は U+FFFD に置き換えます。
+ */
+inline void AppendWide(std::wstring& out, const char* first, const char* last) {
+    while (first < last) {
+        // ASCIIの連続部分は一括で追加
+        size_t ascii = AsciiPrefixLength(first, last - first);
+        if (ascii > 0) {
+            size_t offset = out.size();
+            out.resize(offset + ascii);
+            wchar_t* dst = &out[offset];
+            for (size_t i = 0; i < ascii; ++i) {
+                dst[i] = static_cast<wchar_t>(first[i]);
+            }
+            first += ascii;
+            continue;
+        }
+
+        char32_t codePoint;
+        size_t length = DecodeUtf8Sequence(reinterpret_cast<const unsigned char*>(first),
+                                           reinterpret_cast<const unsigned char*>(last), codePoint);
+        if (length == 0) {
+            codePoint = 0xFFFD;
+            length = 1;
+        }
+        first += length;
+        AppendCodePointWide(out, codePoint);
+    }
+}
+
+/**
+ * @brief UTF-8バイト列全体を wchar_t 文字列に変換
+ * @param text 変換元のUTF-8バイト列
+ * @return 変換後の文字列
+ */
+inline std::wstring Utf8ToWide(const std::string& text) {
+    std::wstring result;
+    result.reserve(text.size());
+    AppendWide(result, text.data(), text.data() + text.size());
+    return result;
+}
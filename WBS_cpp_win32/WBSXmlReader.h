@@ -0,0 +1,619 @@
+/*
+ * ============================================================================
+ * WBSXmlReader.h - WBSアプリケーション 前方向専用XMLプルパーサー
+ * ============================================================================
+ *
+ * このヘッダーファイルは、WBSプロジェクトXMLを先頭から一度だけ走査して
+ * トークン（開始タグ・終了タグ・テキスト）を順に取り出すプルパーサーを提供します。
+ *
+ * 【主な機能】
+ * - 中間部分文字列を作らないトークン化（ポインタ範囲のみを保持）
+ * - 要素の深さに依存しない正しい入れ子処理（</Task> の最初の一致に頼らない）
+ * - エンティティ・数値文字参照を復元しながら呼び出し側のバッファへ直接テキストを追加
+ * - XML宣言、コメント、CDATA、空要素タグ（<Tag/>）のスキップ／展開
+ * - wchar_t 文字列とUTF-8バイト列（メモリマップしたファイル等）の両方に対応
+ *
+ * 【設計原則】
+ * - 線形時間: 入力の各文字は高々定数回しか読まない
+ * - ゼロコピー: タグ名とテキストは入力バッファ内の範囲として返す
+ * - UTF-8入力ではテキスト内容のみを wchar_t に変換（タグ名は変換しない）
+ * - 例外を投げない: 構文エラーは Token::Error として呼び出し側へ返す
+ *
+ * 【使用例】
+ * @code
+ * WBSXmlReader reader(xml.data(), xml.data() + xml.size());
+ * for (auto token = reader.Next(); token != WBSXmlToken::End; token = reader.Next()) {
+ *     if (token == WBSXmlToken::StartElement && reader.NameIs("Task")) { ... }
+ * }
+ * @endcode
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include "WBSUtf8.h"
+
+// ============================================================================
+// XMLプルパーサー
+// ============================================================================
+
+/**
+ * @brief Next() が返すトークンの種類
+ */
+enum class WBSXmlToken {
+    StartElement,   ///< 開始タグ（<Name> または <Name/>）
+    EndElement,     ///< 終了タグ（</Name>、空要素タグの場合は自動生成）
+    Text,           ///< 要素間の文字データ（空白のみの場合も含む）
+    End,            ///< 入力の終端
+    Error           ///< 構文エラー（閉じられていないタグ・コメント等）
+};
+
+/**
+ * @brief WBSプロジェクトXML用の前方向専用トークナイザー
+ *
+ * @tparam CharT 入力の文字型（wchar_t: 内部文字列、char: UTF-8バイト列）
+ *
+ * 入力バッファ（[begin, end) の範囲）を所有せずに参照します。
+ * 呼び出し側はパース中、入力バッファを生存させておく必要があります。
+ * UTF-8入力は事前に IsValidUtf8() で検証済みであることを前提とします。
+ */
+template <typename CharT>
+class WBSBasicXmlReader {
+public:
+    typedef WBSXmlToken Token;
+    typedef std::char_traits<CharT> Traits;
+
+    /**
+     * @brief コンストラクタ
+     * @param begin 入力バッファの先頭
+     * @param end 入力バッファの終端（最後の文字の次）
+     */
+    WBSBasicXmlReader(const CharT* begin, const CharT* end)
+        : begin_(begin), pos_(begin), end_(end),
+          nameBegin_(nullptr), nameLength_(0),
+          textBegin_(nullptr), textEnd_(nullptr),
+          rawText_(false), pendingEnd_(false), depth_(0) {}
+
+    /**
+     * @brief 次のトークンを読み取る
+     * @return 読み取ったトークンの種類
+     */
+    Token Next() {
+        // 空要素タグ <Name/> は開始・終了の2トークンとして返す
+        if (pendingEnd_) {
+            pendingEnd_ = false;
+            --depth_;
+            return Token::EndElement;
+        }
+
+        while (pos_ < end_) {
+            if (*pos_ != CharT('<')) {
+                // 文字データ: 次の '<' までを1トークンとする
+                textBegin_ = pos_;
+                pos_ = Find(pos_, CharT('<'));
+                textEnd_ = pos_;
+                rawText_ = false;
+                return Token::Text;
+            }
+
+            const CharT* p = pos_ + 1;
+            if (p >= end_) return Token::Error;
+
+            if (*p == CharT('?')) {
+                // XML宣言・処理命令: "?>" まで読み飛ばす
+                if (!SkipPast(p + 1, "?>", 2)) return Token::Error;
+                continue;
+            }
+
+            if (*p == CharT('!')) {
+                if (StartsWith(p, "!--", 3)) {
+                    // コメント: "-->" まで読み飛ばす
+                    if (!SkipPast(p + 3, "-->", 3)) return Token::Error;
+                    continue;
+                }
+                if (StartsWith(p, "![CDATA[", 8)) {
+                    // CDATA: エンティティ復元を行わない生テキストとして返す
+                    const CharT* dataBegin = p + 8;
+                    if (!SkipPast(dataBegin, "]]>", 3)) return Token::Error;
+                    textBegin_ = dataBegin;
+                    textEnd_ = pos_ - 3;
+                    rawText_ = true;
+                    return Token::Text;
+                }
+                // DOCTYPE 等: '>' まで読み飛ばす
+                const CharT* close = Find(p, CharT('>'));
+                if (close == end_) return Token::Error;
+                pos_ = close + 1;
+                continue;
+            }
+
+            if (*p == CharT('/')) {
+                // 終了タグ
+                ++p;
+                nameBegin_ = p;
+                p = ScanName(p);
+                nameLength_ = p - nameBegin_;
+                const CharT* close = Find(p, CharT('>'));
+                if (close == end_ || nameLength_ == 0) return Token::Error;
+                pos_ = close + 1;
+                --depth_;
+                return Token::EndElement;
+            }
+
+            // 開始タグ（属性は読み飛ばす）
+            nameBegin_ = p;
+            p = ScanName(p);
+            nameLength_ = p - nameBegin_;
+            const CharT* close = Find(p, CharT('>'));
+            if (close == end_ || nameLength_ == 0) return Token::Error;
+            pendingEnd_ = (close[-1] == CharT('/'));
+            pos_ = close + 1;
+            ++depth_;
+            return Token::StartElement;
+        }
+
+        return Token::End;
+    }
+
+    /**
+     * @brief 現在のタグ名が指定名と一致するか判定
+     * @param name 比較するタグ名（ASCII、NUL終端）
+     * @return 一致する場合true
+     */
+    bool NameIs(const char* name) const {
+        size_t length = strlen(name);
+        return length == nameLength_ && Matches(nameBegin_, name, length);
+    }
+
+    /**
+     * @brief 現在のタグ名の先頭を取得
+     */
+    const CharT* NameBegin() const { return nameBegin_; }
+
+    /**
+     * @brief 現在のタグ名の長さを取得
+     */
+    size_t NameLength() const { return nameLength_; }
+
+    /**
+     * @brief 現在のテキストトークンをエンティティ復元して追加
+     * @param out 追加先の文字列（クリアはしない）
+     *
+     * 部分文字列を作らず、入力範囲から直接 out へ書き込みます。
+     * 結果は内部文字列と同じUTF-8です（UTF-8入力は変換せずにコピー）。
+     */
+    void AppendText(std::string& out) const {
+        if (rawText_) {
+            AppendRun(out, textBegin_, textEnd_);
+        } else {
+            AppendUnescaped(out, textBegin_, textEnd_);
+        }
+    }
+
+    /**
+     * @brief 現在のテキストトークンをエスケープされたまま追加（UTF-8）
+     * @param out 追加先のバイト列（クリアはしない）
+     *
+     * 追加した内容を AppendUnescaped() で復元すると AppendText() と同じ結果になります
+     * （CDATA の内容はエスケープして追加）。復元を最初の参照まで遅らせる
+     * フィールド（WBSColdText::AssignEncoded()）の読み込みで使用します。
+     */
+    void AppendEscapedText(std::string& out) const {
+        if (rawText_) {
+            AppendXmlEscapedUtf8(out, textBegin_, textEnd_);
+        } else {
+            AppendRun(out, textBegin_, textEnd_);
+        }
+    }
+
+    /**
+     * @brief 現在の要素の内容を終了タグまで読み飛ばす
+     * @return 対応する終了タグに到達した場合true
+     *
+     * StartElement を受け取った直後に呼び出してください。
+     * タグ名の解析やテキストトークンの生成を行わず、'<' と '>' の位置だけで
+     * 要素の深さを追跡します（コメント・CDATA・処理命令は Next() で処理）。
+     * 並列解析の前段で部分木の境界を求める用途を想定した高速経路です。
+     */
+    bool SkipElement() {
+        int targetDepth = depth_ - 1;
+        if (pendingEnd_) {
+            // 空要素タグ <Name/> は終了トークンだけが残っている
+            pendingEnd_ = false;
+            --depth_;
+            return true;
+        }
+
+        enum { Outside, InStartTag, InEndTag } state = Outside;
+        const CharT* p = pos_;
+        while (true) {
+            p = FindAngleBracket(p, end_);
+            if (p >= end_) return false;
+
+            if (*p == CharT('<')) {
+                if (p + 1 >= end_) return false;
+                if (p[1] == CharT('!') || p[1] == CharT('?')) {
+                    // コメント・CDATA・処理命令は通常の読み取りで処理
+                    pos_ = p;
+                    Token token = Next();
+                    if (token == Token::End || token == Token::Error) return false;
+                    if (pendingEnd_) {
+                        pendingEnd_ = false;
+                        --depth_;
+                    }
+                    if (depth_ <= targetDepth) return true;
+                    p = pos_;
+                    state = Outside;
+                    continue;
+                }
+                state = (p[1] == CharT('/')) ? InEndTag : InStartTag;
+            } else if (state == InStartTag) {
+                // 開始タグの終わり（空要素タグは深さが変わらない）
+                if (p[-1] != CharT('/')) ++depth_;
+                state = Outside;
+            } else if (state == InEndTag) {
+                state = Outside;
+                if (--depth_ <= targetDepth) {
+                    pos_ = p + 1;
+                    return true;
+                }
+            }
+            ++p; // タグ外の '>' は文字データ
+        }
+    }
+
+    /**
+     * @brief 現在の要素の深さを取得（ルート要素の内側が1）
+     */
+    int Depth() const { return depth_; }
+
+    /**
+     * @brief 入力先頭からの現在位置（文字数）を取得
+     */
+    size_t Position() const { return pos_ - begin_; }
+
+    /**
+     * @brief 入力バッファを差し替えて読み取りを続ける
+     * @param begin 新しい入力バッファの先頭（続きのトークンの先頭）
+     * @param end 新しい入力バッファの終端
+     *
+     * Next() が End または Error を返した直後に、未読部分（Position() 以降）を
+     * 先頭に置いたバッファで呼び出します。要素の深さは引き継がれます。
+     * Next() は失敗したトークンの先頭から読み取り位置を動かさないため、
+     * 途中で切れたトークンも差し替え後に先頭から読み直されます。
+     */
+    void Rebind(const CharT* begin, const CharT* end) {
+        begin_ = begin;
+        pos_ = begin;
+        end_ = end;
+        nameBegin_ = nullptr;
+        nameLength_ = 0;
+        textBegin_ = nullptr;
+        textEnd_ = nullptr;
+    }
+
+    /**
+     * @brief XMLエンティティを復元しながら範囲を追加
+     *
+     * @param out 追加先の文字列
+     * @param first 範囲の先頭
+     * @param last 範囲の終端
+     *
+     * 左から右への1パスで &amp; &lt; &gt; &quot; &apos; と
+     * 数値文字参照（&#38; &#x26; 等）を復元します。
+     * '&' を含まない連続部分はまとめて出力し、未知のエンティティや
+     * 不正な数値文字参照はそのまま出力します。
+     * 出力先は std::string（UTF-8）と std::wstring のどちらでも構いません。
+     */
+    template <typename String>
+    static void AppendUnescaped(String& out, const CharT* first, const CharT* last) {
+        while (first < last) {
+            const CharT* amp = FindAmpersand(first, last);
+            AppendRun(out, first, amp);
+            if (amp == last) {
+                return;
+            }
+
+            // ';' は最長の参照（&#x10FFFF;）の範囲内だけを探す
+            const CharT* limit = (last - amp > kMaxReferenceLength) ? amp + kMaxReferenceLength : last;
+            const CharT* semi = Traits::find(amp + 1, limit - amp - 1, CharT(';'));
+            char32_t decoded = semi ? DecodeReference(amp + 1, semi) : 0;
+
+            if (decoded) {
+                AppendCodePoint(out, decoded);
+                first = semi + 1;
+            } else {
+                out += '&'; // 未知のエンティティは元の文字列を保持
+                first = amp + 1;
+            }
+        }
+    }
+
+private:
+    static const std::ptrdiff_t kMaxReferenceLength = 10;   ///< "&#x10FFFF;" の文字数
+
+    /**
+     * @brief '&' と ';' に挟まれた参照名を復元
+     * @return 復元したコードポイント（未知・不正な参照は0）
+     */
+    static char32_t DecodeReference(const CharT* first, const CharT* last) {
+        size_t length = last - first;
+        if (length >= 2 && first[0] == CharT('#')) {
+            // 数値文字参照: &#10進数; または &#x16進数;
+            const CharT* p = first + 1;
+            bool hex = (*p == CharT('x') || *p == CharT('X'));
+            if (hex) ++p;
+            if (p == last) return 0;
+
+            char32_t codePoint = 0;
+            for (; p < last; ++p) {
+                unsigned digit;
+                if (*p >= CharT('0') && *p <= CharT('9')) {
+                    digit = static_cast<unsigned>(*p - CharT('0'));
+                } else if (hex && *p >= CharT('a') && *p <= CharT('f')) {
+                    digit = static_cast<unsigned>(*p - CharT('a')) + 10;
+                } else if (hex && *p >= CharT('A') && *p <= CharT('F')) {
+                    digit = static_cast<unsigned>(*p - CharT('A')) + 10;
+                } else {
+                    return 0;
+                }
+                codePoint = codePoint * (hex ? 16 : 10) + digit;
+                if (codePoint > 0x10FFFF) return 0;
+            }
+            if (codePoint == 0 || (codePoint >= 0xD800 && codePoint <= 0xDFFF)) return 0;
+            return codePoint;
+        }
+
+        if (length == 2 && Matches(first, "lt", 2)) return U'<';
+        if (length == 2 && Matches(first, "gt", 2)) return U'>';
+        if (length == 3 && Matches(first, "amp", 3)) return U'&';
+        if (length == 4 && Matches(first, "quot", 4)) return U'"';
+        if (length == 4 && Matches(first, "apos", 4)) return U'\'';
+        return 0;
+    }
+
+    static const wchar_t* FindAmpersand(const wchar_t* first, const wchar_t* last) {
+        return FindWideChar(first, last, L'&');
+    }
+
+    static const char* FindAmpersand(const char* first, const char* last) {
+        const void* found = memchr(first, '&', last - first);
+        return found ? static_cast<const char*>(found) : last;
+    }
+
+    static void AppendRun(std::wstring& out, const wchar_t* first, const wchar_t* last) {
+        out.append(first, last);
+    }
+
+    static void AppendRun(std::wstring& out, const char* first, const char* last) {
+        AppendWide(out, first, last);
+    }
+
+    static void AppendRun(std::string& out, const wchar_t* first, const wchar_t* last) {
+        AppendUtf8(out, first, last);
+    }
+
+    static void AppendRun(std::string& out, const char* first, const char* last) {
+        out.append(first, last);
+    }
+
+    static void AppendCodePoint(std::wstring& out, char32_t codePoint) {
+        AppendCodePointWide(out, codePoint);
+    }
+
+    static void AppendCodePoint(std::string& out, char32_t codePoint) {
+        AppendCodePointUtf8(out, codePoint);
+    }
+
+    static bool Matches(const CharT* p, const char* ascii, size_t length) {
+        for (size_t i = 0; i < length; ++i) {
+            if (p[i] != CharT(ascii[i])) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 次の '<' または '>' の位置を取得（見つからなければ last）
+     *
+     * UTF-8入力でSSE2が利用できる環境では16バイト単位で判定します。
+     */
+    static const char* FindAngleBracket(const char* p, const char* last) {
+#ifdef WBS_UTF8_USE_SSE2
+        const __m128i open = _mm_set1_epi8('<');
+        const __m128i close = _mm_set1_epi8('>');
+        for (; p + 16 <= last; p += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+            unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, open), _mm_cmpeq_epi8(chunk, close))));
+            if (mask != 0) {
+                return p + LowestSetBit(mask);
+            }
+        }
+#endif
+        while (p < last && *p != '<' && *p != '>') {
+            ++p;
+        }
+        return p;
+    }
+
+    static const wchar_t* FindAngleBracket(const wchar_t* p, const wchar_t* last) {
+        while (p < last && *p != L'<' && *p != L'>') {
+            ++p;
+        }
+        return p;
+    }
+
+    const CharT* Find(const CharT* from, CharT c) const {
+        const CharT* found = Traits::find(from, end_ - from, c);
+        return found ? found : end_;
+    }
+
+    bool StartsWith(const CharT* p, const char* literal, size_t length) const {
+        return static_cast<size_t>(end_ - p) >= length && Matches(p, literal, length);
+    }
+
+    bool SkipPast(const CharT* from, const char* terminator, size_t length) {
+        for (const CharT* p = Find(from, CharT(terminator[0])); p < end_; p = Find(p + 1, CharT(terminator[0]))) {
+            if (StartsWith(p, terminator, length)) {
+                pos_ = p + length;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const CharT* ScanName(const CharT* p) const {
+        while (p < end_ && *p != CharT('>') && *p != CharT('/') && *p != CharT(' ') &&
+               *p != CharT('\t') && *p != CharT('\r') && *p != CharT('\n')) {
+            ++p;
+        }
+        return p;
+    }
+
+    const CharT* begin_;            ///< 入力バッファの先頭
+    const CharT* pos_;              ///< 現在の読み取り位置
+    const CharT* end_;              ///< 入力バッファの終端
+    const CharT* nameBegin_;        ///< 直前のタグ名の先頭
+    size_t nameLength_;             ///< 直前のタグ名の長さ
+    const CharT* textBegin_;        ///< 直前のテキストの先頭
+    const CharT* textEnd_;          ///< 直前のテキストの終端
+    bool rawText_;                  ///< CDATA（エンティティ復元不要）ならtrue
+    bool pendingEnd_;               ///< 空要素タグの終了トークンが保留中ならtrue
+    int depth_;                     ///< 現在の要素の深さ
+};
+
+typedef WBSBasicXmlReader<wchar_t> WBSXmlReader;        ///< wchar_t 文字列用リーダー
+typedef WBSBasicXmlReader<char> WBSUtf8XmlReader;       ///< UTF-8バイト列用リーダー
+
+/**
+ * @brief 逐次供給されるUTF-8バイト列用のXMLプルパーサー
+ *
+ * @tparam Source 入力の供給元。bool ReadBlock(std::string& out) で続きのバイト列を
+ *                out の末尾へ追加し、終端に達したらfalseを返す（WBSCompressedReader 等）
+ *
+ * 文書全体をメモリに置かずに、供給元から読み取ったブロックを WBSUtf8XmlReader で
+ * 解析します。解析範囲は常にバッファ内で最後の '<' の直前までとし、途中で
+ * 切れたタグを含めません。範囲を読み終えると読み取り済みの部分を捨てて
+ * 次のブロックを追加するため、バッファの大きさはブロック数個分に収まります。
+ *
+ * 各ブロックは追加した時点で IsValidUtf8() により検証します（先頭のBOMは読み飛ばす）。
+ * トークンが返すタグ名・テキストは、次に Next() を呼び出すまで有効です。
+ */
+template <typename Source>
+class WBSChunkedXmlReader {
+public:
+    typedef WBSXmlToken Token;
+
+    /**
+     * @param source 入力の供給元（パース中は生存させておく必要がある）
+     */
+    explicit WBSChunkedXmlReader(Source& source)
+        : source_(source), reader_(nullptr, nullptr),
+          consumed_(0), windowEnd_(0), validated_(0), started_(false), exhausted_(false), failed_(false) {}
+
+    /**
+     * @brief 次のトークンを読み取る（必要に応じて供給元から補充）
+     */
+    Token Next() {
+        while (true) {
+            Token token = failed_ ? Token::Error : reader_.Next();
+            if ((token != Token::End && token != Token::Error) || failed_ || !Refill()) {
+                return token;
+            }
+        }
+    }
+
+    bool NameIs(const char* name) const { return reader_.NameIs(name); }
+    const char* NameBegin() const { return reader_.NameBegin(); }
+    size_t NameLength() const { return reader_.NameLength(); }
+    void AppendText(std::string& out) const { reader_.AppendText(out); }
+    void AppendEscapedText(std::string& out) const { reader_.AppendEscapedText(out); }
+    int Depth() const { return reader_.Depth(); }
+
+    /**
+     * @brief 現在の要素の内容を終了タグまで読み飛ばす
+     * @return 対応する終了タグに到達した場合true
+     *
+     * 要素がブロックの境界をまたいでもよいよう、Next() を繰り返して深さを追跡します。
+     */
+    bool SkipElement() {
+        int targetDepth = reader_.Depth() - 1;
+        while (reader_.Depth() > targetDepth) {
+            Token token = Next();
+            if (token == Token::End || token == Token::Error) return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 文書先頭（BOMの直後）からの現在位置（バイト数）を取得
+     */
+    size_t Position() const { return consumed_ + reader_.Position(); }
+
+private:
+    /**
+     * @brief 読み取り済みの部分を捨て、解析範囲を次の '<' まで広げる
+     * @return 解析範囲が広がった場合true（供給元の終端、または不正なUTF-8の場合false）
+     */
+    bool Refill() {
+        size_t position = reader_.Position();
+        buffer_.erase(0, position);
+        consumed_ += position;
+        windowEnd_ -= position;
+        validated_ -= position;
+
+        size_t newEnd = windowEnd_;
+        while (true) {
+            size_t lastTag = buffer_.rfind('<');
+            if (lastTag != std::string::npos && lastTag > windowEnd_) {
+                newEnd = lastTag;
+                break;
+            }
+            if (exhausted_ || !source_.ReadBlock(buffer_)) {
+                exhausted_ = true;
+                newEnd = buffer_.size();
+                break;
+            }
+            if (!started_) {
+                // UTF-8 BOM の読み飛ばし
+                if (buffer_.size() < 3 && memcmp(buffer_.data(), "\xEF\xBB\xBF", buffer_.size()) == 0) {
+                    continue; // BOMか判定できるだけ読み込む
+                }
+                if (buffer_.compare(0, 3, "\xEF\xBB\xBF") == 0) {
+                    buffer_.erase(0, 3);
+                }
+                started_ = true;
+            }
+        }
+        if (newEnd == windowEnd_) {
+            return false; // これ以上の入力はない
+        }
+
+        // '<' は文字の境界のため、解析範囲の終端で分割して検証できる
+        if (!IsValidUtf8(buffer_.data() + validated_, newEnd - validated_)) {
+            failed_ = true;
+            return false;
+        }
+        validated_ = newEnd;
+        windowEnd_ = newEnd;
+        started_ = true;
+        reader_.Rebind(buffer_.data(), buffer_.data() + windowEnd_);
+        return true;
+    }
+
+    Source& source_;                ///< 入力の供給元
+    WBSUtf8XmlReader reader_;       ///< 解析範囲のリーダー
+    std::string buffer_;            ///< 未読のバイト列（先頭は読み取り中のトークン）
+    size_t consumed_;               ///< 捨てたバイト数（Position() の基準）
+    size_t windowEnd_;              ///< 解析範囲の終端（buffer_ 内の位置）
+    size_t validated_;              ///< UTF-8として検証済みの終端（buffer_ 内の位置）
+    bool started_;                  ///< BOMの判定を終えた
+    bool exhausted_;                ///< 供給元の終端に達した
+    bool failed_;                   ///< 不正なUTF-8を検出した
+};
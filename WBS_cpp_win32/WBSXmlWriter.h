@@ -0,0 +1,152 @@
+/*
+ * ============================================================================
+ * WBSXmlWriter.h - WBSアプリケーション ストリーミングXMLライター
+ * ============================================================================
+ *
+ * このヘッダーファイルは、WBSプロジェクトXMLを再利用可能なUTF-8バイトバッファへ
+ * 直接書き込み、一定量ごとに出力先（ファイル等）へ書き出すライターを提供します。
+ *
+ * 【主な機能】
+ * - WBSXmlWriter: インデント付き要素の書き込みとバッファ管理
+ * - 出力先は WBSOutputSink.h の WBSOutputSink 派生クラス
+ *
+ * 【設計原則】
+ * - ノードごとの文字列生成や連結を行わない（各バイトは一度だけコピー）
+ * - バッファは閾値に達するたびに書き出して再利用（使用メモリはプロジェクト規模に非依存）
+ * - 書き込みエラーは戻り値で通知し、例外は投げない
+ *
+ * 作成者: WBS開発チーム
+ * 作成日: 2024年
+ * バージョン: 1.0
+ * ============================================================================
+ */
+
+#pragma once
+#include <string>
+#include "WBSUtf8.h"
+#include "WBSOutputSink.h"
+
+// ============================================================================
+// ストリーミングXMLライター
+// ============================================================================
+
+/**
+ * @brief UTF-8バッファへ直接書き込むXMLライター
+ *
+ * 要素は呼び出し順にバッファへ追加され、バッファが kFlushThreshold を
+ * 超えるたびに出力先へ書き出されます。最後に必ず Flush() を呼び出してください。
+ */
+class WBSXmlWriter {
+public:
+    static const size_t kFlushThreshold = 1024 * 1024;     ///< 書き出し単位（1MB）
+
+    /**
+     * @brief コンストラクタ
+     * @param sink 出力先（ライターより長く生存させること）
+     */
+    explicit WBSXmlWriter(WBSOutputSink& sink) : sink_(sink), failed_(false) {
+        buffer_.reserve(kFlushThreshold + 64 * 1024);
+    }
+
+    /**
+     * @brief 文字列をそのまま追加（XML宣言など）
+     * @param text ASCII文字列
+     */
+    void Raw(const char* text) {
+        buffer_ += text;
+        FlushIfFull();
+    }
+
+    /**
+     * @brief インデント付き開始タグを1行で追加
+     * @param indent インデント（空白文字数）
+     * @param name タグ名
+     */
+    void OpenTag(int indent, const char* name) {
+        buffer_.append(indent, ' ');
+        buffer_ += '<';
+        buffer_ += name;
+        buffer_ += ">\n";
+        FlushIfFull();
+    }
+
+    /**
+     * @brief インデント付き終了タグを1行で追加
+     * @param indent インデント（空白文字数）
+     * @param name タグ名
+     */
+    void CloseTag(int indent, const char* name) {
+        buffer_.append(indent, ' ');
+        buffer_ += "</";
+        buffer_ += name;
+        buffer_ += ">\n";
+        FlushIfFull();
+    }
+
+    /**
+     * @brief テキスト要素をXMLエスケープして追加
+     * @param indent インデント（空白文字数）
+     * @param name タグ名
+     * @param value 要素の値（UTF-8）
+     */
+    void TextElement(int indent, const char* name, const std::string& value) {
+        BeginValue(indent, name);
+        AppendXmlEscapedUtf8(buffer_, value.data(), value.data() + value.size());
+        EndValue(name);
+    }
+
+    /**
+     * @brief 書式化済みのASCII値を持つ要素を追加（数値・日付用）
+     * @param indent インデント（空白文字数）
+     * @param name タグ名
+     * @param value 値（エスケープ不要なASCII文字列）
+     * @param length 値の長さ
+     */
+    void RawElement(int indent, const char* name, const char* value, size_t length) {
+        BeginValue(indent, name);
+        buffer_.append(value, length);
+        EndValue(name);
+    }
+
+    /**
+     * @brief バッファの内容をすべて出力先へ書き出す
+     * @return これまでの書き込みがすべて成功していればtrue
+     */
+    bool Flush() {
+        if (!buffer_.empty() && !failed_) {
+            failed_ = !sink_.Write(buffer_.data(), buffer_.size());
+        }
+        buffer_.clear();
+        return !failed_;
+    }
+
+    /**
+     * @brief 書き込みエラーが発生したか判定
+     */
+    bool Failed() const { return failed_; }
+
+private:
+    void BeginValue(int indent, const char* name) {
+        buffer_.append(indent, ' ');
+        buffer_ += '<';
+        buffer_ += name;
+        buffer_ += '>';
+    }
+
+    void EndValue(const char* name) {
+        buffer_ += "</";
+        buffer_ += name;
+        buffer_ += ">\n";
+        FlushIfFull();
+    }
+
+    void FlushIfFull() {
+        if (buffer_.size() >= kFlushThreshold) {
+            Flush();
+        }
+    }
+
+    WBSOutputSink& sink_;   ///< 出力先
+    std::string buffer_;    ///< 再利用するUTF-8バッファ
+    bool failed_;           ///< 書き込みエラー発生フラグ
+};
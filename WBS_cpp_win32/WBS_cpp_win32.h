@@ -1,13 +1,13 @@
 #pragma once
 
 #include "resource.h"
-#include "WBSClasses.h"  // WBSNX`CN[h
+#include "WBSClasses.h"  // WBSクラス定義をインクルード
 
 // ============================================================================
-// Common Controls }N`
+// Common Controls マクロ定義
 // ============================================================================
 
-// ComboBox}N̒`iwindowsx.h̔j
+// ComboBoxマクロの定義（windowsx.hからの抜粋）
 #ifndef ComboBox_AddString
 #define ComboBox_AddString(hwndCtl, lpsz) \
     ((int)(DWORD)SendMessage((hwndCtl), CB_ADDSTRING, 0L, (LPARAM)(LPCTSTR)(lpsz)))
@@ -24,7 +24,7 @@
 #endif
 
 // ============================================================================
-// ProgressBar}N̒`
+// ProgressBarマクロの定義
 // ============================================================================
 
 #ifndef ProgressBar_SetRange
@@ -38,7 +38,7 @@
 #endif
 
 // ============================================================================
-// ListView}N̒`
+// ListViewマクロの定義
 // ============================================================================
 
 #ifndef ListView_InsertColumn
@@ -65,7 +65,7 @@
 #endif
 
 // ============================================================================
-// TreeView}N̒`
+// TreeViewマクロの定義
 // ============================================================================
 
 #ifndef TreeView_GetRoot
@@ -114,10 +114,10 @@
 #endif
 
 // ============================================================================
-// ʃRg[bZ[W萔
+// 共通コントロールメッセージ定数
 // ============================================================================
 
-// ComboBox bZ[W
+// ComboBox メッセージ
 #ifndef CB_ADDSTRING
 #define CB_ADDSTRING            0x0143
 #endif
@@ -130,7 +130,7 @@
 #define CB_GETCURSEL            0x0147
 #endif
 
-// ProgressBar bZ[W
+// ProgressBar メッセージ
 #ifndef PBM_SETRANGE
 #define PBM_SETRANGE            (WM_USER+1)
 #endif
@@ -139,7 +139,7 @@
 #define PBM_SETPOS              (WM_USER+2)
 #endif
 
-// TreeView 萔
+// TreeView 定数
 #ifndef TVGN_ROOT
 #define TVGN_ROOT               0x0000
 #endif
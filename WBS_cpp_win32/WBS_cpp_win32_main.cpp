@@ -1,39 +1,46 @@
 /*
  * ============================================================================
- * WBS_cpp_win32_main.cpp - Work Breakdown Structureiƕ\jǗVXe
+ * WBS_cpp_win32_main.cpp - Work Breakdown Structure（作業分解構造）管理システム
  * ============================================================================
  * 
- * X|VuΉWBSvWFNgǗAvP[V
+ * レスポンシブ対応のWBSプロジェクト管理アプリケーション
  * 
- * yȋ@\z
- * - _CAOx[X̃[U[C^[tF[X
- * - X|VuCAEgiTCYύXΉj
- * - TreeViewɂKwI^XN\
- * - ListViewɂڍ׏\
- * - XML`ł̃vWFNgۑ/ǂݍ
+ * 【主な機能】
+ * - ダイアログベースのユーザーインターフェース
+ * - レスポンシブレイアウト（サイズ変更対応）
+ * - TreeViewによる階層的タスク表示
+ * - ListViewによる詳細情報表示
+ * - XML形式・バイナリ形式でのプロジェクト保存/読み込み
+ * - 編集ジャーナルによる差分保存
+ * - バックグラウンド保存（保存中も編集可能）
+ * - 大きなプロジェクトの遅延読み込み（ツリーの展開時に子タスクを構築）
  * 
- * yX|Vu@\z
- * - WM_SIZEbZ[WΉ
- * - ŏTCY
- * - Rg[̎TCY
+ * 【レスポンシブ機能】
+ * - WM_SIZEメッセージ対応
+ * - 最小サイズ制限
+ * - コントロールの自動リサイズ
  * ============================================================================
  */
 
-// vWFNgpwb_[
+// プロジェクト専用ヘッダー
 #include "framework.h"
 #include "Resource.h"
 #include "WBSClasses.h"
+#include "WBSSaveJob.h"
+#include "WBSUtf8.h"
 
-// ǉWindows API
+// 追加のWindows API
 #include <commdlg.h>
 #include <shlobj.h>
 
-// C++WCu
+// C++標準ライブラリ
 #include <vector>
 #include <string>
 #include <memory>
+#include <unordered_map>
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 #pragma comment(lib, "shell32.lib")
 #pragma comment(linker, "/SUBSYSTEM:WINDOWS")
@@ -41,7 +48,7 @@
 #define MAX_LOADSTRING 100
 
 // ============================================================================
-// O[oϐ
+// グローバル変数
 // ============================================================================
 
 HINSTANCE hInst;
@@ -50,9 +57,10 @@ HWND g_hMainDialog = nullptr;
 HWND g_hTreeWBS = nullptr;
 HWND g_hListDetails = nullptr;
 HTREEITEM g_selectedItem = nullptr;
+std::unordered_map<const WBSItem*, uint64_t> g_drawnSubtreeHashes;  // ツリーに描画した時点の部分木ハッシュ（項目の削除時に消す）
 
 // ============================================================================
-// ֐̑O錾
+// 関数の前方宣言
 // ============================================================================
 
 INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam);
@@ -63,32 +71,41 @@ void InitializeWBSDialog(HWND hDlg);
 void RefreshTreeView();
 void RefreshListView();
 void OnTreeSelectionChanged();
+void OnTreeItemExpanding(const NMTREEVIEW* notify);
+void OnTreeItemDeleted(const NMTREEVIEW* notify);
 HTREEITEM AddTreeItem(HTREEITEM hParent, std::shared_ptr<WBSItem> item);
 void AddTreeItemRecursive(HTREEITEM hParent, std::shared_ptr<WBSItem> item);
+void SyncTreeItem(HTREEITEM hItem, const std::shared_ptr<WBSItem>& item);
 std::shared_ptr<WBSItem> GetItemFromTreeItem(HTREEITEM hItem);
 
-// ݒt@C֐
+// 設定ファイル関数
 std::wstring GetConfigFilePath();
 void SaveLastOpenedFile(const std::wstring& filePath);
 std::wstring GetLastOpenedFile();
+int GetLazyLoadDepth();
 
-// OXML֐iX^uj
-void OnSaveProject() { 
-    MessageBox(g_hMainDialog, L"ۑ@\͎łB", L"", MB_OK | MB_ICONINFORMATION);
-}
+// 外部ファイル処理関数（WBS_XML_Functions.cpp）
+void OnSaveProject();
+void OnOpenProject();
+void OnBackgroundSaveCompleted(WPARAM sequence);
+bool LoadProjectFromFile(const std::wstring& filePath);
 
-void OnOpenProject() { 
-    MessageBox(g_hMainDialog, L"ǂݍ݋@\͎łB", L"", MB_OK | MB_ICONINFORMATION);
-}
+// 差分・マージ関数（WBS_Merge_Functions.cpp）
+void OnMergeProject();
 
-bool LoadProjectFromFile(const std::wstring& filePath) { 
-    return false; 
-}
+// 編集ジャーナル関数（WBS_Journal_Functions.cpp）
+void JournalDetach();
+bool WaitForBackgroundSave(const WBSProject* project);
+void JournalRecordInsert(const WBSItem& item);
+void JournalRecordEdits(const WBSItem& before, const WBSItem& after);
+void JournalRecordDelete(const WBSItem& item);
 
 // ============================================================================
-// ݒt@C֐
+// 設定ファイル操作関数
 // ============================================================================
 
+const int kDefaultLazyLoadDepth = 2;    ///< 遅延読み込みで最初に構築する階層数（ルートの下）
+
 std::wstring GetConfigFilePath() {
     wchar_t appDataPath[MAX_PATH];
     if (SHGetFolderPath(nullptr, CSIDL_APPDATA, nullptr, 0, appDataPath) == S_OK) {
@@ -102,13 +119,29 @@ std::wstring GetConfigFilePath() {
 void SaveLastOpenedFile(const std::wstring& filePath) {
     try {
         std::wstring configFile = GetConfigFilePath();
+
+        // 他の設定（LazyLoadDepth 等）は残して LastOpenedFile だけを書き換える
+        std::vector<std::wstring> otherLines;
+        {
+            std::wifstream input(configFile);
+            std::wstring line;
+            while (std::getline(input, line)) {
+                if (line.find(L"LastOpenedFile=") != 0) {
+                    otherLines.push_back(line);
+                }
+            }
+        }
+
         std::wofstream file(configFile);
         if (file.is_open()) {
             file << L"LastOpenedFile=" << filePath << std::endl;
+            for (const auto& line : otherLines) {
+                file << line << std::endl;
+            }
             file.close();
         }
     } catch (...) {
-        // G[͖
+        // エラーは無視
     }
 }
 
@@ -126,13 +159,33 @@ std::wstring GetLastOpenedFile() {
             file.close();
         }
     } catch (...) {
-        // G[͖
+        // エラーは無視
     }
     return L"";
 }
 
+/**
+ * @brief 遅延読み込みで最初に構築する階層数を取得
+ *
+ * 設定ファイルの "LazyLoadDepth=" 行で変更できます（0の場合は遅延読み込みしない）。
+ */
+int GetLazyLoadDepth() {
+    try {
+        std::wifstream file(GetConfigFilePath());
+        std::wstring line;
+        while (std::getline(file, line)) {
+            if (line.find(L"LazyLoadDepth=") == 0) {
+                return _wtoi(line.c_str() + 14);
+            }
+        }
+    } catch (...) {
+        // エラーは無視
+    }
+    return kDefaultLazyLoadDepth;
+}
+
 // ============================================================================
-// CGg|Cg
+// メインエントリポイント
 // ============================================================================
 
 int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
@@ -146,20 +199,20 @@ int APIENTRY wWinMain(_In_ HINSTANCE hInstance,
 
     hInst = hInstance;
 
-    // Common Controls ̏
+    // Common Controls の初期化
     INITCOMMONCONTROLSEX icex;
     icex.dwSize = sizeof(INITCOMMONCONTROLSEX);
     icex.dwICC = ICC_TREEVIEW_CLASSES | ICC_LISTVIEW_CLASSES | ICC_DATE_CLASSES | ICC_PROGRESS_CLASS;
     InitCommonControlsEx(&icex);
 
-    // C_CAO\
+    // メインダイアログを表示
     DialogBox(hInstance, MAKEINTRESOURCE(IDD_WBS_MAIN), nullptr, MainDlgProc);
 
     return 0;
 }
 
 // ============================================================================
-// X|VuΉC_CAOvV[W
+// レスポンシブ対応メインダイアログプロシージャ
 // ============================================================================
 
 INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam)
@@ -170,11 +223,11 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
         {
             g_hMainDialog = hDlg;
             
-            // Rg[nh擾
+            // コントロールハンドルを取得
             g_hTreeWBS = GetDlgItem(hDlg, IDC_TREE_WBS);
             g_hListDetails = GetDlgItem(hDlg, IDC_LIST_DETAILS);
             
-            // WBSVXe
+            // WBSシステムを初期化
             InitializeWBSDialog(hDlg);
             
             return (INT_PTR)TRUE;
@@ -182,14 +235,14 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
 
     case WM_SIZE:
         {
-            // X|VuΉ: _CAÕTCYύX̏
+            // レスポンシブ対応: ダイアログのサイズ変更時の処理
             if (wParam != SIZE_MINIMIZED && g_hTreeWBS && g_hListDetails) {
                 RECT dlgRect;
                 GetClientRect(hDlg, &dlgRect);
                 int dialogWidth = dlgRect.right - dlgRect.left;
                 int dialogHeight = dlgRect.bottom - dlgRect.top;
                 
-                // yCiTreeViewj̃TCY - ͌ŒA͊g
+                // 左ペイン（TreeView）のリサイズ - 幅は固定、高さは拡張
                 int newTreeHeight = dialogHeight - 80;
                 if (newTreeHeight > 0) {
                     SetWindowPos(g_hTreeWBS, nullptr, 
@@ -197,7 +250,7 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
                                SWP_NOZORDER | SWP_NOACTIVATE);
                 }
                 
-                // EyCiListViewj̃TCY - ƍg
+                // 右ペイン（ListView）のリサイズ - 幅と高さを拡張
                 int newListWidth = dialogWidth - 422;
                 int newListHeight = dialogHeight - 220;
                 if (newListWidth > 0 && newListHeight > 0) {
@@ -206,7 +259,7 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
                                SWP_NOZORDER | SWP_NOACTIVATE);
                 }
                 
-                // {^̈ʒu
+                // ボタンの位置調整
                 struct ButtonInfo {
                     int id;
                     int x;
@@ -241,7 +294,7 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
 
     case WM_GETMINMAXINFO:
         {
-            // ŏTCY̐ݒ
+            // 最小サイズの制限を設定
             LPMINMAXINFO lpMMI = (LPMINMAXINFO)lParam;
             lpMMI->ptMinTrackSize.x = 600;
             lpMMI->ptMinTrackSize.y = 400;
@@ -255,7 +308,9 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
             {
             case IDC_BUTTON_NEW_PROJECT:
             case IDM_FILE_NEW:
+                WaitForBackgroundSave(g_currentProject.get());
                 g_currentProject = std::make_unique<WBSProject>();
+                JournalDetach();
                 RefreshTreeView();
                 RefreshListView();
                 break;
@@ -269,15 +324,20 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
             case IDM_FILE_SAVE:
                 OnSaveProject();
                 break;
+
+            case IDM_FILE_MERGE:
+                OnMergeProject();
+                break;
                 
             case IDC_BUTTON_ADD_TASK:
             case IDM_EDIT_ADD_TASK:
                 {
                     if (!g_currentProject) return FALSE;
-                    auto newTask = std::make_shared<WBSItem>(L"V^XN");
-                    g_currentProject->rootTask->AddChild(newTask);
+                    auto newTask = g_currentProject->NewItem(u8"新しいタスク");
+                    g_currentProject->AddTask(*g_currentProject->rootTask, newTask);
+                    JournalRecordInsert(*newTask);
                     RefreshTreeView();
-                    MessageBox(hDlg, L"V^XNǉ܂B", L"", MB_OK | MB_ICONINFORMATION);
+                    MessageBox(hDlg, L"新しいタスクを追加しました。", L"情報", MB_OK | MB_ICONINFORMATION);
                 }
                 break;
                 
@@ -285,15 +345,16 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
             case IDM_EDIT_ADD_SUBTASK:
                 {
                     if (!g_selectedItem) {
-                        MessageBox(hDlg, L"e^XNIĂB", L"G[", MB_OK | MB_ICONWARNING);
+                        MessageBox(hDlg, L"親タスクを選択してください。", L"エラー", MB_OK | MB_ICONWARNING);
                         return FALSE;
                     }
                     std::shared_ptr<WBSItem> parentItem = GetItemFromTreeItem(g_selectedItem);
                     if (!parentItem) return FALSE;
-                    auto newSubTask = std::make_shared<WBSItem>(L"VTu^XN");
-                    parentItem->AddChild(newSubTask);
+                    auto newSubTask = g_currentProject->NewItem(u8"新しいサブタスク");
+                    g_currentProject->AddTask(*parentItem, newSubTask);
+                    JournalRecordInsert(*newSubTask);
                     RefreshTreeView();
-                    MessageBox(hDlg, L"VTu^XNǉ܂B", L"", MB_OK | MB_ICONINFORMATION);
+                    MessageBox(hDlg, L"新しいサブタスクを追加しました。", L"情報", MB_OK | MB_ICONINFORMATION);
                 }
                 break;
                 
@@ -301,7 +362,7 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
             case IDM_EDIT_EDIT_TASK:
                 {
                     if (!g_selectedItem) {
-                        MessageBox(hDlg, L"ҏW^XNIĂB", L"G[", MB_OK | MB_ICONWARNING);
+                        MessageBox(hDlg, L"編集するタスクを選択してください。", L"エラー", MB_OK | MB_ICONWARNING);
                         return FALSE;
                     }
                     DialogBox(hInst, MAKEINTRESOURCE(IDD_TASK_EDIT), hDlg, TaskEditDlgProc);
@@ -312,11 +373,24 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
             case IDM_EDIT_DELETE_TASK:
                 {
                     if (!g_selectedItem) {
-                        MessageBox(hDlg, L"폜^XNIĂB", L"G[", MB_OK | MB_ICONWARNING);
+                        MessageBox(hDlg, L"削除するタスクを選択してください。", L"エラー", MB_OK | MB_ICONWARNING);
+                        return FALSE;
+                    }
+                    std::shared_ptr<WBSItem> item = GetItemFromTreeItem(g_selectedItem);
+                    if (!item) return FALSE;
+                    std::shared_ptr<WBSItem> parentItem = item->parent.lock();
+                    if (!parentItem) {
+                        MessageBox(hDlg, L"ルートタスクは削除できません。", L"エラー", MB_OK | MB_ICONWARNING);
                         return FALSE;
                     }
-                    if (MessageBox(hDlg, L"I^XN폜܂H", L"mF", MB_YESNO | MB_ICONQUESTION) == IDYES) {
-                        MessageBox(hDlg, L"^XN폜@\͍\łB", L"", MB_OK | MB_ICONINFORMATION);
+                    auto found = std::find(parentItem->children.begin(), parentItem->children.end(), item);
+                    if (found == parentItem->children.end()) return FALSE;
+                    if (MessageBox(hDlg, L"選択したタスクを削除しますか？", L"確認", MB_YESNO | MB_ICONQUESTION) == IDYES) {
+                        JournalRecordDelete(*item);   // パスが変わる前に記録する
+                        g_currentProject->RemoveTask(*parentItem, found - parentItem->children.begin());
+                        g_selectedItem = nullptr;
+                        RefreshTreeView();
+                        RefreshListView();
                     }
                 }
                 break;
@@ -345,6 +419,7 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
                 
             case IDC_BUTTON_EXIT:
             case IDM_EXIT:
+                WaitForBackgroundSave(g_currentProject.get());
                 EndDialog(hDlg, IDOK);
                 break;
                 
@@ -363,11 +438,22 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
             LPNMHDR pnmh = (LPNMHDR)lParam;
             if (pnmh->hwndFrom == g_hTreeWBS && pnmh->code == TVN_SELCHANGED) {
                 OnTreeSelectionChanged();
+            } else if (pnmh->hwndFrom == g_hTreeWBS && pnmh->code == TVN_ITEMEXPANDING) {
+                OnTreeItemExpanding(reinterpret_cast<const NMTREEVIEW*>(lParam));
+            } else if (pnmh->hwndFrom == g_hTreeWBS && pnmh->code == TVN_DELETEITEM) {
+                OnTreeItemDeleted(reinterpret_cast<const NMTREEVIEW*>(lParam));
             }
         }
         break;
 
+    case WM_WBS_SAVE_COMPLETED:
+        // バックグラウンド保存の完了通知
+        OnBackgroundSaveCompleted(wParam);
+        break;
+
     case WM_CLOSE:
+        // 書き込み途中のファイルを残さないよう、保存の完了を待ってから終了
+        WaitForBackgroundSave(g_currentProject.get());
         EndDialog(hDlg, IDOK);
         break;
 
@@ -378,7 +464,7 @@ INT_PTR CALLBACK MainDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPar
 }
 
 // ============================================================================
-// ^XNҏW_CAOvV[W
+// タスク編集ダイアログプロシージャ
 // ============================================================================
 
 INT_PTR CALLBACK TaskEditDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM lParam)
@@ -390,23 +476,23 @@ INT_PTR CALLBACK TaskEditDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
             if (g_selectedItem) {
                 std::shared_ptr<WBSItem> item = GetItemFromTreeItem(g_selectedItem);
                 if (item) {
-                    SetDlgItemText(hDlg, IDC_EDIT_TASK_NAME, item->taskName.c_str());
-                    SetDlgItemText(hDlg, IDC_EDIT_DESCRIPTION, item->description.c_str());
-                    SetDlgItemText(hDlg, IDC_EDIT_ASSIGNED_TO, item->assignedTo.c_str());
+                    SetDlgItemText(hDlg, IDC_EDIT_TASK_NAME, Utf8ToWide(item->taskName).c_str());
+                    SetDlgItemText(hDlg, IDC_EDIT_DESCRIPTION, Utf8ToWide(item->description.str()).c_str());
+                    SetDlgItemText(hDlg, IDC_EDIT_ASSIGNED_TO, Utf8ToWide(item->assignedTo.str()).c_str());
                     
                     HWND hComboStatus = GetDlgItem(hDlg, IDC_COMBO_STATUS);
-                    ComboBox_AddString(hComboStatus, L"Jn");
-                    ComboBox_AddString(hComboStatus, L"is");
-                    ComboBox_AddString(hComboStatus, L"");
-                    ComboBox_AddString(hComboStatus, L"ۗ");
-                    ComboBox_AddString(hComboStatus, L"LZ");
+                    ComboBox_AddString(hComboStatus, L"未開始");
+                    ComboBox_AddString(hComboStatus, L"進行中");
+                    ComboBox_AddString(hComboStatus, L"完了");
+                    ComboBox_AddString(hComboStatus, L"保留");
+                    ComboBox_AddString(hComboStatus, L"キャンセル");
                     ComboBox_SetCurSel(hComboStatus, (int)item->status);
                     
                     HWND hComboPriority = GetDlgItem(hDlg, IDC_COMBO_PRIORITY);
-                    ComboBox_AddString(hComboPriority, L"");
-                    ComboBox_AddString(hComboPriority, L"");
-                    ComboBox_AddString(hComboPriority, L"");
-                    ComboBox_AddString(hComboPriority, L"ً}");
+                    ComboBox_AddString(hComboPriority, L"低");
+                    ComboBox_AddString(hComboPriority, L"中");
+                    ComboBox_AddString(hComboPriority, L"高");
+                    ComboBox_AddString(hComboPriority, L"緊急");
                     ComboBox_SetCurSel(hComboPriority, (int)item->priority);
                     
                     SetDlgItemText(hDlg, IDC_EDIT_ESTIMATED_HOURS, std::to_wstring((int)item->estimatedHours).c_str());
@@ -431,28 +517,34 @@ INT_PTR CALLBACK TaskEditDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
             if (g_selectedItem) {
                 std::shared_ptr<WBSItem> item = GetItemFromTreeItem(g_selectedItem);
                 if (item) {
+                    WBSItem before = *item; // ジャーナル記録用の編集前の値
                     wchar_t buffer[256];
                     GetDlgItemText(hDlg, IDC_EDIT_TASK_NAME, buffer, 256);
-                    item->taskName = buffer;
+                    item->taskName = WideToUtf8(buffer);
                     
                     GetDlgItemText(hDlg, IDC_EDIT_DESCRIPTION, buffer, 256);
-                    item->description = buffer;
+                    std::string description = WideToUtf8(buffer);
+                    if (description != item->description.str()) {
+                        item->description = description; // 変更時だけテキストストアへ追加
+                    }
                     
                     GetDlgItemText(hDlg, IDC_EDIT_ASSIGNED_TO, buffer, 256);
-                    item->assignedTo = buffer;
+                    item->assignedTo = WideToUtf8(buffer);
                     
                     HWND hComboStatus = GetDlgItem(hDlg, IDC_COMBO_STATUS);
-                    item->status = (TaskStatus)ComboBox_GetCurSel(hComboStatus);
+                    item->SetStatus((TaskStatus)ComboBox_GetCurSel(hComboStatus)); // 祖先の集計も更新
                     
                     HWND hComboPriority = GetDlgItem(hDlg, IDC_COMBO_PRIORITY);
                     item->priority = (TaskPriority)ComboBox_GetCurSel(hComboPriority);
                     
                     GetDlgItemText(hDlg, IDC_EDIT_ESTIMATED_HOURS, buffer, 256);
-                    item->estimatedHours = _wtof(buffer);
+                    item->SetEstimatedHours(_wtof(buffer));
                     
                     GetDlgItemText(hDlg, IDC_EDIT_ACTUAL_HOURS, buffer, 256);
-                    item->actualHours = _wtof(buffer);
+                    item->SetActualHours(_wtof(buffer));
                     
+                    item->InvalidateHash(); // 祖先の部分木ハッシュも無効化（再描画の対象になる）
+                    JournalRecordEdits(before, *item);
                     RefreshTreeView();
                     RefreshListView();
                 }
@@ -474,7 +566,7 @@ INT_PTR CALLBACK TaskEditDlgProc(HWND hDlg, UINT message, WPARAM wParam, LPARAM
 }
 
 // ============================================================================
-// ̑̊֐
+// その他の関数実装
 // ============================================================================
 
 void InitializeWBSDialog(HWND hDlg) {
@@ -484,49 +576,68 @@ void InitializeWBSDialog(HWND hDlg) {
         LVCOLUMN lvc = {};
         lvc.mask = LVCF_TEXT | LVCF_WIDTH;
         
-        lvc.pszText = (LPWSTR)L"";
+        lvc.pszText = (LPWSTR)L"項目";
         lvc.cx = 120;
         ListView_InsertColumn(g_hListDetails, 0, &lvc);
         
-        lvc.pszText = (LPWSTR)L"l";
+        lvc.pszText = (LPWSTR)L"値";
         lvc.cx = 200;
         ListView_InsertColumn(g_hListDetails, 1, &lvc);
     }
     
-    g_currentProject = std::make_unique<WBSProject>(L"TvWBSvWFNg");
+    g_currentProject = std::make_unique<WBSProject>(u8"サンプルWBSプロジェクト");
     
-    auto task1 = std::make_shared<WBSItem>(L"v`");
-    task1->id = L"1.1";
+    auto task1 = g_currentProject->NewItem(u8"要件定義");
+    task1->id.Assign("1.1");
     task1->level = 1;
-    task1->description = L"VXev̒`ƕ";
+    task1->description = u8"システム要件の定義と分析";
     task1->estimatedHours = 40.0;
     task1->status = TaskStatus::COMPLETED;
-    task1->assignedTo = L"c";
-    g_currentProject->rootTask->AddChild(task1);
+    task1->assignedTo = u8"田中";
+    g_currentProject->AddTask(*g_currentProject->rootTask, task1);
 
-    auto task2 = std::make_shared<WBSItem>(L"݌v");
-    task2->id = L"1.2";
+    auto task2 = g_currentProject->NewItem(u8"設計");
+    task2->id.Assign("1.2");
     task2->level = 1;
-    task2->description = L"VXe݌v̍쐬";
+    task2->description = u8"システム設計書の作成";
     task2->estimatedHours = 60.0;
     task2->status = TaskStatus::IN_PROGRESS;
-    task2->assignedTo = L"";
-    g_currentProject->rootTask->AddChild(task2);
+    task2->assignedTo = u8"佐藤";
+    g_currentProject->AddTask(*g_currentProject->rootTask, task2);
 
-    auto subTask1 = std::make_shared<WBSItem>(L"{݌v");
-    subTask1->description = L"{݌v̍쐬";
+    auto subTask1 = g_currentProject->NewItem(u8"基本設計");
+    subTask1->description = u8"基本設計書の作成";
     subTask1->estimatedHours = 30.0;
     subTask1->status = TaskStatus::COMPLETED;
-    subTask1->assignedTo = L"";
-    task2->AddChild(subTask1);
+    subTask1->assignedTo = u8"佐藤";
+    g_currentProject->AddTask(*task2, subTask1);
 
     RefreshTreeView();
 }
 
+/**
+ * @brief ツリービューをプロジェクトの内容に合わせて更新
+ *
+ * 別のプロジェクトに切り替わった場合だけ全体を作り直します。
+ * それ以外は SyncTreeItem() で部分木ハッシュが変わった枝だけを更新するため、
+ * 大きなプロジェクトでも編集後の再描画は変更箇所の周辺で済み、
+ * 展開状態と選択も保たれます。
+ */
 void RefreshTreeView() {
     if (!g_hTreeWBS || !g_currentProject) return;
 
+    // 以前のプロジェクトは解放済みのことがあるため、ポインタの比較だけを行う
+    TVITEM root = {};
+    root.mask = TVIF_PARAM;
+    root.hItem = TreeView_GetRoot(g_hTreeWBS);
+    if (root.hItem && TreeView_GetItem(g_hTreeWBS, &root) &&
+        reinterpret_cast<WBSItem*>(root.lParam) == g_currentProject->rootTask.get()) {
+        SyncTreeItem(root.hItem, g_currentProject->rootTask);
+        return;
+    }
+
     TreeView_DeleteAllItems(g_hTreeWBS);
+    g_drawnSubtreeHashes.clear();
     
     HTREEITEM hRoot = AddTreeItem(TVI_ROOT, g_currentProject->rootTask);
     AddTreeItemRecursive(hRoot, g_currentProject->rootTask);
@@ -534,18 +645,84 @@ void RefreshTreeView() {
     TreeView_Expand(g_hTreeWBS, hRoot, TVE_EXPAND);
 }
 
+/**
+ * @brief ツリー項目の表示文字列と展開ボタンの有無を設定
+ */
+void SetTreeItemContent(TVITEM& tvi, const WBSItem& item, std::wstring& displayText) {
+    tvi.mask |= TVIF_TEXT | TVIF_CHILDREN;
+    displayText = Utf8ToWide(item.id.ToString()) + L" - " + Utf8ToWide(item.taskName) + L" (" + item.GetStatusString() + L")";
+    tvi.pszText = const_cast<LPWSTR>(displayText.c_str());
+    // 遅延読み込みの子タスクは未構築でも展開ボタンを表示する
+    tvi.cChildren = (!item.children.empty() || item.HasDeferredChildren()) ? 1 : 0;
+}
+
+/**
+ * @brief 部分木ハッシュが描画時から変わった枝だけツリー項目を更新
+ *
+ * @param hItem item を表示しているツリー項目
+ * @param item 対応するタスク
+ *
+ * ハッシュが描画時と同じ部分木は子孫を含めて読み飛ばします。変わった場合は
+ * 表示文字列を更新し、子項目を先頭から照合して、同じタスクを指す項目は
+ * 再帰的に更新、最初に食い違った位置以降は作り直します（末尾への追加は追加のみ）。
+ */
+void SyncTreeItem(HTREEITEM hItem, const std::shared_ptr<WBSItem>& item) {
+    uint64_t hash = item->GetSubtreeHash();
+    auto drawn = g_drawnSubtreeHashes.find(item.get());
+    if (drawn != g_drawnSubtreeHashes.end() && drawn->second == hash) {
+        return; // 変更のない枝
+    }
+    g_drawnSubtreeHashes[item.get()] = hash;
+
+    TVITEM tvi = {};
+    tvi.hItem = hItem;
+    std::wstring displayText;
+    SetTreeItemContent(tvi, *item, displayText);
+    TreeView_SetItem(g_hTreeWBS, &tvi);
+
+    HTREEITEM hChild = TreeView_GetChild(g_hTreeWBS, hItem);
+    size_t index = 0;
+    for (; index < item->children.size() && hChild; ++index) {
+        TVITEM childItem = {};
+        childItem.mask = TVIF_PARAM;
+        childItem.hItem = hChild;
+        if (!TreeView_GetItem(g_hTreeWBS, &childItem) ||
+            reinterpret_cast<WBSItem*>(childItem.lParam) != item->children[index].get()) {
+            break; // 挿入・削除・移動された位置
+        }
+        SyncTreeItem(hChild, item->children[index]);
+        hChild = TreeView_GetNextSibling(g_hTreeWBS, hChild);
+    }
+
+    // 食い違った位置以降の古い項目を削除し、残りの子タスクを追加
+    while (hChild) {
+        HTREEITEM hNext = TreeView_GetNextSibling(g_hTreeWBS, hChild);
+        TreeView_DeleteItem(g_hTreeWBS, hChild);
+        hChild = hNext;
+    }
+    for (; index < item->children.size(); ++index) {
+        HTREEITEM hNew = AddTreeItem(hItem, item->children[index]);
+        if (hNew) {
+            AddTreeItemRecursive(hNew, item->children[index]);
+        }
+    }
+}
+
 HTREEITEM AddTreeItem(HTREEITEM hParent, std::shared_ptr<WBSItem> item) {
     if (!g_hTreeWBS || !item) return nullptr;
 
     TVINSERTSTRUCT tvis = {};
     tvis.hParent = hParent;
     tvis.hInsertAfter = TVI_LAST;
-    tvis.item.mask = TVIF_TEXT | TVIF_PARAM;
+    tvis.item.mask = TVIF_PARAM;
     
-    std::wstring displayText = item->id + L" - " + item->taskName + L" (" + item->GetStatusString() + L")";
-    tvis.item.pszText = const_cast<LPWSTR>(displayText.c_str());
+    std::wstring displayText;
+    SetTreeItemContent(tvis.item, *item, displayText);
     tvis.item.lParam = reinterpret_cast<LPARAM>(item.get());
 
+    // 描画した内容を記録（次回の RefreshTreeView() で変更のない枝を読み飛ばす）
+    g_drawnSubtreeHashes[item.get()] = item->GetSubtreeHash();
+
     return TreeView_InsertItem(g_hTreeWBS, &tvis);
 }
 
@@ -577,6 +754,36 @@ std::shared_ptr<WBSItem> GetItemFromTreeItem(HTREEITEM hItem) {
     return nullptr;
 }
 
+/**
+ * @brief ツリー項目の展開（TVN_ITEMEXPANDING）を処理
+ *
+ * 子タスクが遅延読み込みのままなら、ここで直下の1階層を構築して追加します。
+ */
+void OnTreeItemExpanding(const NMTREEVIEW* notify) {
+    if (!(notify->action & TVE_EXPAND)) return;
+
+    std::shared_ptr<WBSItem> item = GetItemFromTreeItem(notify->itemNew.hItem);
+    if (!item || !item->HasDeferredChildren()) return;
+
+    if (!item->LoadDeferredChildren()) {
+        MessageBox(g_hMainDialog, L"子タスクを読み込めませんでした。", L"エラー", MB_OK | MB_ICONERROR);
+        return;
+    }
+    AddTreeItemRecursive(notify->itemNew.hItem, item);
+}
+
+/**
+ * @brief ツリー項目の削除時に描画済みハッシュを破棄します
+ * @param notify TVN_DELETEITEM の通知
+ *
+ * アリーナは解放したタスクのアドレスを再利用するため、古いエントリが残ると
+ * 新しいタスクが描画済みと誤判定されます。TreeView_DeleteAllItems も
+ * 項目ごとにこの通知を送るため、マップはツリーの項目数を超えません。
+ */
+void OnTreeItemDeleted(const NMTREEVIEW* notify) {
+    g_drawnSubtreeHashes.erase(reinterpret_cast<const WBSItem*>(notify->itemOld.lParam));
+}
+
 void OnTreeSelectionChanged() {
     HTREEITEM hSelected = TreeView_GetSelection(g_hTreeWBS);
     if (hSelected) {
@@ -599,15 +806,20 @@ void RefreshListView() {
     lvi.mask = LVIF_TEXT;
     
     const std::pair<std::wstring, std::wstring> details[] = {
-        {L"^XN", item->taskName},
-        {L"ID", item->id},
-        {L"", item->description},
-        {L"Xe[^X", item->GetStatusString()},
-        {L"Dx", item->GetPriorityString()},
-        {L"\莞", std::to_wstring(item->estimatedHours) + L""},
-        {L"ю", std::to_wstring(item->actualHours) + L""},
-        {L"i", std::to_wstring((int)item->GetProgressPercentage()) + L"%"},
-        {L"S", item->assignedTo}
+        {L"タスク名", Utf8ToWide(item->taskName)},
+        {L"ID", Utf8ToWide(item->id.ToString())},
+        {L"説明", Utf8ToWide(item->description.str())},
+        {L"ステータス", item->GetStatusString()},
+        {L"優先度", item->GetPriorityString()},
+        {L"予定時間", std::to_wstring(item->estimatedHours) + L"時間"},
+        {L"実績時間", std::to_wstring(item->actualHours) + L"時間"},
+        {L"進捗率", std::to_wstring((int)item->GetProgressPercentage()) + L"%"},
+        {L"合計予定時間", std::to_wstring(item->GetTotalEstimatedHours()) + L"時間"},
+        {L"合計実績時間", std::to_wstring(item->GetTotalActualHours()) + L"時間"},
+        {L"合計進捗率", std::to_wstring((int)item->GetTotalProgressPercentage()) + L"%"},
+        {L"完了タスク数", std::to_wstring(item->GetRollup().GetStatusCount(TaskStatus::COMPLETED)) + L" / " +
+                          std::to_wstring(item->GetRollup().taskCount)},
+        {L"担当者", Utf8ToWide(item->assignedTo.str())}
     };
     
     for (int i = 0; i < sizeof(details) / sizeof(details[0]); ++i) {